@@ -22,6 +22,7 @@
 #include <folly/Hash.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 
@@ -30,10 +31,14 @@ namespace facebook::velox {
 // remaining bits select the word in the filter. With 8 bits per
 // expected entry, we get ~2% false positives. 'hashInput' determines
 // if the value added or checked needs to be hashed. If this is false,
-// we assume that the input is already a 64 bit hash number.
-template <bool hashInput = true>
+// we assume that the input is already a 64 bit hash number. 'Allocator'
+// allocates the bits, e.g. from a memory pool.
+template <bool hashInput = true, typename Allocator = std::allocator<uint64_t>>
 class BloomFilter {
  public:
+  explicit BloomFilter(const Allocator& allocator = Allocator())
+      : bits_{allocator} {}
+
   // Prepares 'this' for use with an expected 'capacity'
   // entries. Drops any prior content.
   void reset(int32_t capacity) {
@@ -42,6 +47,11 @@ class BloomFilter {
     bits_.resize(std::max<int32_t>(4, bits::nextPowerOfTwo(capacity) / 4));
   }
 
+  // Returns the size of the bits in bytes.
+  int64_t sizeInBytes() const {
+    return bits_.capacity() * sizeof(uint64_t);
+  }
+
   // Adds 'value'.
   void insert(uint64_t value) {
     set(bits_.data(),
@@ -49,6 +59,17 @@ class BloomFilter {
         hashInput ? folly::hasher<uint64_t>()(value) : value);
   }
 
+  // Same as insert() but may run concurrently with other calls of
+  // insertConcurrent() on 'this'.
+  void insertConcurrent(uint64_t value) {
+    const uint64_t hashCode =
+        hashInput ? folly::hasher<uint64_t>()(value) : value;
+    __atomic_fetch_or(
+        &bits_[bloomIndex(bits_.size(), hashCode)],
+        bloomMask(hashCode),
+        __ATOMIC_RELAXED);
+  }
+
   bool mayContain(uint64_t value) const {
     return test(
         bits_.data(),
@@ -56,6 +77,44 @@ class BloomFilter {
         hashInput ? folly::hasher<uint64_t>()(value) : value);
   }
 
+  // Keeps the elements of 'rows' whose hash number in 'hashes' may be in
+  // 'this' and returns their count. 'hashes' is indexed by the values of
+  // 'rows'. Tests a SIMD batch of hash numbers at a time. For use when
+  // 'hashInput' is false.
+  int32_t filterRows(const uint64_t* hashes, int32_t* rows, int32_t numRows)
+      const {
+    static_assert(!hashInput);
+    using Batch = xsimd::batch<int64_t>;
+    constexpr int32_t kBatch = Batch::size;
+    const auto* bloom = reinterpret_cast<const int64_t*>(bits_.data());
+    const auto indexMask = Batch::broadcast(bits_.size() - 1);
+    const auto bitMask = Batch::broadcast(63);
+    const auto one = Batch::broadcast(1);
+    int32_t numPassed = 0;
+    int32_t i = 0;
+    for (; i + kBatch <= numRows; i += kBatch) {
+      const auto hash =
+          simd::gather(reinterpret_cast<const int64_t*>(hashes), rows + i);
+      // Same as bloomMask() and bloomIndex() on each lane.
+      const auto mask = (one << (hash & bitMask)) |
+          (one << ((hash >> 6) & bitMask)) | (one << ((hash >> 12) & bitMask)) |
+          (one << ((hash >> 18) & bitMask));
+      const auto words = simd::gather(bloom, (hash >> 24) & indexMask);
+      auto passed = simd::toBitMask((words & mask) == mask);
+      while (passed) {
+        rows[numPassed++] = rows[i + __builtin_ctz(passed)];
+        passed &= passed - 1;
+      }
+    }
+    for (; i < numRows; ++i) {
+      const auto row = rows[i];
+      if (test(bits_.data(), bits_.size(), hashes[row])) {
+        rows[numPassed++] = row;
+      }
+    }
+    return numPassed;
+  }
+
  private:
   // We use 4 independent hash functions by taking 24 bits of
   // the hash code and breaking these up into 4 groups of 6 bits. Each group
@@ -89,7 +148,7 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
-  std::vector<uint64_t> bits_;
+  std::vector<uint64_t, Allocator> bits_;
 };
 
 } // namespace facebook::velox
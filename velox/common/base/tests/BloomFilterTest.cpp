@@ -16,6 +16,7 @@
 
 #include "velox/common/base/BloomFilter.h"
 #include <folly/Random.h>
+#include <thread>
 #include <unordered_set>
 
 #include <gtest/gtest.h>
@@ -37,3 +38,54 @@ TEST(BloomFilterTest, basic) {
   }
   EXPECT_GT(2, 100 * numFalsePositives / kSize);
 }
+
+TEST(BloomFilterTest, filterRows) {
+  constexpr int32_t kSize = 1024;
+  BloomFilter<false> bloom;
+  bloom.reset(kSize);
+  std::vector<uint64_t> hashes(2 * kSize);
+  for (auto i = 0; i < hashes.size(); ++i) {
+    hashes[i] = folly::hasher<uint64_t>()(i);
+    if (i % 2 == 0) {
+      bloom.insert(hashes[i]);
+    }
+  }
+  // Every third row, leaving a tail shorter than a SIMD batch.
+  std::vector<int32_t> rows;
+  for (auto i = 0; i < hashes.size() - 3; i += 3) {
+    rows.push_back(i);
+  }
+  auto numPassed = bloom.filterRows(hashes.data(), rows.data(), rows.size());
+  int32_t numExpected = 0;
+  for (auto i = 0; i < hashes.size() - 3; i += 3) {
+    if (bloom.mayContain(hashes[i])) {
+      ASSERT_LT(numExpected, numPassed);
+      EXPECT_EQ(i, rows[numExpected++]);
+    }
+  }
+  EXPECT_EQ(numExpected, numPassed);
+  // All even rows pass and few odd ones do.
+  EXPECT_GT(numPassed, rows.size() / 2 - 1);
+  EXPECT_LT(numPassed, rows.size() / 2 + rows.size() / 20);
+}
+
+TEST(BloomFilterTest, insertConcurrent) {
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumThreads = 4;
+  BloomFilter<false> bloom;
+  bloom.reset(kSize);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = i; j < kSize; j += kNumThreads) {
+        bloom.insertConcurrent(folly::hasher<uint64_t>()(j));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_TRUE(bloom.mayContain(folly::hasher<uint64_t>()(i)));
+  }
+}
@@ -19,6 +19,9 @@
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/FileIds.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#endif
 
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -88,7 +91,11 @@ SsdFile::SsdFile(
     LOG(ERROR) << "Cannot open or create " << filename << " error " << errno;
     exit(1);
   }
+#ifdef VELOX_ENABLE_IO_URING
+  readFile_ = std::make_unique<IoUringReadFile>(fd_, oDirect != 0);
+#else
   readFile_ = std::make_unique<LocalReadFile>(fd_);
+#endif
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -200,7 +207,10 @@ CoalesceIoStats SsdFile::load(
   }
   // Do coalesced IO for the pins. For short payloads, the break-even
   // between discrete pread calls and a single preadv that discards
-  // gaps is ~25K per gap. For longer payloads this is ~50-100K.
+  // gaps is ~25K per gap. For longer payloads this is ~50-100K. If the
+  // file reads asynchronously, the coalesced reads are all issued before
+  // waiting for any of them.
+  std::vector<folly::SemiFuture<uint64_t>> reads;
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -214,8 +224,18 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (readFile_->hasPreadvAsync()) {
+          reads.push_back(readFile_->preadvAsync(offset, buffers));
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!reads.empty()) {
+    // Throws the first error, if any, after all reads have completed.
+    for (auto& result : folly::collectAll(std::move(reads)).get()) {
+      result.throwIfFailed();
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
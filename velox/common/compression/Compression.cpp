@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/Compression.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+
+#include <unordered_map>
+
+namespace facebook::velox::common {
+
+std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+  switch (static_cast<int32_t>(kind)) {
+    case CompressionKind_NONE:
+      return folly::io::getCodec(folly::io::CodecType::NO_COMPRESSION);
+    case CompressionKind_ZLIB:
+      return folly::io::getCodec(folly::io::CodecType::ZLIB);
+    case CompressionKind_SNAPPY:
+      return folly::io::getCodec(folly::io::CodecType::SNAPPY);
+    case CompressionKind_ZSTD:
+      return folly::io::getCodec(folly::io::CodecType::ZSTD);
+    case CompressionKind_LZ4:
+      return folly::io::getCodec(folly::io::CodecType::LZ4);
+    default:
+      VELOX_UNSUPPORTED(
+          "Not support {} in folly", compressionKindToString(kind));
+  }
+}
+
+std::string compressionKindToString(CompressionKind kind) {
+  switch (static_cast<int32_t>(kind)) {
+    case CompressionKind_NONE:
+      return "none";
+    case CompressionKind_ZLIB:
+      return "zlib";
+    case CompressionKind_SNAPPY:
+      return "snappy";
+    case CompressionKind_LZO:
+      return "lzo";
+    case CompressionKind_ZSTD:
+      return "zstd";
+    case CompressionKind_LZ4:
+      return "lz4";
+  }
+  return folly::to<std::string>("unknown - ", kind);
+}
+
+CompressionKind stringToCompressionKind(const std::string& kind) {
+  static const std::unordered_map<std::string, CompressionKind>
+      stringToCompressionKindMap = {
+          {"none", CompressionKind_NONE},
+          {"zlib", CompressionKind_ZLIB},
+          {"snappy", CompressionKind_SNAPPY},
+          {"lzo", CompressionKind_LZO},
+          {"zstd", CompressionKind_ZSTD},
+          {"lz4", CompressionKind_LZ4}};
+  auto iter = stringToCompressionKindMap.find(folly::toLowerAscii(kind));
+  if (iter != stringToCompressionKindMap.end()) {
+    return iter->second;
+  }
+  VELOX_USER_FAIL("Not support compression kind {}", kind);
+}
+} // namespace facebook::velox::common
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/Compression.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+
+class CompressionTest : public testing::Test {};
+
+TEST_F(CompressionTest, compressionKindToString) {
+  EXPECT_EQ(compressionKindToString(CompressionKind_NONE), "none");
+  EXPECT_EQ(compressionKindToString(CompressionKind_ZLIB), "zlib");
+  EXPECT_EQ(compressionKindToString(CompressionKind_SNAPPY), "snappy");
+  EXPECT_EQ(compressionKindToString(CompressionKind_LZO), "lzo");
+  EXPECT_EQ(compressionKindToString(CompressionKind_ZSTD), "zstd");
+  EXPECT_EQ(compressionKindToString(CompressionKind_LZ4), "lz4");
+  EXPECT_EQ(
+      compressionKindToString(static_cast<CompressionKind>(99)),
+      "unknown - 99");
+}
+
+TEST_F(CompressionTest, stringToCompressionKind) {
+  EXPECT_EQ(stringToCompressionKind("none"), CompressionKind_NONE);
+  EXPECT_EQ(stringToCompressionKind("zlib"), CompressionKind_ZLIB);
+  EXPECT_EQ(stringToCompressionKind("snappy"), CompressionKind_SNAPPY);
+  EXPECT_EQ(stringToCompressionKind("lzo"), CompressionKind_LZO);
+  EXPECT_EQ(stringToCompressionKind("ZSTD"), CompressionKind_ZSTD);
+  EXPECT_EQ(stringToCompressionKind("Lz4"), CompressionKind_LZ4);
+  VELOX_ASSERT_THROW(
+      stringToCompressionKind("bz2"), "Not support compression kind bz2");
+}
+
+TEST_F(CompressionTest, compressionKindToCodec) {
+  for (auto kind :
+       {CompressionKind_NONE,
+        CompressionKind_ZLIB,
+        CompressionKind_SNAPPY,
+        CompressionKind_ZSTD,
+        CompressionKind_LZ4}) {
+    SCOPED_TRACE(compressionKindToString(kind));
+    auto codec = compressionKindToCodec(kind);
+    const std::string data(10'000, 'x');
+    auto input = folly::IOBuf::wrapBuffer(data.data(), data.size());
+    auto compressed = codec->compress(input.get());
+    auto uncompressed = codec->uncompress(compressed.get(), data.size());
+    EXPECT_EQ(uncompressed->moveToFbString().toStdString(), data);
+  }
+  VELOX_ASSERT_THROW(
+      compressionKindToCodec(CompressionKind_LZO), "Not support lzo in folly");
+}
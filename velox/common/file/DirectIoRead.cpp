@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/DirectIoRead.h"
+
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox {
+
+bool isDirectIoAligned(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  if (offset % kDirectIoAlignment != 0) {
+    return false;
+  }
+  for (const auto& range : buffers) {
+    if (range.size() % kDirectIoAlignment != 0 ||
+        reinterpret_cast<uintptr_t>(range.data()) % kDirectIoAlignment != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DirectIoBounceRead::DirectIoBounceRead(uint64_t offset, uint64_t size)
+    : readOffset(offset - offset % kDirectIoAlignment),
+      skip(offset - readOffset),
+      minBytes(skip + size) {
+  readSize = bits::roundUp(minBytes, kDirectIoAlignment);
+}
+
+void DirectIoBounceRead::copyTo(
+    const char* bounce,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  const char* source = bounce + skip;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      memcpy(range.data(), source, range.size());
+    }
+    source += range.size();
+  }
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <folly/Range.h>
+
+namespace facebook::velox {
+
+// Helpers for reading files opened with O_DIRECT, where offsets, sizes and
+// buffers of reads must be aligned.
+
+// The alignment of reads from a file opened with O_DIRECT.
+constexpr uint64_t kDirectIoAlignment = 4096;
+
+// Returns true if a preadv of 'buffers' at 'offset' can go to a file opened
+// with O_DIRECT as is. Ranges with null data are skipped and read into a
+// shared aligned buffer, so only their size must be aligned.
+bool isDirectIoAligned(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers);
+
+// An aligned read into a bounce buffer that covers an unaligned read of
+// 'size' bytes at 'offset'.
+struct DirectIoBounceRead {
+  DirectIoBounceRead(uint64_t offset, uint64_t size);
+
+  // Copies the requested bytes from 'bounce', which holds the data read at
+  // 'readOffset', to 'buffers'. Ranges with null data are skipped.
+  void copyTo(
+      const char* bounce,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
+  // The aligned offset to read from.
+  uint64_t readOffset;
+
+  // The aligned number of bytes to read. May extend past the end of file.
+  uint64_t readSize;
+
+  // The offset of the requested bytes in the bounce buffer.
+  uint64_t skip;
+
+  // The minimum number of bytes the read must return to cover the requested
+  // bytes.
+  uint64_t minBytes;
+};
+
+} // namespace facebook::velox
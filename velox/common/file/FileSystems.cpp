@@ -18,6 +18,9 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#endif
 #include "velox/core/Context.h"
 
 #include <cstdio>
@@ -84,7 +87,11 @@ class LocalFileSystem : public FileSystem {
   }
 
   std::unique_ptr<ReadFile> openFileForRead(std::string_view path) override {
+#ifdef VELOX_ENABLE_IO_URING
+    return std::make_unique<IoUringReadFile>(extractPath(path));
+#else
     return std::make_unique<LocalReadFile>(extractPath(path));
+#endif
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(std::string_view path) override {
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringReadFile.h"
+
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/Try.h>
+#include <glog/logging.h>
+
+#include "velox/common/file/DirectIoRead.h"
+
+namespace facebook::velox {
+namespace {
+
+// Entries in the submission queue. The completion queue is twice as large.
+constexpr uint32_t kQueueDepth = 256;
+
+// Size of the buffer receiving the skipped ranges of preadv.
+constexpr uint64_t kDroppedBytesSize = 64 << 10;
+
+struct AlignedDeleter {
+  void operator()(char* ptr) const {
+    free(ptr);
+  }
+};
+
+using AlignedBuffer = std::unique_ptr<char, AlignedDeleter>;
+
+AlignedBuffer allocateAligned(uint64_t size) {
+  void* ptr = nullptr;
+  const auto rc = posix_memalign(&ptr, kDirectIoAlignment, size);
+  VELOX_CHECK_EQ(rc, 0, "posix_memalign of {} bytes failed", size);
+  return AlignedBuffer(static_cast<char*>(ptr));
+}
+
+// Receives the skipped ranges of all reads. The content is never used, so
+// concurrent reads can share it.
+char* droppedBytes() {
+  static AlignedBuffer buffer = allocateAligned(kDroppedBytesSize);
+  return buffer.get();
+}
+
+// A read in flight. Owns everything the kernel accesses until the read
+// completes.
+struct Request {
+  folly::Promise<uint64_t> promise;
+  std::vector<struct iovec> iovecs;
+
+  // The minimum number of bytes the read must return.
+  uint64_t expectedBytes{0};
+
+  // The size of the requested ranges, including the skipped ones.
+  uint64_t totalBytes{0};
+
+  // Set if the read goes to an aligned bounce buffer. The requested ranges
+  // are copied from 'bounce' to 'targets' as described by 'bounceRead'.
+  AlignedBuffer bounce;
+  std::optional<DirectIoBounceRead> bounceRead;
+  std::vector<folly::Range<char*>> targets;
+};
+
+// Marks a queued entry whose submission failed. The entry completes without
+// a request.
+char discardedEntryTag;
+
+// Process wide io_uring instance. Submissions are serialized by 'mutex_'. A
+// dedicated thread reaps the completions and realizes the promises of the
+// requests.
+class IoUring {
+ public:
+  static IoUring& instance() {
+    static IoUring ring;
+    return ring;
+  }
+
+  void submit(int32_t fd, uint64_t offset, std::unique_ptr<Request> request) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* sqe = io_uring_get_sqe(&ring_);
+    if (sqe == nullptr) {
+      // Hands the queued entries to the kernel to make room.
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    VELOX_CHECK_NOT_NULL(sqe, "io_uring submission queue is full");
+    io_uring_prep_readv(
+        sqe, fd, request->iovecs.data(), request->iovecs.size(), offset);
+    io_uring_sqe_set_data(sqe, request.get());
+    try {
+      submitLocked();
+    } catch (...) {
+      // The entry stays queued and goes to the kernel with the next submit.
+      // Make it a nop so that the kernel does not access 'request', which the
+      // caller still owns.
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, &discardedEntryTag);
+      throw;
+    }
+    // The ring owns the request once the kernel has it.
+    request.release();
+  }
+
+ private:
+  IoUring() {
+    const auto rc = io_uring_queue_init(kQueueDepth, &ring_, 0);
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+    reaper_ = std::thread([this]() { reap(); });
+  }
+
+  ~IoUring() {
+    {
+      // A nop without request stops the reaper.
+      std::lock_guard<std::mutex> l(mutex_);
+      auto* sqe = io_uring_get_sqe(&ring_);
+      if (sqe == nullptr) {
+        io_uring_submit(&ring_);
+        sqe = io_uring_get_sqe(&ring_);
+      }
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      io_uring_submit(&ring_);
+    }
+    reaper_.join();
+    io_uring_queue_exit(&ring_);
+  }
+
+  void submitLocked() {
+    int rc;
+    // EAGAIN and EBUSY clear once the reaper has drained completions.
+    while ((rc = io_uring_submit(&ring_)) == -EINTR || rc == -EAGAIN ||
+           rc == -EBUSY) {
+      std::this_thread::yield();
+    }
+    VELOX_CHECK_GE(rc, 0, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+  }
+
+  void reap() {
+    for (;;) {
+      struct io_uring_cqe* cqe = nullptr;
+      const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+      if (rc == -EINTR) {
+        continue;
+      }
+      if (rc < 0) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+        continue;
+      }
+      auto* data = io_uring_cqe_get_data(cqe);
+      const int32_t result = cqe->res;
+      io_uring_cqe_seen(&ring_, cqe);
+      if (data == nullptr) {
+        return;
+      }
+      if (data == &discardedEntryTag) {
+        continue;
+      }
+      complete(std::unique_ptr<Request>(static_cast<Request*>(data)), result);
+    }
+  }
+
+  static void complete(std::unique_ptr<Request> request, int32_t result) {
+    request->promise.setTry(folly::makeTryWith([&]() -> uint64_t {
+      VELOX_CHECK_GE(
+          result, 0, "io_uring read failed: {}", folly::errnoStr(-result));
+      VELOX_CHECK_GE(
+          static_cast<uint64_t>(result),
+          request->expectedBytes,
+          "Short io_uring read: {} vs {}",
+          result,
+          request->expectedBytes);
+      if (request->bounceRead.has_value()) {
+        request->bounceRead->copyTo(request->bounce.get(), request->targets);
+      }
+      return request->totalBytes;
+    }));
+  }
+
+  std::mutex mutex_;
+  struct io_uring ring_;
+  std::thread reaper_;
+};
+
+} // namespace
+
+IoUringReadFile::IoUringReadFile(std::string_view path, bool directIo)
+    : path_(path), directIo_(directIo), ownsFd_(true) {
+  int32_t flags = O_RDONLY;
+  if (directIo_) {
+    flags |= O_DIRECT;
+  }
+  fd_ = open(path_.c_str(), flags);
+  VELOX_CHECK_GE(
+      fd_,
+      0,
+      "open failure in IoUringReadFile constructor, {} {} {}.",
+      fd_,
+      path,
+      folly::errnoStr(errno));
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      rc,
+      0,
+      "fseek failure in IoUringReadFile constructor, {} {} {}.",
+      rc,
+      path,
+      folly::errnoStr(errno));
+  size_ = rc;
+}
+
+IoUringReadFile::IoUringReadFile(int32_t fd, bool directIo)
+    : directIo_(directIo), ownsFd_(false), fd_(fd) {
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      rc,
+      0,
+      "fseek failure in IoUringReadFile constructor, {} {}.",
+      rc,
+      folly::errnoStr(errno));
+  size_ = rc;
+}
+
+IoUringReadFile::~IoUringReadFile() {
+  if (!ownsFd_) {
+    return;
+  }
+  const int ret = close(fd_);
+  if (ret < 0) {
+    LOG(WARNING) << "close failure in IoUringReadFile destructor: " << ret
+                 << ", " << folly::errnoStr(errno);
+  }
+}
+
+std::string_view
+IoUringReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  return preadvAsync(offset, buffers).get();
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto request = std::make_unique<Request>();
+  for (const auto& range : buffers) {
+    request->totalBytes += range.size();
+  }
+  bytesRead_ += request->totalBytes;
+
+  uint64_t readOffset = offset;
+  if (!directIo_ || isDirectIoAligned(offset, buffers)) {
+    request->iovecs.reserve(buffers.size());
+    for (const auto& range : buffers) {
+      if (range.data() != nullptr) {
+        request->iovecs.push_back({range.data(), range.size()});
+        continue;
+      }
+      for (auto skipSize = range.size(); skipSize > 0;) {
+        const auto bytes = std::min<uint64_t>(kDroppedBytesSize, skipSize);
+        request->iovecs.push_back({droppedBytes(), bytes});
+        skipSize -= bytes;
+      }
+    }
+    request->expectedBytes = request->totalBytes;
+  } else {
+    request->bounceRead.emplace(offset, request->totalBytes);
+    readOffset = request->bounceRead->readOffset;
+    // The aligned read may extend past the end of file, in which case it
+    // returns less than 'readSize' but at least 'minBytes'.
+    request->expectedBytes = request->bounceRead->minBytes;
+    const uint64_t readSize = request->bounceRead->readSize;
+    request->bounce = allocateAligned(readSize);
+    request->iovecs.push_back({request->bounce.get(), readSize});
+    request->targets = buffers;
+  }
+
+  auto future = request->promise.getSemiFuture();
+  try {
+    IoUring::instance().submit(fd_, readOffset, std::move(request));
+  } catch (...) {
+    return folly::makeSemiFuture<uint64_t>(
+        folly::exception_wrapper(std::current_exception()));
+  }
+  return future;
+}
+
+uint64_t IoUringReadFile::size() const {
+  return size_;
+}
+
+uint64_t IoUringReadFile::memoryUsage() const {
+  return sizeof(*this);
+}
+
+} // namespace facebook::velox
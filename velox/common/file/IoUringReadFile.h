@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/DirectIoRead.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+// A local file read through io_uring. Available only if built with
+// VELOX_ENABLE_IO_URING.
+//
+// preadvAsync() submits the read to a process wide ring and returns a future
+// that is realized by the thread reaping the ring's completions, so that
+// callers do not hold an executor thread for the duration of the IO. The
+// synchronous reads wait for the same future.
+//
+// If 'directIo' is true, the file is read with O_DIRECT. Reads with offsets,
+// sizes or buffers not aligned to kDirectIoAlignment then go through an
+// aligned bounce buffer, see DirectIoRead.h.
+class IoUringReadFile final : public ReadFile {
+ public:
+  explicit IoUringReadFile(std::string_view path, bool directIo = false);
+
+  // Reads from 'fd', which stays owned by the caller. 'directIo' must be true
+  // if 'fd' was opened with O_DIRECT.
+  IoUringReadFile(int32_t fd, bool directIo);
+
+  ~IoUringReadFile();
+
+  std::string_view
+  pread(uint64_t offset, uint64_t length, void* FOLLY_NONNULL buf) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  uint64_t size() const final;
+
+  uint64_t memoryUsage() const final;
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const override {
+    if (path_.empty()) {
+      return "<IoUringReadFile>";
+    }
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 10 << 20;
+  }
+
+ private:
+  const std::string path_;
+  const bool directIo_;
+  const bool ownsFd_;
+  int32_t fd_;
+  uint64_t size_;
+};
+
+} // namespace facebook::velox
@@ -25,6 +25,11 @@ DEFINE_int64(
 DEFINE_int32(num_threads, 16, "Test paralelism");
 DEFINE_int32(seed, 0, "Random seed, 0 means no seed");
 DEFINE_bool(odirect, false, "Use O_DIRECT");
+DEFINE_bool(
+    io_uring,
+    false,
+    "Read through IoUringReadFile instead of LocalReadFile. Requires a "
+    "build with VELOX_ENABLE_IO_URING");
 
 DEFINE_int32(
     bytes,
@@ -31,6 +31,9 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#endif
 #include "velox/common/time/Timer.h"
 
 DECLARE_string(path);
@@ -38,6 +41,7 @@ DECLARE_int64(file_size_gb);
 DECLARE_int32(num_threads);
 DECLARE_int32(seed);
 DECLARE_bool(odirect);
+DECLARE_bool(io_uring);
 DECLARE_int32(bytes);
 DECLARE_int32(gap);
 DECLARE_int32(num_in_run);
@@ -66,7 +70,15 @@ class ReadBenchmark {
   virtual void initialize() {
     executor_ =
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
-    if (FLAGS_odirect) {
+    if (FLAGS_io_uring) {
+#ifdef VELOX_ENABLE_IO_URING
+      readFile_ =
+          std::make_unique<IoUringReadFile>(FLAGS_path, FLAGS_odirect);
+#else
+      LOG(ERROR) << "--io_uring requires a build with VELOX_ENABLE_IO_URING";
+      exit(1);
+#endif
+    } else if (FLAGS_odirect) {
       int32_t o_direct =
 #ifdef linux
           O_DIRECT;
@@ -131,6 +143,48 @@ class ReadBenchmark {
     return *scratch;
   }
 
+  // Returns the ranges to preadv for a run of 'count' reads of 'size' bytes
+  // separated by 'gap' bytes into 'buffer'.
+  static std::vector<folly::Range<char*>>
+  makeRanges(char* buffer, int32_t size, int32_t gap, int32_t rangeSize) {
+    std::vector<folly::Range<char*>> ranges;
+    for (auto start = 0; start < rangeSize; start += size + gap) {
+      ranges.push_back(folly::Range<char*>(buffer + start, size));
+      if (gap && start + gap < rangeSize) {
+        ranges.push_back(folly::Range<char*>(nullptr, gap));
+      }
+    }
+    return ranges;
+  }
+
+  // Measures the throughput of preadvAsync with all reads in flight at the
+  // same time. The reads are issued from the calling thread and no executor
+  // thread waits for them.
+  void asyncReads(int32_t size, int32_t gap, int32_t count, int32_t repeats) {
+    clearCache();
+    uint64_t usec = 0;
+    {
+      MicrosecondTimer timer(&usec);
+      int32_t rangeSize = size * count + gap * (count - 1);
+      std::vector<std::string> buffers(repeats);
+      std::vector<folly::SemiFuture<uint64_t>> futures;
+      futures.reserve(repeats);
+      for (auto repeat = 0; repeat < repeats; ++repeat) {
+        buffers[repeat].resize(rangeSize);
+        int64_t offset = folly::Random::rand64(rng_) % (fileSize_ - rangeSize);
+        futures.push_back(readFile_->preadvAsync(
+            offset, makeRanges(buffers[repeat].data(), size, gap, rangeSize)));
+      }
+      for (auto& result : folly::collectAll(std::move(futures)).get()) {
+        result.throwIfFailed();
+      }
+    }
+    std::cout << fmt::format(
+                     "{} MB/s preadvAsync",
+                     (static_cast<float>(count) * size * repeats) / usec)
+              << std::endl;
+  }
+
   // Measures the throughput for various ReadFile APIs(modes).
   void randomReads(
       int32_t size,
@@ -202,27 +256,16 @@ class ReadBenchmark {
                               this,
                               capturedPromise = std::move(promise)]() {
                 auto& scratch = getScratch(rangeSize);
-                std::vector<folly::Range<char*>> ranges;
-                for (auto start = 0; start < rangeSize; start += size + gap) {
-                  ranges.push_back(
-                      folly::Range<char*>(scratch.buffer.data() + start, size));
-                  if (gap && start + gap < rangeSize) {
-                    ranges.push_back(folly::Range<char*>(nullptr, gap));
-                  }
-                }
-                readFile_->preadv(offset, ranges);
+                readFile_->preadv(
+                    offset,
+                    makeRanges(scratch.buffer.data(), size, gap, rangeSize));
                 capturedPromise->setValue(true);
               });
             } else {
-              std::vector<folly::Range<char*>> ranges;
-              for (auto start = 0; start < rangeSize; start += size + gap) {
-                ranges.push_back(folly::Range<char*>(
-                    globalScratch.buffer.data() + start, size));
-                if (gap && start + gap < rangeSize) {
-                  ranges.push_back(folly::Range<char*>(nullptr, gap));
-                }
-              }
-              readFile_->preadv(offset, ranges);
+              readFile_->preadv(
+                  offset,
+                  makeRanges(
+                      globalScratch.buffer.data(), size, gap, rangeSize));
             }
 
             break;
@@ -289,6 +332,9 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (readFile_->hasPreadvAsync()) {
+      asyncReads(size, gap, count, repeats);
+    }
   }
 
   void run();
@@ -15,9 +15,15 @@
  */
 
 #include <fcntl.h>
+#include <unistd.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/DirectIoRead.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#endif
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -98,6 +104,139 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+#ifdef VELOX_ENABLE_IO_URING
+TEST(IoUringFile, writeAndRead) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  IoUringReadFile readFile(filename);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  // Several reads in flight at the same time.
+  char head[10];
+  char tail[5];
+  auto headFuture = readFile.preadvAsync(
+      0, {folly::Range<char*>(head, sizeof(head))});
+  auto tailFuture = readFile.preadvAsync(
+      10 + kOneMB, {folly::Range<char*>(tail, sizeof(tail))});
+  ASSERT_EQ(std::move(tailFuture).get(), sizeof(tail));
+  ASSERT_EQ(std::move(headFuture).get(), sizeof(head));
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+
+  // A read past the end of file fails through the future.
+  char pastEnd[10];
+  VELOX_ASSERT_THROW(
+      readFile
+          .preadvAsync(
+              10 + kOneMB, {folly::Range<char*>(pastEnd, sizeof(pastEnd))})
+          .get(),
+      "Short io_uring read");
+}
+
+TEST(IoUringFile, directIo) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  const int32_t fd = open(filename, O_RDONLY | O_DIRECT);
+  if (fd < 0) {
+    GTEST_SKIP() << "O_DIRECT is not supported for " << filename;
+  }
+  {
+    // The reads of readData() are unaligned and go through bounce buffers.
+    IoUringReadFile readFile(fd, true);
+    readData(&readFile);
+
+    // An aligned read goes to the buffer as is.
+    void* buffer = nullptr;
+    ASSERT_EQ(
+        posix_memalign(&buffer, kDirectIoAlignment, kDirectIoAlignment), 0);
+    ASSERT_EQ(
+        readFile.preadv(
+            0,
+            {folly::Range<char*>(
+                static_cast<char*>(buffer), kDirectIoAlignment)}),
+        kDirectIoAlignment);
+    ASSERT_EQ(
+        std::string_view(static_cast<char*>(buffer), 12), "aaaaabbbbbcc");
+    free(buffer);
+  }
+  close(fd);
+}
+#endif
+
+TEST(DirectIoRead, isAligned) {
+  alignas(kDirectIoAlignment) static char buffer[2 * kDirectIoAlignment];
+  const std::vector<folly::Range<char*>> aligned = {
+      folly::Range<char*>(buffer, kDirectIoAlignment),
+      folly::Range<char*>(nullptr, (char*)kDirectIoAlignment),
+      folly::Range<char*>(buffer + kDirectIoAlignment, kDirectIoAlignment)};
+  ASSERT_TRUE(isDirectIoAligned(0, aligned));
+  ASSERT_TRUE(isDirectIoAligned(3 * kDirectIoAlignment, aligned));
+  ASSERT_FALSE(isDirectIoAligned(100, aligned));
+  ASSERT_FALSE(isDirectIoAligned(
+      0, {folly::Range<char*>(buffer + 1, kDirectIoAlignment)}));
+  ASSERT_FALSE(isDirectIoAligned(0, {folly::Range<char*>(buffer, 100)}));
+  ASSERT_FALSE(
+      isDirectIoAligned(0, {folly::Range<char*>(nullptr, (char*)100)}));
+}
+
+TEST(DirectIoRead, bounceRead) {
+  DirectIoBounceRead bounceRead(5000, 10000);
+  ASSERT_EQ(bounceRead.readOffset, 4096);
+  ASSERT_EQ(bounceRead.skip, 904);
+  ASSERT_EQ(bounceRead.minBytes, 10904);
+  ASSERT_EQ(bounceRead.readSize, 12288);
+
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Reads with O_DIRECT if the file system supports it.
+  int32_t fd = open(filename, O_RDONLY | O_DIRECT);
+  if (fd < 0) {
+    fd = open(filename, O_RDONLY);
+  }
+  ASSERT_GE(fd, 0);
+
+  // An unaligned read to the end of file with skipped ranges.
+  char head[9];
+  char tail[7];
+  const uint64_t size = kOneMB + 15 - 3;
+  const uint64_t skipSize = size - sizeof(head) - sizeof(tail);
+  const std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)skipSize),
+      folly::Range<char*>(tail, sizeof(tail))};
+  DirectIoBounceRead read(3, size);
+  ASSERT_EQ(read.readOffset, 0);
+  ASSERT_EQ(read.skip, 3);
+  void* bounce = nullptr;
+  ASSERT_EQ(posix_memalign(&bounce, kDirectIoAlignment, read.readSize), 0);
+  // The aligned read extends past the end of file.
+  const auto bytesRead = ::pread(fd, bounce, read.readSize, read.readOffset);
+  ASSERT_GE(bytesRead, 0);
+  ASSERT_GE(static_cast<uint64_t>(bytesRead), read.minBytes);
+  ASSERT_LT(static_cast<uint64_t>(bytesRead), read.readSize);
+  read.copyTo(static_cast<char*>(bounce), buffers);
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+  free(bounce);
+  close(fd);
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
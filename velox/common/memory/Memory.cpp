@@ -365,7 +365,11 @@ MemoryManager::MemoryManager(const Options& options)
           *this,
           kRootNodeName.str(),
           nullptr,
-          MemoryPool::Options{alignment_, memoryQuota_})} {
+          MemoryPool::Options{alignment_, memoryQuota_})},
+      arbitrator_{
+          options.arbitratorConfig.has_value()
+              ? std::make_unique<MemoryArbitrator>(*options.arbitratorConfig)
+              : nullptr} {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_USER_CHECK_GE(memoryQuota_, 0);
   MemoryAllocator::alignmentCheck(0, alignment_);
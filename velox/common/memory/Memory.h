@@ -21,6 +21,7 @@
 #include <limits>
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <fmt/format.h>
@@ -37,6 +38,7 @@
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/memory/MemoryUsage.h"
 #include "velox/common/memory/MemoryUsageTracker.h"
 
@@ -368,6 +370,10 @@ class IMemoryManager {
 
     /// Specifies the backing memory allocator.
     MemoryAllocator* FOLLY_NONNULL allocator{MemoryAllocator::getInstance()};
+
+    /// If set, the memory manager creates a MemoryArbitrator that distributes
+    /// this capacity among the query memory pools.
+    std::optional<MemoryArbitrator::Config> arbitratorConfig;
   };
 
   virtual ~IMemoryManager() = default;
@@ -404,6 +410,12 @@ class IMemoryManager {
   ///
   /// TODO: deprecate this and enforce the memory usage quota by memory pool.
   virtual void release(int64_t size) = 0;
+
+  /// Returns the arbitrator that moves memory capacity between queries, or
+  /// nullptr if the capacity of each query is fixed.
+  virtual MemoryArbitrator* FOLLY_NULLABLE arbitrator() {
+    return nullptr;
+  }
 };
 
 /// For now, users wanting multiple different allocators would need to
@@ -444,6 +456,10 @@ class MemoryManager final : public IMemoryManager {
   bool reserve(int64_t size) final;
   void release(int64_t size) final;
 
+  MemoryArbitrator* FOLLY_NULLABLE arbitrator() final {
+    return arbitrator_.get();
+  }
+
   MemoryAllocator& getAllocator();
 
  private:
@@ -454,6 +470,7 @@ class MemoryManager final : public IMemoryManager {
   const uint16_t alignment_;
 
   std::shared_ptr<MemoryPool> root_;
+  const std::unique_ptr<MemoryArbitrator> arbitrator_;
   mutable folly::SharedMutex mutex_;
   std::atomic_long totalBytes_{0};
 };
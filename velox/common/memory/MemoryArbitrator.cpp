@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/MemoryArbitrator.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/ScopeGuard.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::memory {
+namespace {
+// True while a reclaimer frees memory on the current thread. Reclaimers may
+// reserve memory while spilling. Such nested growth requests are granted
+// without starting another arbitration.
+thread_local bool inArbitration{false};
+
+class ArbitrationGuard {
+ public:
+  ArbitrationGuard() {
+    inArbitration = true;
+  }
+
+  ~ArbitrationGuard() {
+    inArbitration = false;
+  }
+};
+} // namespace
+
+std::string MemoryArbitrator::Stats::toString() const {
+  return fmt::format(
+      "numRequests {} numFailures {} shrunkBytes {} reclaimedBytes {}",
+      numRequests,
+      numFailures,
+      succinctBytes(shrunkBytes),
+      succinctBytes(reclaimedBytes));
+}
+
+MemoryArbitrator::MemoryArbitrator(const Config& config)
+    : config_(config), freeCapacity_(config.capacity) {
+  VELOX_CHECK_GT(config_.capacity, 0);
+  VELOX_CHECK_GE(config_.initCapacity, 0);
+  VELOX_CHECK_GE(config_.minGrowBytes, 0);
+}
+
+void MemoryArbitrator::addTracker(
+    const std::shared_ptr<MemoryUsageTracker>& tracker) {
+  VELOX_CHECK_NOT_NULL(tracker);
+  std::lock_guard<std::mutex> l(mutex_);
+  purgeExpiredLocked();
+  VELOX_CHECK_EQ(
+      participants_.count(tracker.get()), 0, "Tracker is already added");
+  const int64_t initCapacity = std::min(config_.initCapacity, freeCapacity_);
+  tracker->setMaxMemory(initCapacity);
+  tracker->setGrowCallback(
+      [this](int64_t /*size*/, MemoryUsageTracker& growTracker) {
+        return grow(growTracker);
+      });
+  freeCapacity_ -= initCapacity;
+  participants_[tracker.get()] = Participant{tracker, initCapacity};
+}
+
+bool MemoryArbitrator::addReclaimer(
+    const MemoryUsageTracker* tracker,
+    std::weak_ptr<MemoryReclaimer> reclaimer) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (participants_.count(tracker) == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> reclaimerLock(reclaimerMutex_);
+  reclaimers_[tracker].push_back(std::move(reclaimer));
+  return true;
+}
+
+int64_t MemoryArbitrator::freeCapacity() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const_cast<MemoryArbitrator*>(this)->purgeExpiredLocked();
+  return freeCapacity_;
+}
+
+MemoryArbitrator::Stats MemoryArbitrator::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+void MemoryArbitrator::purgeExpiredLocked() {
+  for (auto it = participants_.begin(); it != participants_.end();) {
+    if (it->second.tracker.expired()) {
+      freeCapacity_ += it->second.capacity;
+      {
+        std::lock_guard<std::mutex> l(reclaimerMutex_);
+        reclaimers_.erase(it->first);
+      }
+      it = participants_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::vector<std::shared_ptr<MemoryReclaimer>> MemoryArbitrator::reclaimers(
+    const MemoryUsageTracker* tracker) const {
+  std::vector<std::shared_ptr<MemoryReclaimer>> result;
+  std::lock_guard<std::mutex> l(reclaimerMutex_);
+  auto it = reclaimers_.find(tracker);
+  if (it == reclaimers_.end()) {
+    return result;
+  }
+  for (auto& weak : it->second) {
+    if (auto reclaimer = weak.lock()) {
+      result.push_back(std::move(reclaimer));
+    }
+  }
+  return result;
+}
+
+bool MemoryArbitrator::grow(MemoryUsageTracker& tracker) {
+  if (inArbitration) {
+    return growInArbitration(tracker);
+  }
+
+  // Let the requesting query step out of the way of pause requests before
+  // taking 'mutex_'. Another arbitration may be waiting for the query to
+  // pause.
+  auto ownReclaimers = reclaimers(&tracker);
+  for (auto& reclaimer : ownReclaimers) {
+    reclaimer->enterArbitration();
+  }
+  SCOPE_EXIT {
+    for (auto& reclaimer : ownReclaimers) {
+      reclaimer->leaveArbitration();
+    }
+  };
+
+  int64_t target;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numRequests;
+    purgeExpiredLocked();
+    auto it = participants_.find(&tracker);
+    if (it == participants_.end()) {
+      ++stats_.numFailures;
+      return false;
+    }
+    const int64_t needed = tracker.reservedBytes() - it->second.capacity;
+    if (needed <= 0) {
+      // Another thread has already grown the capacity.
+      tracker.setMaxMemory(it->second.capacity);
+      return true;
+    }
+    target = std::max(needed, config_.minGrowBytes);
+    if (freeCapacity_ < target) {
+      shrinkLocked(&tracker, target);
+    }
+    if (freeCapacity_ >= needed) {
+      growLocked(it->second, tracker, target);
+      return true;
+    }
+  }
+
+  reclaim(&tracker, target);
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = participants_.find(&tracker);
+  if (it == participants_.end()) {
+    ++stats_.numFailures;
+    return false;
+  }
+  // Other requests may have taken or returned capacity meanwhile.
+  const int64_t needed = tracker.reservedBytes() - it->second.capacity;
+  if (needed <= 0) {
+    tracker.setMaxMemory(it->second.capacity);
+    return true;
+  }
+  if (freeCapacity_ < needed) {
+    ++stats_.numFailures;
+    return false;
+  }
+  growLocked(it->second, tracker, std::max(needed, config_.minGrowBytes));
+  return true;
+}
+
+bool MemoryArbitrator::growInArbitration(MemoryUsageTracker& tracker) {
+  // Grant the request, possibly exceeding the capacity. The excess is taken
+  // back when the reclaimed participant is shrunk after the reclaim.
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = participants_.find(&tracker);
+  if (it == participants_.end()) {
+    return false;
+  }
+  const int64_t needed = tracker.reservedBytes() - it->second.capacity;
+  if (needed > 0) {
+    it->second.capacity += needed;
+    freeCapacity_ -= needed;
+    tracker.setMaxMemory(it->second.capacity);
+  }
+  return true;
+}
+
+void MemoryArbitrator::growLocked(
+    Participant& participant,
+    MemoryUsageTracker& tracker,
+    int64_t targetBytes) {
+  const int64_t growBytes = std::min(targetBytes, freeCapacity_);
+  freeCapacity_ -= growBytes;
+  participant.capacity += growBytes;
+  tracker.setMaxMemory(participant.capacity);
+}
+
+int64_t MemoryArbitrator::shrinkLocked(
+    Participant& participant,
+    MemoryUsageTracker& tracker) {
+  const int64_t freeable = participant.capacity - tracker.reservedBytes();
+  if (freeable <= 0) {
+    return 0;
+  }
+  participant.capacity -= freeable;
+  freeCapacity_ += freeable;
+  tracker.setMaxMemory(participant.capacity);
+  return freeable;
+}
+
+void MemoryArbitrator::shrinkLocked(
+    const MemoryUsageTracker* requester,
+    int64_t targetBytes) {
+  for (auto& [key, participant] : participants_) {
+    if (freeCapacity_ >= targetBytes) {
+      return;
+    }
+    if (key == requester) {
+      continue;
+    }
+    if (auto tracker = participant.tracker.lock()) {
+      stats_.shrunkBytes += shrinkLocked(participant, *tracker);
+    }
+  }
+}
+
+void MemoryArbitrator::reclaim(
+    const MemoryUsageTracker* requester,
+    int64_t targetBytes) {
+  std::vector<std::shared_ptr<MemoryUsageTracker>> trackers;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& [key, participant] : participants_) {
+      if (key == requester) {
+        continue;
+      }
+      if (auto tracker = participant.tracker.lock()) {
+        trackers.push_back(std::move(tracker));
+      }
+    }
+  }
+
+  struct Candidate {
+    std::shared_ptr<MemoryUsageTracker> tracker;
+    std::shared_ptr<MemoryReclaimer> reclaimer;
+    int64_t reclaimableBytes;
+  };
+  std::vector<Candidate> candidates;
+  for (auto& tracker : trackers) {
+    for (auto& reclaimer : reclaimers(tracker.get())) {
+      const auto reclaimableBytes = reclaimer->reclaimableBytes();
+      if (reclaimableBytes > 0) {
+        candidates.push_back({tracker, std::move(reclaimer), reclaimableBytes});
+      }
+    }
+  }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& left, const Candidate& right) {
+        return left.reclaimableBytes > right.reclaimableBytes;
+      });
+
+  for (auto& candidate : candidates) {
+    int64_t freeCapacity;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      freeCapacity = freeCapacity_;
+    }
+    if (freeCapacity >= targetBytes) {
+      return;
+    }
+    int64_t reclaimedBytes = 0;
+    try {
+      ArbitrationGuard guard;
+      reclaimedBytes = candidate.reclaimer->reclaim(targetBytes - freeCapacity);
+    } catch (const std::exception& e) {
+      // The grow callback must not throw. A failed reclaim leaves the victim
+      // as is and the arbitration continues with the next candidate.
+      LOG(ERROR) << "Failed to reclaim memory: " << e.what();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    stats_.reclaimedBytes += std::max<int64_t>(reclaimedBytes, 0);
+    auto it = participants_.find(candidate.tracker.get());
+    if (it != participants_.end()) {
+      shrinkLocked(it->second, *candidate.tracker);
+    }
+  }
+}
+
+} // namespace facebook::velox::memory
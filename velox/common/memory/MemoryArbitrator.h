@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "velox/common/memory/MemoryUsageTracker.h"
+
+namespace facebook::velox::memory {
+
+/// Interface implemented by the owner of a query's memory, e.g. a Task, to
+/// free up memory on behalf of a MemoryArbitrator. A reclaimer is registered
+/// against the root MemoryUsageTracker of the query it belongs to.
+class MemoryReclaimer {
+ public:
+  virtual ~MemoryReclaimer() = default;
+
+  /// Called on the thread requesting more capacity before the arbitrator
+  /// starts reclaiming memory from other queries. The reclaimer of the
+  /// requesting query uses this to step out of the way, e.g. by marking its
+  /// running driver as suspended so that it does not block pause requests.
+  virtual void enterArbitration() {}
+
+  /// Called on the requesting thread after arbitration completes.
+  virtual void leaveArbitration() {}
+
+  /// Returns an estimate of the bytes that reclaim() can free.
+  virtual int64_t reclaimableBytes() const = 0;
+
+  /// Tries to free at least 'targetBytes' from the memory owned by this
+  /// reclaimer, e.g. by spilling. Returns the number of bytes freed.
+  virtual int64_t reclaim(int64_t targetBytes) = 0;
+};
+
+/// Distributes a fixed memory capacity among the root MemoryUsageTrackers of
+/// the running queries. A tracker starts with a small capacity. When a
+/// reservation exceeds it, the arbitrator grows it, first from the free
+/// capacity, then by shrinking the unused capacity of other trackers and
+/// finally by asking the reclaimers of other queries to free memory.
+class MemoryArbitrator {
+ public:
+  struct Config {
+    /// The total capacity to distribute.
+    int64_t capacity;
+
+    /// The capacity given to a newly added tracker, if available.
+    int64_t initCapacity;
+
+    /// The minimum capacity added to a tracker on each growth. Larger steps
+    /// reduce the number of arbitration rounds.
+    int64_t minGrowBytes;
+  };
+
+  struct Stats {
+    /// The number of growth requests.
+    uint64_t numRequests{0};
+
+    /// The number of growth requests that could not be satisfied.
+    uint64_t numFailures{0};
+
+    /// The capacity taken back from trackers without reclaiming memory.
+    uint64_t shrunkBytes{0};
+
+    /// The bytes freed by reclaimers.
+    uint64_t reclaimedBytes{0};
+
+    std::string toString() const;
+  };
+
+  explicit MemoryArbitrator(const Config& config);
+
+  /// Starts managing the capacity of the root 'tracker'. Sets its limit to
+  /// the initial capacity and installs a grow callback. The capacity is
+  /// returned to the arbitrator once the tracker is destroyed.
+  void addTracker(const std::shared_ptr<MemoryUsageTracker>& tracker);
+
+  /// Registers 'reclaimer' to free memory for 'tracker'. Returns false if
+  /// 'tracker' is not managed by this arbitrator.
+  bool addReclaimer(
+      const MemoryUsageTracker* tracker,
+      std::weak_ptr<MemoryReclaimer> reclaimer);
+
+  /// Returns the capacity not given to any tracker.
+  int64_t freeCapacity() const;
+
+  int64_t capacity() const {
+    return config_.capacity;
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Participant {
+    std::weak_ptr<MemoryUsageTracker> tracker;
+    int64_t capacity;
+  };
+
+  // Grow callback of the managed trackers. Raises the limit of 'tracker' to
+  // cover its current reservation. Returns false if not enough capacity
+  // could be found.
+  bool grow(MemoryUsageTracker& tracker);
+
+  // Grants a growth request made by a reclaimer while it frees memory on the
+  // calling thread.
+  bool growInArbitration(MemoryUsageTracker& tracker);
+
+  // Raises the capacity of 'participant' by up to 'targetBytes' from the free
+  // capacity.
+  void growLocked(
+      Participant& participant,
+      MemoryUsageTracker& tracker,
+      int64_t targetBytes);
+
+  // Returns the capacity of the destroyed trackers to the free capacity.
+  void purgeExpiredLocked();
+
+  // Lowers the limit of all participants except 'requester' to their current
+  // reservation until 'targetBytes' are free.
+  void shrinkLocked(const MemoryUsageTracker* requester, int64_t targetBytes);
+
+  // Asks the reclaimers of all participants except 'requester' to free memory
+  // until 'targetBytes' are free. Participants are tried in descending order
+  // of reclaimable bytes. Called without holding 'mutex_' since reclaimers
+  // pause their queries and take the locks of these.
+  void reclaim(const MemoryUsageTracker* requester, int64_t targetBytes);
+
+  // Lowers the capacity of 'participant' to its current reservation. Returns
+  // the capacity freed.
+  int64_t shrinkLocked(Participant& participant, MemoryUsageTracker& tracker);
+
+  std::vector<std::shared_ptr<MemoryReclaimer>> reclaimers(
+      const MemoryUsageTracker* tracker) const;
+
+  const Config config_;
+
+  // Protects the capacities and the stats. Never held while calling into a
+  // reclaimer.
+  mutable std::mutex mutex_;
+  int64_t freeCapacity_;
+  std::unordered_map<const MemoryUsageTracker*, Participant> participants_;
+  Stats stats_;
+
+  // Protects 'reclaimers_'. Acquired after 'mutex_' if both are held.
+  mutable std::mutex reclaimerMutex_;
+  std::unordered_map<
+      const MemoryUsageTracker*,
+      std::vector<std::weak_ptr<MemoryReclaimer>>>
+      reclaimers_;
+};
+
+} // namespace facebook::velox::memory
@@ -206,6 +206,15 @@ class MemoryUsageTracker
 
   std::string toString() const;
 
+  /// Sets the memory limit of a root tracker. Used by MemoryArbitrator to move
+  /// capacity between root trackers. A limit below the current reservation
+  /// makes the next reservation call the grow callback.
+  void setMaxMemory(int64_t maxMemory) {
+    VELOX_CHECK_NULL(parent_, "Only root tracker has a memory limit");
+    VELOX_CHECK_GE(maxMemory, 0);
+    maxMemory_ = maxMemory;
+  }
+
   void testingUpdateMaxMemory(int64_t maxMemory) {
     maxMemory_ = maxMemory;
   }
@@ -280,8 +289,9 @@ class MemoryUsageTracker
   std::mutex mutex_;
   std::shared_ptr<MemoryUsageTracker> parent_;
 
-  // The memory limit in bytes to enforce.
-  int64_t maxMemory_;
+  // The memory limit in bytes to enforce. Atomic since a MemoryArbitrator may
+  // change it while other threads make reservations.
+  std::atomic<int64_t> maxMemory_;
 
   std::atomic<int64_t> peakBytes_{0};
   std::atomic<int64_t> cumulativeBytes_{0};
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/VeloxException.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+
+using namespace ::testing;
+using namespace ::facebook::velox::memory;
+using namespace ::facebook::velox;
+
+namespace {
+constexpr int64_t kMB = 1 << 20;
+
+// Frees memory by releasing the reservation of a tracker.
+class FakeReclaimer : public MemoryReclaimer {
+ public:
+  explicit FakeReclaimer(std::shared_ptr<MemoryUsageTracker> tracker)
+      : tracker_(std::move(tracker)) {}
+
+  void enterArbitration() override {
+    ++numEnters;
+  }
+
+  void leaveArbitration() override {
+    ++numLeaves;
+  }
+
+  int64_t reclaimableBytes() const override {
+    return tracker_->currentBytes();
+  }
+
+  int64_t reclaim(int64_t /*targetBytes*/) override {
+    ++numReclaims;
+    const int64_t bytes = tracker_->currentBytes();
+    tracker_->update(-bytes);
+    return bytes;
+  }
+
+  int32_t numEnters{0};
+  int32_t numLeaves{0};
+  int32_t numReclaims{0};
+
+ private:
+  const std::shared_ptr<MemoryUsageTracker> tracker_;
+};
+
+MemoryArbitrator::Config makeConfig() {
+  // 32MB capacity, 4MB initial capacity per tracker, grows by at least 2MB.
+  return MemoryArbitrator::Config{32 * kMB, 4 * kMB, 2 * kMB};
+}
+} // namespace
+
+TEST(MemoryArbitratorTest, addTracker) {
+  MemoryArbitrator arbitrator(makeConfig());
+  ASSERT_EQ(arbitrator.freeCapacity(), 32 * kMB);
+  {
+    auto tracker = MemoryUsageTracker::create();
+    arbitrator.addTracker(tracker);
+    ASSERT_EQ(tracker->maxMemory(), 4 * kMB);
+    ASSERT_EQ(arbitrator.freeCapacity(), 28 * kMB);
+    ASSERT_THROW(arbitrator.addTracker(tracker), VeloxRuntimeError);
+
+    // Child trackers can't be added.
+    ASSERT_ANY_THROW(arbitrator.addTracker(tracker->addChild()));
+  }
+  // The capacity is returned once the tracker is destroyed.
+  ASSERT_EQ(arbitrator.freeCapacity(), 32 * kMB);
+
+  auto reclaimer = std::make_shared<FakeReclaimer>(nullptr);
+  auto unmanaged = MemoryUsageTracker::create();
+  ASSERT_FALSE(arbitrator.addReclaimer(unmanaged.get(), reclaimer));
+}
+
+TEST(MemoryArbitratorTest, growFromFreeCapacity) {
+  MemoryArbitrator arbitrator(makeConfig());
+  auto tracker = MemoryUsageTracker::create();
+  arbitrator.addTracker(tracker);
+
+  tracker->update(4 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 4 * kMB);
+  ASSERT_EQ(arbitrator.stats().numRequests, 0);
+
+  // Grows by at least 'minGrowBytes'.
+  tracker->update(1 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 6 * kMB);
+  ASSERT_EQ(arbitrator.freeCapacity(), 26 * kMB);
+
+  tracker->update(10 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 15 * kMB);
+  ASSERT_EQ(arbitrator.freeCapacity(), 17 * kMB);
+  ASSERT_EQ(arbitrator.stats().numRequests, 2);
+  ASSERT_EQ(arbitrator.stats().numFailures, 0);
+  tracker->update(-15 * kMB);
+}
+
+TEST(MemoryArbitratorTest, shrinkIdleCapacity) {
+  MemoryArbitrator arbitrator(makeConfig());
+  auto idle = MemoryUsageTracker::create();
+  arbitrator.addTracker(idle);
+  idle->update(12 * kMB);
+  idle->update(-10 * kMB);
+  ASSERT_EQ(idle->maxMemory(), 12 * kMB);
+
+  auto tracker = MemoryUsageTracker::create();
+  arbitrator.addTracker(tracker);
+  tracker->update(24 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 24 * kMB);
+  // The unused capacity of 'idle' is taken back.
+  ASSERT_EQ(idle->maxMemory(), 2 * kMB);
+  ASSERT_EQ(arbitrator.stats().shrunkBytes, 10 * kMB);
+  ASSERT_EQ(arbitrator.stats().reclaimedBytes, 0);
+
+  // 'idle' needs to grow again to use its released memory.
+  idle->update(2 * kMB);
+  ASSERT_EQ(idle->maxMemory(), 4 * kMB);
+  idle->update(-4 * kMB);
+  tracker->update(-24 * kMB);
+}
+
+TEST(MemoryArbitratorTest, reclaim) {
+  MemoryArbitrator arbitrator(makeConfig());
+  auto small = MemoryUsageTracker::create();
+  arbitrator.addTracker(small);
+  auto smallReclaimer = std::make_shared<FakeReclaimer>(small);
+  ASSERT_TRUE(arbitrator.addReclaimer(small.get(), smallReclaimer));
+  small->update(4 * kMB);
+
+  auto large = MemoryUsageTracker::create();
+  arbitrator.addTracker(large);
+  auto largeReclaimer = std::make_shared<FakeReclaimer>(large);
+  ASSERT_TRUE(arbitrator.addReclaimer(large.get(), largeReclaimer));
+  large->update(20 * kMB);
+
+  auto tracker = MemoryUsageTracker::create();
+  arbitrator.addTracker(tracker);
+  auto reclaimer = std::make_shared<FakeReclaimer>(tracker);
+  ASSERT_TRUE(arbitrator.addReclaimer(tracker.get(), reclaimer));
+  ASSERT_EQ(arbitrator.freeCapacity(), 4 * kMB);
+
+  // Only the largest reclaimer needs to free memory.
+  tracker->update(12 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 12 * kMB);
+  ASSERT_EQ(largeReclaimer->numReclaims, 1);
+  ASSERT_EQ(smallReclaimer->numReclaims, 0);
+  ASSERT_EQ(reclaimer->numReclaims, 0);
+  ASSERT_EQ(large->currentBytes(), 0);
+  ASSERT_EQ(large->maxMemory(), 0);
+  ASSERT_EQ(arbitrator.stats().reclaimedBytes, 20 * kMB);
+
+  // Only the requester enters and leaves arbitration.
+  ASSERT_EQ(reclaimer->numEnters, 1);
+  ASSERT_EQ(reclaimer->numLeaves, 1);
+  ASSERT_EQ(smallReclaimer->numEnters, 0);
+
+  small->update(-4 * kMB);
+  tracker->update(-12 * kMB);
+}
+
+TEST(MemoryArbitratorTest, growFailure) {
+  MemoryArbitrator arbitrator(makeConfig());
+  auto other = MemoryUsageTracker::create();
+  arbitrator.addTracker(other);
+  other->update(16 * kMB);
+
+  auto tracker = MemoryUsageTracker::create();
+  arbitrator.addTracker(tracker);
+  ASSERT_THROW(tracker->update(20 * kMB), VeloxRuntimeError);
+  ASSERT_EQ(tracker->currentBytes(), 0);
+  ASSERT_EQ(arbitrator.stats().numFailures, 1);
+
+  // Nothing is lost on failure.
+  tracker->update(12 * kMB);
+  ASSERT_EQ(tracker->maxMemory(), 12 * kMB);
+  ASSERT_EQ(arbitrator.freeCapacity(), 0);
+  tracker->update(-12 * kMB);
+  other->update(-16 * kMB);
+}
+
+TEST(MemoryArbitratorTest, reclaimWithoutArbitratorLock) {
+  MemoryArbitrator arbitrator(makeConfig());
+  auto victim = MemoryUsageTracker::create();
+  arbitrator.addTracker(victim);
+  victim->update(24 * kMB);
+
+  // Reclaimers pause their queries, which waits for threads that may be
+  // requesting memory themselves. The arbitrator must not be locked while a
+  // reclaimer runs.
+  class LockingReclaimer : public FakeReclaimer {
+   public:
+    LockingReclaimer(
+        std::shared_ptr<MemoryUsageTracker> tracker,
+        MemoryArbitrator& arbitrator)
+        : FakeReclaimer(std::move(tracker)), arbitrator_(arbitrator) {}
+
+    int64_t reclaimableBytes() const override {
+      arbitrator_.stats();
+      return FakeReclaimer::reclaimableBytes();
+    }
+
+    int64_t reclaim(int64_t targetBytes) override {
+      arbitrator_.freeCapacity();
+      return FakeReclaimer::reclaim(targetBytes);
+    }
+
+   private:
+    MemoryArbitrator& arbitrator_;
+  };
+  auto reclaimer = std::make_shared<LockingReclaimer>(victim, arbitrator);
+  ASSERT_TRUE(arbitrator.addReclaimer(victim.get(), reclaimer));
+
+  auto tracker = MemoryUsageTracker::create();
+  arbitrator.addTracker(tracker);
+  tracker->update(16 * kMB);
+  ASSERT_EQ(reclaimer->numReclaims, 1);
+  ASSERT_EQ(arbitrator.stats().reclaimedBytes, 24 * kMB);
+  tracker->update(-16 * kMB);
+}
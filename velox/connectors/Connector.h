@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -34,6 +35,7 @@ class ExprSet;
 }
 namespace facebook::velox::connector {
 class ConnectorCommitInfo;
+class DataSource;
 class WriteProtocol;
 
 // A split represents a chunk of data that a connector should load and return
@@ -45,6 +47,13 @@ struct ConnectorSplit {
   // async prefetch for the split.
   bool cancelled{false};
 
+  // DataSource with this split added, prepared ahead of time on a background
+  // executor. Set by the table scan that preloads the split. The consumer
+  // moves the prepared DataSource out and adopts its state with
+  // DataSource::setFromDataSource(). The item is a shared_ptr because that is
+  // what Connector::createDataSource() returns.
+  std::shared_ptr<AsyncSource<std::shared_ptr<DataSource>>> dataSource;
+
   explicit ConnectorSplit(const std::string& _connectorId)
       : connectorId(_connectorId) {}
 
@@ -151,6 +160,15 @@ class DataSource {
   virtual int64_t estimatedRowSize() {
     return kUnknownRowSize;
   }
+
+  // Takes over the split and the opened readers of 'source', which was
+  // created by the same connector for the same table and columns and had
+  // addSplit() called on it, possibly on another thread. Used instead of
+  // addSplit() for splits that were preloaded. Only supported by connectors
+  // that return true from Connector::supportsSplitPreload().
+  virtual void setFromDataSource(std::shared_ptr<DataSource> /*source*/) {
+    VELOX_UNSUPPORTED("setFromDataSource");
+  }
 };
 
 // Exposes expression evaluation functionality of the engine to the connector.
@@ -258,6 +276,19 @@ class Connector {
     return false;
   }
 
+  // Returns true if a DataSource of this connector can add a split on a
+  // background thread and be handed over to another DataSource with
+  // DataSource::setFromDataSource().
+  virtual bool supportsSplitPreload() {
+    return false;
+  }
+
+  // Returns the executor for background work of this connector, e.g. split
+  // preload and read-ahead, or nullptr if there is none.
+  virtual folly::Executor* FOLLY_NULLABLE executor() const {
+    return nullptr;
+  }
+
   virtual std::shared_ptr<DataSource> createDataSource(
       const RowTypePtr& outputType,
       const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
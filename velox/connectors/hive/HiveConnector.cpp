@@ -319,7 +319,12 @@ void HiveDataSource::addDynamicFilter(
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   if (fieldSpec.filter()) {
-    fieldSpec.setFilter(fieldSpec.filter()->mergeWith(filter.get()));
+    // Only a Bloom filter knows how to merge with any other filter.
+    if (filter->kind() == common::FilterKind::kValuesUsingBloomFilter) {
+      fieldSpec.setFilter(filter->mergeWith(fieldSpec.filter()));
+    } else {
+      fieldSpec.setFilter(fieldSpec.filter()->mergeWith(filter.get()));
+    }
   } else {
     fieldSpec.setFilter(filter->clone());
   }
@@ -335,6 +340,46 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
+  createReader();
+  createRowReader();
+}
+
+void HiveDataSource::setFromDataSource(std::shared_ptr<DataSource> source) {
+  auto* hiveSource = dynamic_cast<HiveDataSource*>(source.get());
+  VELOX_CHECK_NOT_NULL(hiveSource, "Wrong type of DataSource");
+  VELOX_CHECK(
+      split_ == nullptr,
+      "Previous split has not been processed yet. Call next to process the split.");
+  VELOX_CHECK_NOT_NULL(hiveSource->split_, "Preloaded DataSource has no split");
+
+  split_ = std::move(hiveSource->split_);
+  VLOG(1) << "Adding preloaded split " << split_->toString();
+  checkFileFormat();
+  fileHandle_ = std::move(hiveSource->fileHandle_);
+  // 'source' may have been created before some dynamic filters arrived, so
+  // keep only its reader and set up the row reader against 'scanSpec_'.
+  hiveSource->rowReader_.reset();
+  reader_ = std::move(hiveSource->reader_);
+  // The input of 'reader_' accounts its IO to the stats of 'source'. Carry
+  // the balance of 'this' over and continue with these.
+  hiveSource->ioStats_->merge(*ioStats_);
+  ioStats_ = std::move(hiveSource->ioStats_);
+  createRowReader();
+}
+
+void HiveDataSource::checkFileFormat() {
+  if (readerOpts_.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
+    VELOX_CHECK(
+        readerOpts_.getFileFormat() == split_->fileFormat,
+        "HiveDataSource received splits of different formats: {} and {}",
+        toString(readerOpts_.getFileFormat()),
+        toString(split_->fileFormat));
+  } else {
+    readerOpts_.setFileFormat(split_->fileFormat);
+  }
+}
+
+void HiveDataSource::createReader() {
   fileHandle_ = fileHandleFactory_->generate(split_->filePath);
   std::unique_ptr<dwio::common::BufferedInput> input;
   if (auto* asyncCache = dynamic_cast<cache::AsyncDataCache*>(allocator_)) {
@@ -358,19 +403,12 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
         ioStats_.get());
   }
 
-  if (readerOpts_.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
-    VELOX_CHECK(
-        readerOpts_.getFileFormat() == split_->fileFormat,
-        "HiveDataSource received splits of different formats: {} and {}",
-        toString(readerOpts_.getFileFormat()),
-        toString(split_->fileFormat));
-  } else {
-    readerOpts_.setFileFormat(split_->fileFormat);
-  }
-
+  checkFileFormat();
   reader_ = dwio::common::getReaderFactory(readerOpts_.getFileFormat())
                 ->createReader(std::move(input), readerOpts_);
+}
 
+void HiveDataSource::createRowReader() {
   emptySplit_ = false;
   if (reader_->numberOfRows() == 0) {
     emptySplit_ = true;
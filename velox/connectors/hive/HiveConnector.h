@@ -120,6 +120,8 @@ class HiveDataSource : public DataSource {
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
+  void setFromDataSource(std::shared_ptr<DataSource> source) override;
+
   void addDynamicFilter(
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
@@ -159,6 +161,16 @@ class HiveDataSource : public DataSource {
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  /// Checks that split_ has the same file format as the previous splits.
+  void checkFileFormat();
+
+  /// Opens the file of split_ and creates reader_.
+  void createReader();
+
+  /// Sets the split-specific constants in scanSpec_ and creates rowReader_
+  /// unless the split can be skipped.
+  void createRowReader();
+
   /// Clear split_, reader_ and rowReader_ after split has been fully processed.
   void resetSplit();
 
@@ -194,7 +206,9 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
 
   memory::MemoryAllocator* const FOLLY_NONNULL allocator_;
-  const std::string& scanId_;
+  // A copy, not a reference, since a preloaded HiveDataSource may outlive the
+  // ConnectorQueryCtx it was created with.
+  const std::string scanId_;
   folly::Executor* FOLLY_NULLABLE executor_;
 };
 
@@ -222,6 +236,10 @@ class HiveConnector final : public Connector {
     return true;
   }
 
+  bool supportsSplitPreload() override {
+    return true;
+  }
+
   std::shared_ptr<DataSource> createDataSource(
       const RowTypePtr& outputType,
       const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -254,7 +272,7 @@ class HiveConnector final : public Connector {
         inputType, hiveInsertHandle, connectorQueryCtx, writeProtocol);
   }
 
-  folly::Executor* FOLLY_NULLABLE executor() {
+  folly::Executor* FOLLY_NULLABLE executor() const override {
     return executor_;
   }
 
@@ -434,6 +434,64 @@ void CrossJoinNode::addDetails(std::stringstream& /* stream */) const {
   // Nothing to add.
 }
 
+NestedLoopJoinNode::NestedLoopJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    TypedExprPtr joinCondition,
+    PlanNodePtr left,
+    PlanNodePtr right,
+    RowTypePtr outputType)
+    : PlanNode(id),
+      joinType_(joinType),
+      joinCondition_(std::move(joinCondition)),
+      sources_({std::move(left), std::move(right)}),
+      outputType_(std::move(outputType)) {
+  VELOX_USER_CHECK(
+      isSupported(joinType_),
+      "The nested loop join node does not support join type: {}",
+      joinTypeName(joinType_));
+  if (joinCondition_ != nullptr) {
+    VELOX_USER_CHECK_EQ(
+        joinCondition_->type()->kind(),
+        TypeKind::BOOLEAN,
+        "The join condition must be a boolean expression");
+  }
+
+  const auto& leftType = sources_[0]->outputType();
+  const auto& rightType = sources_[1]->outputType();
+  for (const auto& name : outputType_->names()) {
+    const bool inLeft = leftType->containsChild(name);
+    const bool inRight = rightType->containsChild(name);
+    VELOX_USER_CHECK(
+        !(inLeft && inRight),
+        "Duplicate column name found on join's left and right sides: {}",
+        name);
+    VELOX_USER_CHECK(
+        inLeft || inRight,
+        "Join's output column not found in either left or right sides: {}",
+        name);
+  }
+}
+
+bool NestedLoopJoinNode::isSupported(JoinType joinType) {
+  switch (joinType) {
+    case JoinType::kInner:
+    case JoinType::kLeft:
+    case JoinType::kRight:
+    case JoinType::kFull:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void NestedLoopJoinNode::addDetails(std::stringstream& stream) const {
+  stream << joinTypeName(joinType_);
+  if (joinCondition_ != nullptr) {
+    stream << ", joinCondition: " << joinCondition_->toString();
+  }
+}
+
 AssignUniqueIdNode::AssignUniqueIdNode(
     const PlanNodeId& id,
     const std::string& idName,
@@ -533,12 +591,14 @@ WindowNode::WindowNode(
     std::vector<SortOrder> sortingOrders,
     std::vector<std::string> windowColumnNames,
     std::vector<Function> windowFunctions,
+    bool inputsSorted,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       partitionKeys_(std::move(partitionKeys)),
       sortingKeys_(std::move(sortingKeys)),
       sortingOrders_(std::move(sortingOrders)),
       windowFunctions_(std::move(windowFunctions)),
+      inputsSorted_(inputsSorted),
       sources_{std::move(source)},
       outputType_(getWindowOutputType(
           sources_[0]->outputType(),
@@ -635,10 +695,17 @@ void OrderByNode::addDetails(std::stringstream& stream) const {
   if (isPartial_) {
     stream << "PARTIAL ";
   }
+  if (isParallel_) {
+    stream << "PARALLEL ";
+  }
   addSortingKeys(stream, sortingKeys_, sortingOrders_);
 }
 
 void WindowNode::addDetails(std::stringstream& stream) const {
+  if (inputsSorted_) {
+    stream << "STREAMING ";
+  }
+
   stream << "partition by [";
   if (!partitionKeys_.empty()) {
     addFields(stream, partitionKeys_);
@@ -543,12 +543,7 @@ class AggregationNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    // NOTE: as for now, we don't allow spilling for distinct aggregation
-    // (https://github.com/facebookincubator/velox/issues/3263) and pre-grouped
-    // aggregation (https://github.com/facebookincubator/velox/issues/3264). We
-    // will add support later to re-enable.
-    return (isFinal() || isSingle()) && !(aggregates().empty()) &&
-        preGroupedKeys().empty() && queryConfig.aggregationSpillEnabled();
+    return (isFinal() || isSingle()) && queryConfig.aggregationSpillEnabled();
   }
 
   bool isFinal() const {
@@ -1324,25 +1319,86 @@ class CrossJoinNode : public PlanNode {
   const RowTypePtr outputType_;
 };
 
+/// Represents inner/outer nested loop joins. Translates to an
+/// exec::NestedLoopJoinProbe and exec::NestedLoopJoinBuild. A separate
+/// pipeline is produced for the build side when generating exec::Operators.
+///
+/// 'joinCondition' is evaluated on every combination of a left and a right
+/// row, so that joins without equality conditions, e.g. range joins, do not
+/// need a cross join followed by a filter. A null 'joinCondition' matches
+/// all combinations. Left, right and full joins also return the rows without
+/// a match with nulls for the columns of the other side.
+class NestedLoopJoinNode : public PlanNode {
+ public:
+  NestedLoopJoinNode(
+      const PlanNodeId& id,
+      JoinType joinType,
+      TypedExprPtr joinCondition,
+      PlanNodePtr left,
+      PlanNodePtr right,
+      RowTypePtr outputType);
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  const RowTypePtr& outputType() const override {
+    return outputType_;
+  }
+
+  std::string_view name() const override {
+    return "NestedLoopJoin";
+  }
+
+  JoinType joinType() const {
+    return joinType_;
+  }
+
+  const TypedExprPtr& joinCondition() const {
+    return joinCondition_;
+  }
+
+  /// Returns true for the join types that NestedLoopJoinNode supports:
+  /// inner, left, right and full.
+  static bool isSupported(JoinType joinType);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const JoinType joinType_;
+  // Optional join condition, nullptr if absent.
+  const TypedExprPtr joinCondition_;
+  const std::vector<PlanNodePtr> sources_;
+  const RowTypePtr outputType_;
+};
+
 // Represents the 'SortBy' node in the plan.
 class OrderByNode : public PlanNode {
  public:
+  /// @param isParallel Specifies that a final OrderBy runs on multiple
+  /// drivers. The drivers split the input into key ranges by sampled
+  /// splitters and sort one range each. The first driver then outputs the
+  /// ranges in order, so that no merge is needed.
   OrderByNode(
       const PlanNodeId& id,
       const std::vector<FieldAccessTypedExprPtr>& sortingKeys,
       const std::vector<SortOrder>& sortingOrders,
       bool isPartial,
+      bool isParallel,
       const PlanNodePtr& source)
       : PlanNode(id),
         sortingKeys_(sortingKeys),
         sortingOrders_(sortingOrders),
         isPartial_(isPartial),
+        isParallel_(isParallel),
         sources_{source} {
     VELOX_CHECK(!sortingKeys.empty(), "OrderBy must specify sorting keys");
     VELOX_CHECK_EQ(
         sortingKeys.size(),
         sortingOrders.size(),
         "Number of sorting keys and sorting orders in OrderBy must be the same");
+    VELOX_CHECK(
+        !(isPartial && isParallel), "A partial OrderBy cannot be parallel");
   }
 
   const std::vector<FieldAccessTypedExprPtr>& sortingKeys() const {
@@ -1354,7 +1410,7 @@ class OrderByNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    return queryConfig.orderBySpillEnabled();
+    return !isParallel_ && queryConfig.orderBySpillEnabled();
   }
 
   const RowTypePtr& outputType() const override {
@@ -1372,6 +1428,10 @@ class OrderByNode : public PlanNode {
     return isPartial_;
   }
 
+  bool isParallel() const {
+    return isParallel_;
+  }
+
   std::string_view name() const override {
     return "OrderBy";
   }
@@ -1382,6 +1442,7 @@ class OrderByNode : public PlanNode {
   const std::vector<FieldAccessTypedExprPtr> sortingKeys_;
   const std::vector<SortOrder> sortingOrders_;
   const bool isPartial_;
+  const bool isParallel_;
   const std::vector<PlanNodePtr> sources_;
 };
 
@@ -1437,6 +1498,10 @@ class TopNNode : public PlanNode {
     return "TopN";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNSpillEnabled();
+  }
+
  private:
   void addDetails(std::stringstream& stream) const override;
 
@@ -1681,6 +1746,10 @@ class WindowNode : public PlanNode {
   /// @param windowColumnNames specifies the output column
   /// names for each window function column. So
   /// windowColumnNames.length() = windowFunctions.length().
+  /// @param inputsSorted Specifies that the input is already ordered by the
+  /// partition keys followed by the sorting keys. The Window operator then
+  /// processes each partition as soon as all its rows have arrived instead of
+  /// sorting the whole input.
   WindowNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -1688,6 +1757,7 @@ class WindowNode : public PlanNode {
       std::vector<SortOrder> sortingOrders,
       std::vector<std::string> windowColumnNames,
       std::vector<Function> windowFunctions,
+      bool inputsSorted,
       PlanNodePtr source);
 
   const std::vector<PlanNodePtr>& sources() const override {
@@ -1716,10 +1786,19 @@ class WindowNode : public PlanNode {
     return windowFunctions_;
   }
 
+  bool inputsSorted() const {
+    return inputsSorted_;
+  }
+
   std::string_view name() const override {
     return "Window";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // Sorted input is processed one partition at a time and is not spilled.
+    return !inputsSorted_ && queryConfig.windowSpillEnabled();
+  }
+
  private:
   void addDetails(std::stringstream& stream) const override;
 
@@ -1730,6 +1809,8 @@ class WindowNode : public PlanNode {
 
   const std::vector<Function> windowFunctions_;
 
+  const bool inputsSorted_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
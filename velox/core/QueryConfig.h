@@ -94,9 +94,31 @@ class QueryConfig {
   static constexpr const char* kPartialAggregationGoodPct =
       "partial_aggregation_reduction_ratio_threshold";
 
+  /// Number of input rows a partial aggregation sees before it checks whether
+  /// to stop aggregating. 0 disables the check.
+  static constexpr const char* kAbandonPartialAggregationMinRows =
+      "abandon_partial_aggregation_min_rows";
+
+  /// Number of groups as percentage of input rows at or above which a partial
+  /// aggregation stops aggregating and outputs an intermediate result per
+  /// input row.
+  static constexpr const char* kAbandonPartialAggregationMinPct =
+      "abandon_partial_aggregation_min_pct";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "driver.max-page-partitioning-buffer-size";
 
+  /// The compression codec for pages exchanged between tasks: "none", "zlib",
+  /// "snappy", "zstd" or "lz4". "none" by default. Producers and consumers of
+  /// an exchange must use the same codec.
+  static constexpr const char* kShuffleCompressionKind =
+      "shuffle_compression_codec";
+
+  /// If true, PartitionedOutput serializes dictionary and constant encoded
+  /// columns as DICTIONARY and RLE blocks instead of flattening them.
+  static constexpr const char* kShufflePreserveEncodings =
+      "shuffle_preserve_encodings";
+
   /// Preffered number of rows to be returned by operators from
   /// Operator::getOutput.
   static constexpr const char* kPreferredOutputBatchSize =
@@ -108,6 +130,29 @@ class QueryConfig {
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "driver.adaptive_filter_reordering_enabled";
 
+  /// If true, hash joins whose build side keys do not fit a range or value set
+  /// build a Bloom filter per key and push it down to the probe side table
+  /// scan as a dynamic filter.
+  static constexpr const char* kHashJoinBloomFilterEnabled =
+      "hash_join_bloom_filter_enabled";
+
+  /// If true, large hash join tables in kHash mode get a Bloom filter over the
+  /// hash numbers of their keys. The probe tests each row against the filter
+  /// before looking it up in the table.
+  static constexpr const char* kHashProbeBloomFilterEnabled =
+      "hash_probe_bloom_filter_enabled";
+
+  /// If true, hash join probes of large tables partition each batch of probe
+  /// rows by region of the table and prefetch the table entries of the rows
+  /// ahead.
+  static constexpr const char* kHashProbePartitioningEnabled =
+      "hash_probe_partitioning_enabled";
+
+  /// Maximum number of splits each table scan driver opens ahead of time on
+  /// the connector's executor. Zero disables split preloading.
+  static constexpr const char* kMaxSplitPreloadPerDriver =
+      "max_split_preload_per_driver";
+
   static constexpr const char* kCreateEmptyFiles = "driver.create_empty_files";
 
   /// Global enable spilling flag.
@@ -126,6 +171,12 @@ class QueryConfig {
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
+  /// Window spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
+
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -141,6 +192,11 @@ class QueryConfig {
   static constexpr const char* kOrderBySpillMemoryThreshold =
       "order_by_spill_memory_threshold";
 
+  /// The max memory that a window operator can use before spilling. If it 0,
+  /// then there is no limit.
+  static constexpr const char* kWindowSpillMemoryThreshold =
+      "window_spill_memory_threshold";
+
   static constexpr const char* kTestingSpillPct = "testing.spill-pct";
 
   /// The max allowed spilling level with zero being the initial spilling level.
@@ -172,6 +228,11 @@ class QueryConfig {
   static constexpr const char* kSpillableReservationGrowthPct =
       "spillable-reservation-growth-pct";
 
+  /// The compression codec for spill files: "none", "zlib", "snappy", "zstd"
+  /// or "lz4". "none" by default.
+  static constexpr const char* kSpillCompressionKind =
+      "spill_compression_codec";
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -192,6 +253,16 @@ class QueryConfig {
     return get<double>(kPartialAggregationGoodPct, kDefault);
   }
 
+  int64_t abandonPartialAggregationMinRows() const {
+    static constexpr int64_t kDefault = 100'000;
+    return get<int64_t>(kAbandonPartialAggregationMinRows, kDefault);
+  }
+
+  int32_t abandonPartialAggregationMinPct() const {
+    static constexpr int32_t kDefault = 80;
+    return get<int32_t>(kAbandonPartialAggregationMinPct, kDefault);
+  }
+
   uint64_t joinSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kJoinSpillMemoryThreshold, kDefault);
@@ -202,6 +273,11 @@ class QueryConfig {
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
   }
 
+  uint64_t windowSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kWindowSpillMemoryThreshold, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -211,6 +287,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  std::string shuffleCompressionKind() const {
+    return get<std::string>(kShuffleCompressionKind, "none");
+  }
+
+  bool shufflePreserveEncodings() const {
+    return get<bool>(kShufflePreserveEncodings, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -238,6 +322,22 @@ class QueryConfig {
     return get<bool>(kAdaptiveFilterReorderingEnabled, true);
   }
 
+  bool hashJoinBloomFilterEnabled() const {
+    return get<bool>(kHashJoinBloomFilterEnabled, true);
+  }
+
+  bool hashProbeBloomFilterEnabled() const {
+    return get<bool>(kHashProbeBloomFilterEnabled, true);
+  }
+
+  bool hashProbePartitioningEnabled() const {
+    return get<bool>(kHashProbePartitioningEnabled, false);
+  }
+
+  int32_t maxSplitPreloadPerDriver() const {
+    return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
+  }
+
   bool isMatchStructByName() const {
     return get<bool>(kCastMatchStructByName, false);
   }
@@ -308,6 +408,18 @@ class QueryConfig {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  /// Returns 'is window spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool windowSpillEnabled() const {
+    return get<bool>(kWindowSpillEnabled, true);
+  }
+
+  /// Returns 'is topN spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
   // Returns a percentage of aggregation or join input batches that
   // will be forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -354,6 +466,10 @@ class QueryConfig {
     return get<double>(kSpillableReservationGrowthPct, kDefaultPct);
   }
 
+  std::string spillCompressionKind() const {
+    return get<std::string>(kSpillCompressionKind, "none");
+  }
+
   bool exprTrackCpuUsage() const {
     return get<bool>(kExprTrackCpuUsage, false);
   }
@@ -143,9 +143,16 @@ class QueryCtx : public Context {
   }
 
   void initPool(const std::string& queryId) {
-    pool_ = memory::getProcessDefaultMemoryManager().getRoot().addChild(
+    auto& memoryManager = memory::getProcessDefaultMemoryManager();
+    pool_ = memoryManager.getRoot().addChild(
         QueryCtx::generatePoolName(queryId));
-    pool_->setMemoryUsageTracker(memory::MemoryUsageTracker::create());
+    auto tracker = memory::MemoryUsageTracker::create();
+    pool_->setMemoryUsageTracker(tracker);
+    // With an arbitrator the query's memory limit grows on demand, possibly
+    // by spilling other queries.
+    if (auto* arbitrator = memoryManager.arbitrator()) {
+      arbitrator->addTracker(tracker);
+    }
   }
 
   std::shared_ptr<memory::MemoryPool> pool_;
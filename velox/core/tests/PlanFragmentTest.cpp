@@ -105,7 +105,7 @@ TEST_F(PlanFragmentTest, orderByCanSpill) {
     const std::vector<FieldAccessTypedExprPtr> sortingKeys{nullptr};
     const std::vector<SortOrder> sortingOrders{{true, true}};
     auto orderBy = std::make_shared<OrderByNode>(
-        "orderBy", sortingKeys, sortingOrders, false, valueNode_);
+        "orderBy", sortingKeys, sortingOrders, false, false, valueNode_);
 
     auto queryCtx = getSpillQueryCtx(
         testData.spillingEnabled, true, true, testData.orderByEnabled);
@@ -153,8 +153,8 @@ TEST_F(PlanFragmentTest, aggregationCanSpill) {
   } testSettings[] = {
       {AggregationNode::Step::kSingle, false, true, false, false, false},
       {AggregationNode::Step::kSingle, true, false, false, false, false},
-      {AggregationNode::Step::kSingle, true, true, true, false, false},
-      {AggregationNode::Step::kSingle, true, true, false, true, false},
+      {AggregationNode::Step::kSingle, true, true, true, false, true},
+      {AggregationNode::Step::kSingle, true, true, false, true, true},
       {AggregationNode::Step::kSingle, true, true, false, false, true},
       {AggregationNode::Step::kIntermediate, false, true, false, false, false},
       {AggregationNode::Step::kIntermediate, true, false, false, false, false},
@@ -168,8 +168,8 @@ TEST_F(PlanFragmentTest, aggregationCanSpill) {
       {AggregationNode::Step::kPartial, true, true, false, false, false},
       {AggregationNode::Step::kSingle, false, true, false, false, false},
       {AggregationNode::Step::kSingle, true, false, false, false, false},
-      {AggregationNode::Step::kSingle, true, true, true, false, false},
-      {AggregationNode::Step::kSingle, true, true, false, true, false},
+      {AggregationNode::Step::kSingle, true, true, true, false, true},
+      {AggregationNode::Step::kSingle, true, true, false, true, true},
       {AggregationNode::Step::kSingle, true, true, false, false, true}};
 
   for (const auto& testData : testSettings) {
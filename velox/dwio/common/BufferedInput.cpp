@@ -51,6 +51,21 @@ void BufferedInput::load(const LogType logType) {
 
     // Now we have all buffers and regions, load it in parallel
     input_->vread(buffers, regions, logType);
+  } else if (input_->hasReadAsync()) {
+    // Issues all the reads before waiting for any of them.
+    std::vector<folly::SemiFuture<uint64_t>> reads;
+    loadWithAction(
+        logType,
+        [this, &reads](
+            void* buf, uint64_t length, uint64_t offset, LogType type) {
+          reads.push_back(input_->readAsync(
+              {folly::Range<char*>(static_cast<char*>(buf), length)},
+              offset,
+              type));
+        });
+    for (auto& result : folly::collectAll(std::move(reads)).get()) {
+      result.throwIfFailed();
+    }
   } else {
     loadWithAction(
         logType,
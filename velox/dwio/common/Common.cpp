@@ -1,40 +0,0 @@
-/*
- * Copyright (c) Facebook, Inc. and its affiliates.
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include "velox/dwio/common/Common.h"
-
-#include <folly/Conv.h>
-
-namespace facebook::velox::dwio::common {
-
-std::string compressionKindToString(CompressionKind kind) {
-  switch (static_cast<int32_t>(kind)) {
-    case CompressionKind_NONE:
-      return "none";
-    case CompressionKind_ZLIB:
-      return "zlib";
-    case CompressionKind_SNAPPY:
-      return "snappy";
-    case CompressionKind_LZO:
-      return "lzo";
-    case CompressionKind_ZSTD:
-      return "zstd";
-    case CompressionKind_LZ4:
-      return "lz4";
-  }
-  return folly::to<std::string>("unknown - ", kind);
-}
-} // namespace facebook::velox::dwio::common
@@ -16,25 +16,19 @@
 
 #pragma once
 
-#include <string>
+#include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::dwio::common {
 
-enum CompressionKind {
-  CompressionKind_NONE = 0,
-  CompressionKind_ZLIB = 1,
-  CompressionKind_SNAPPY = 2,
-  CompressionKind_LZO = 3,
-  CompressionKind_ZSTD = 4,
-  CompressionKind_LZ4 = 5,
-  CompressionKind_MAX = INT64_MAX
-};
-
-/**
- * Get the name of the CompressionKind.
- */
-std::string compressionKindToString(CompressionKind kind);
-
-constexpr uint64_t DEFAULT_COMPRESSION_BLOCK_SIZE = 256 * 1024;
+using facebook::velox::common::CompressionKind;
+using facebook::velox::common::CompressionKind_LZ4;
+using facebook::velox::common::CompressionKind_LZO;
+using facebook::velox::common::CompressionKind_MAX;
+using facebook::velox::common::CompressionKind_NONE;
+using facebook::velox::common::CompressionKind_SNAPPY;
+using facebook::velox::common::CompressionKind_ZLIB;
+using facebook::velox::common::CompressionKind_ZSTD;
+using facebook::velox::common::compressionKindToString;
+using facebook::velox::common::DEFAULT_COMPRESSION_BLOCK_SIZE;
 
 } // namespace facebook::velox::dwio::common
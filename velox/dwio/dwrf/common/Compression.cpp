@@ -24,6 +24,7 @@
 
 #include <folly/logging/xlog.h>
 #include <lz4.h>
+#include <snappy-sinksource.h>
 #include <snappy.h>
 #include <zlib.h>
 #include <zstd.h>
@@ -110,6 +111,73 @@ ZlibCompressor::compress(const void* src, void* dest, uint64_t length) {
   return stream_.total_out;
 }
 
+class Lz4Compressor : public Compressor {
+ public:
+  // LZ4 has no compression level, the fast mode is always used.
+  Lz4Compressor() : Compressor{0} {}
+
+  uint64_t compress(const void* src, void* dest, uint64_t length) override;
+};
+
+uint64_t
+Lz4Compressor::compress(const void* src, void* dest, uint64_t length) {
+  auto ret = LZ4_compress_default(
+      reinterpret_cast<const char*>(src),
+      reinterpret_cast<char*>(dest),
+      static_cast<int32_t>(length),
+      static_cast<int32_t>(length));
+  // 0 means the output does not fit in the destination buffer, in which case
+  // the original is stored
+  return ret == 0 ? length : static_cast<uint64_t>(ret);
+}
+
+// Snappy sink writing into a fixed size buffer. Output past the end of the
+// buffer is dropped but still counted, so the caller can tell from the total
+// size that the compressed data did not fit.
+class BoundedSnappySink : public snappy::Sink {
+ public:
+  BoundedSnappySink(char* dest, size_t capacity)
+      : dest_{dest}, capacity_{capacity} {}
+
+  void Append(const char* bytes, size_t n) override {
+    if (size_ + n <= capacity_) {
+      if (bytes != dest_ + size_) {
+        std::memcpy(dest_ + size_, bytes, n);
+      }
+    }
+    size_ += n;
+  }
+
+  char* GetAppendBuffer(size_t length, char* scratch) override {
+    return size_ + length <= capacity_ ? dest_ + size_ : scratch;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  char* const dest_;
+  const size_t capacity_;
+  size_t size_{0};
+};
+
+class SnappyCompressor : public Compressor {
+ public:
+  // Snappy has no compression level.
+  SnappyCompressor() : Compressor{0} {}
+
+  uint64_t compress(const void* src, void* dest, uint64_t length) override;
+};
+
+uint64_t
+SnappyCompressor::compress(const void* src, void* dest, uint64_t length) {
+  snappy::ByteArraySource source{reinterpret_cast<const char*>(src), length};
+  BoundedSnappySink sink{reinterpret_cast<char*>(dest), length};
+  snappy::Compress(&source, &sink);
+  return std::min<uint64_t>(sink.size(), length);
+}
+
 class ZlibDecompressor : public Decompressor {
  public:
   explicit ZlibDecompressor(
@@ -463,9 +531,15 @@ std::unique_ptr<BufferedOutputStream> createCompressor(
           zstdCompressionLevel);
       break;
     }
+    case dwio::common::CompressionKind_LZ4:
+      compressor = std::make_unique<Lz4Compressor>();
+      XLOG_FIRST_N(INFO, 1) << "Initialized lz4 compressor";
+      break;
     case dwio::common::CompressionKind_SNAPPY:
+      compressor = std::make_unique<SnappyCompressor>();
+      XLOG_FIRST_N(INFO, 1) << "Initialized snappy compressor";
+      break;
     case dwio::common::CompressionKind_LZO:
-    case dwio::common::CompressionKind_LZ4:
     default:
       DWIO_RAISE("compression codec");
   }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+#include "velox/dwio/common/DataSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/type/Type.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+constexpr vector_size_t kVectorSize = 10000;
+constexpr int32_t kNumBatches = 100;
+
+// Writes kNumBatches batches of bigint, double and varchar columns into an
+// in-memory file compressed with 'kind'. The data is repetitive enough for
+// all codecs to compress it.
+void runBenchmark(CompressionKind kind) {
+  folly::BenchmarkSuspender braces;
+
+  auto pool = memory::getDefaultMemoryPool();
+  auto type = ROW({"id", "price", "name"}, {BIGINT(), DOUBLE(), VARCHAR()});
+
+  BufferPtr ids = AlignedBuffer::allocate<int64_t>(kVectorSize, pool.get());
+  BufferPtr prices = AlignedBuffer::allocate<double>(kVectorSize, pool.get());
+  BufferPtr names =
+      AlignedBuffer::allocate<StringView>(kVectorSize, pool.get());
+  auto* rawIds = ids->asMutable<int64_t>();
+  auto* rawPrices = prices->asMutable<double>();
+  auto* rawNames = names->asMutable<StringView>();
+  std::vector<std::string> strings;
+  strings.reserve(kVectorSize);
+  for (auto i = 0; i < kVectorSize; ++i) {
+    rawIds[i] = i * 7;
+    rawPrices[i] = (i % 1000) * 0.25;
+    strings.push_back(fmt::format("product_name_{}", i % 500));
+    rawNames[i] = StringView(strings.back());
+  }
+
+  auto batch = std::make_shared<RowVector>(
+      pool.get(),
+      type,
+      nullptr,
+      kVectorSize,
+      std::vector<VectorPtr>{
+          std::make_shared<FlatVector<int64_t>>(
+              pool.get(), nullptr, kVectorSize, ids, std::vector<BufferPtr>{}),
+          std::make_shared<FlatVector<double>>(
+              pool.get(),
+              nullptr,
+              kVectorSize,
+              prices,
+              std::vector<BufferPtr>{}),
+          std::make_shared<FlatVector<StringView>>(
+              pool.get(),
+              nullptr,
+              kVectorSize,
+              names,
+              std::vector<BufferPtr>{})});
+
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, kind);
+  WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  auto sink = std::make_unique<MemorySink>(*pool, 200 * 1024 * 1024);
+  Writer writer{options, std::move(sink), *pool};
+
+  braces.dismiss();
+
+  for (auto i = 0; i < kNumBatches; ++i) {
+    writer.write(batch);
+  }
+  writer.close();
+}
+
+BENCHMARK(CompressionWriterBenchmarkNone) {
+  runBenchmark(CompressionKind_NONE);
+}
+
+BENCHMARK_RELATIVE(CompressionWriterBenchmarkZlib) {
+  runBenchmark(CompressionKind_ZLIB);
+}
+
+BENCHMARK_RELATIVE(CompressionWriterBenchmarkZstd) {
+  runBenchmark(CompressionKind_ZSTD);
+}
+
+BENCHMARK_RELATIVE(CompressionWriterBenchmarkLz4) {
+  runBenchmark(CompressionKind_LZ4);
+}
+
+BENCHMARK_RELATIVE(CompressionWriterBenchmarkSnappy) {
+  runBenchmark(CompressionKind_SNAPPY);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/encryption/TestProvider.h"
@@ -577,6 +578,73 @@ TEST(E2EWriterTests, FlatMapConfigNotMapColumn) {
       { testFlatMapConfig(type, {0}, {}); }, exception::LoggedException);
 }
 
+TEST(E2EWriterTests, ParallelColumnWriters) {
+  const size_t batchCount = 4;
+  const size_t size = 1100;
+  auto pool = memory::getDefaultMemoryPool();
+
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "timestamp_val:timestamp,"
+      "array_val:array<float>,"
+      "map_val:map<bigint,double>," /* this is column 7 */
+      "struct_val:struct<a:float,b:string>"
+      ">");
+
+  auto config = std::make_shared<Config>();
+  config->set(Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  config->set(Config::FLATTEN_MAP, true);
+  config->set(Config::MAP_FLAT_COLS, {7});
+  // Small compression blocks make the columns compress concurrently while
+  // they are written, not only at flush.
+  config->set(Config::COMPRESSION_BLOCK_SIZE, static_cast<uint64_t>(1024));
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < batchCount; ++i) {
+    batches.push_back(BatchMaker::createBatch(type, size, *pool, nullptr, i));
+  }
+
+  auto sink = std::make_unique<MemorySink>(*pool, 200 * 1024 * 1024);
+  auto sinkPtr = sink.get();
+  WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  options.executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  Writer writer{options, std::move(sink), *pool};
+  for (auto& batch : batches) {
+    writer.write(batch);
+  }
+  writer.close();
+
+  ReaderOptions readerOpts;
+  RowReaderOptions rowReaderOpts;
+  auto reader = createReader(*sinkPtr, readerOpts);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  size_t batchIndex = 0;
+  vector_size_t rowIndex = 0;
+  VectorPtr result;
+  while (rowReader->next(1000, result)) {
+    for (vector_size_t i = 0; i < result->size(); ++i) {
+      ASSERT_TRUE(batches[batchIndex]->equalValueAt(result.get(), rowIndex, i))
+          << "Content mismatch at batch " << batchIndex << " at index "
+          << rowIndex
+          << " Reference: " << batches[batchIndex]->toString(rowIndex)
+          << " read: " << result->toString(i);
+      if (++rowIndex == batches[batchIndex]->size()) {
+        rowIndex = 0;
+        ++batchIndex;
+      }
+    }
+  }
+  ASSERT_EQ(batchIndex, batches.size());
+}
+
 TEST(E2EWriterTests, PartialStride) {
   HiveTypeParser parser;
   auto type = parser.parse("struct<bool_val:int>");
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "folly/init/Init.h"
+#include "velox/dwio/common/DataSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/type/Type.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+constexpr vector_size_t kVectorSize = 10000;
+constexpr int32_t kNumBatches = 50;
+constexpr int32_t kNumColumns = 24;
+
+// Writes kNumBatches batches of a table with kNumColumns bigint, double and
+// varchar columns into an in-memory file compressed with zstd. The top level
+// columns are written on 'numThreads' threads, or on the calling thread if
+// 'numThreads' is 0.
+void runBenchmark(int32_t numThreads) {
+  folly::BenchmarkSuspender braces;
+
+  auto pool = memory::getDefaultMemoryPool();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> children;
+  std::vector<std::string> strings;
+  strings.reserve(kVectorSize);
+  for (auto i = 0; i < kVectorSize; ++i) {
+    strings.push_back(fmt::format("product_name_{}", i % 500));
+  }
+  for (auto column = 0; column < kNumColumns; ++column) {
+    names.push_back(fmt::format("c{}", column));
+    switch (column % 3) {
+      case 0: {
+        BufferPtr values =
+            AlignedBuffer::allocate<int64_t>(kVectorSize, pool.get());
+        auto* rawValues = values->asMutable<int64_t>();
+        for (auto i = 0; i < kVectorSize; ++i) {
+          rawValues[i] = i * (column + 7);
+        }
+        types.push_back(BIGINT());
+        children.push_back(std::make_shared<FlatVector<int64_t>>(
+            pool.get(),
+            nullptr,
+            kVectorSize,
+            values,
+            std::vector<BufferPtr>{}));
+        break;
+      }
+      case 1: {
+        BufferPtr values =
+            AlignedBuffer::allocate<double>(kVectorSize, pool.get());
+        auto* rawValues = values->asMutable<double>();
+        for (auto i = 0; i < kVectorSize; ++i) {
+          rawValues[i] = ((i + column) % 1000) * 0.25;
+        }
+        types.push_back(DOUBLE());
+        children.push_back(std::make_shared<FlatVector<double>>(
+            pool.get(),
+            nullptr,
+            kVectorSize,
+            values,
+            std::vector<BufferPtr>{}));
+        break;
+      }
+      default: {
+        BufferPtr values =
+            AlignedBuffer::allocate<StringView>(kVectorSize, pool.get());
+        auto* rawValues = values->asMutable<StringView>();
+        for (auto i = 0; i < kVectorSize; ++i) {
+          rawValues[i] = StringView(strings[(i + column) % kVectorSize]);
+        }
+        types.push_back(VARCHAR());
+        children.push_back(std::make_shared<FlatVector<StringView>>(
+            pool.get(),
+            nullptr,
+            kVectorSize,
+            values,
+            std::vector<BufferPtr>{}));
+        break;
+      }
+    }
+  }
+  auto type = ROW(std::move(names), std::move(types));
+  auto batch = std::make_shared<RowVector>(
+      pool.get(), type, nullptr, kVectorSize, std::move(children));
+
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, CompressionKind_ZSTD);
+  WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  if (numThreads > 0) {
+    options.executor =
+        std::make_shared<folly::CPUThreadPoolExecutor>(numThreads);
+  }
+  auto sink = std::make_unique<MemorySink>(*pool, 400 * 1024 * 1024);
+  Writer writer{options, std::move(sink), *pool};
+
+  braces.dismiss();
+
+  for (auto i = 0; i < kNumBatches; ++i) {
+    writer.write(batch);
+  }
+  writer.close();
+}
+
+BENCHMARK(ParallelWriterBenchmarkSerial) {
+  runBenchmark(0);
+}
+
+BENCHMARK_RELATIVE(ParallelWriterBenchmark2Threads) {
+  runBenchmark(2);
+}
+
+BENCHMARK_RELATIVE(ParallelWriterBenchmark4Threads) {
+  runBenchmark(4);
+}
+
+BENCHMARK_RELATIVE(ParallelWriterBenchmark8Threads) {
+  runBenchmark(8);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -286,6 +286,10 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(CompressionKind_ZLIB, &testEncrypter, &testDecrypter),
         std::make_tuple(CompressionKind_ZSTD, nullptr, nullptr),
         std::make_tuple(CompressionKind_ZSTD, &testEncrypter, &testDecrypter),
+        std::make_tuple(CompressionKind_LZ4, nullptr, nullptr),
+        std::make_tuple(CompressionKind_LZ4, &testEncrypter, &testDecrypter),
+        std::make_tuple(CompressionKind_SNAPPY, nullptr, nullptr),
+        std::make_tuple(CompressionKind_SNAPPY, &testEncrypter, &testDecrypter),
         std::make_tuple(CompressionKind_NONE, nullptr, nullptr),
         std::make_tuple(CompressionKind_NONE, &testEncrypter, &testDecrypter)));
 
@@ -381,4 +385,6 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(CompressionKind_ZLIB, &testEncrypter),
         std::make_tuple(CompressionKind_ZSTD, nullptr),
         std::make_tuple(CompressionKind_ZSTD, &testEncrypter),
+        std::make_tuple(CompressionKind_LZ4, nullptr),
+        std::make_tuple(CompressionKind_SNAPPY, nullptr),
         std::make_tuple(CompressionKind_NONE, &testEncrypter)));
@@ -16,6 +16,9 @@
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
+#include <deque>
+#include <optional>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
@@ -35,7 +38,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localSelected = context_.getLocalSelectivityVector(slice->size());
+  auto& selected = localSelected.get();
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1586,28 +1590,99 @@ class StructColumnWriter : public BaseColumnWriter {
 
   void flush(
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
-      std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
-    BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
-    }
-  }
+      std::function<void(proto::ColumnEncoding&)> encodingOverride) override;
 
  private:
+  // True if the children write and flush in parallel on the context executor.
+  // Only the children of the root do since each top level column writes a
+  // disjoint set of streams.
+  bool isParallel() const {
+    return isRoot() && context_.getExecutor() && children_.size() > 1;
+  }
+
+  // Calls 'func' with the index of each child, in parallel if isParallel().
+  void forEachChild(const std::function<void(size_t)>& func);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::forEachChild(
+    const std::function<void(size_t)>& func) {
+  if (!isParallel()) {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      func(i);
+    }
+    return;
+  }
+  auto* executor = context_.getExecutor();
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  steps.reserve(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    steps.push_back(std::make_shared<AsyncSource<bool>>([&func, i]() {
+      func(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([step = steps.back()]() { step->prepare(); });
+  }
+  // All steps must be synced also in case of error because they reference the
+  // children and the input.
+  std::exception_ptr error;
+  for (auto& step : steps) {
+    try {
+      step->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void StructColumnWriter::flush(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
+    std::function<void(proto::ColumnEncoding&)> encodingOverride) {
+  BaseColumnWriter::flush(encodingFactory, encodingOverride);
+  if (!isParallel()) {
+    for (auto& c : children_) {
+      c->flush(encodingFactory);
+    }
+    return;
+  }
+  // The encodings are added to the stripe footer in column order, so each
+  // child collects its own and they are added once all children are flushed.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      encodings(children_.size());
+  forEachChild([&](size_t i) {
+    children_[i]->flush(
+        [&childEncodings = encodings[i]](
+            uint32_t nodeId) -> proto::ColumnEncoding& {
+          return childEncodings.emplace_back(nodeId, proto::ColumnEncoding{})
+              .second;
+        });
+  });
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId).Swap(&encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    std::vector<uint64_t> childRawSizes(children_.size());
+    forEachChild([&](size_t i) {
+      childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    });
+    for (auto childRawSize : childRawSizes) {
+      rawSize += childRawSize;
     }
   }
   if (nullCount) {
@@ -120,6 +120,8 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  // Optional executor to write and flush the top level columns in parallel.
+  std::shared_ptr<folly::Executor> executor;
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
@@ -141,7 +143,11 @@ class Writer : public WriterBase {
                                       *options.encryptionSpec,
                                       options.encrypterFactory.get())
                                 : nullptr);
-    initContext(options.config, std::move(pool), std::move(handler));
+    initContext(
+        options.config,
+        std::move(pool),
+        std::move(handler),
+        options.executor);
     if (!options.flushPolicyFactory) {
       auto& context = getContext();
       flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
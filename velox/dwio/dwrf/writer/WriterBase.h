@@ -72,9 +72,14 @@ class WriterBase {
   void initContext(
       const std::shared_ptr<const Config>& config,
       std::shared_ptr<velox::memory::MemoryPool> pool,
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr) {
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      std::shared_ptr<folly::Executor> executor = nullptr) {
     context_ = std::make_unique<WriterContext>(
-        config, std::move(pool), sink_->getMetricsLog(), std::move(handler));
+        config,
+        std::move(pool),
+        sink_->getMetricsLog(),
+        std::move(handler),
+        std::move(executor));
     writerSink_ = std::make_unique<WriterSink>(
         *sink_,
         context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
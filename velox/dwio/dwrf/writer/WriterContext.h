@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Compression.h"
@@ -37,13 +39,15 @@ class WriterContext : public CompressionBufferPool {
       std::shared_ptr<memory::MemoryPool> pool,
       const dwio::common::MetricsLogPtr& metricLogger =
           dwio::common::MetricsLog::voidLog(),
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr)
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      std::shared_ptr<folly::Executor> executor = nullptr)
       : config_{config},
         pool_{std::move(pool)},
         dictionaryPool_{pool_->addChild(".dictionary")},
         outputStreamPool_{pool_->addChild(".compression")},
         generalPool_{pool_->addChild(".general")},
         handler_{std::move(handler)},
+        executor_{std::move(executor)},
         compression{getConfig(Config::COMPRESSION)},
         compressionBlockSize{getConfig(Config::COMPRESSION_BLOCK_SIZE)},
         isIndexEnabled{getConfig(Config::CREATE_INDEX)},
@@ -75,8 +79,9 @@ class WriterContext : public CompressionBufferPool {
       outputStreamPool_->setMemoryUsageTracker(tracker->addChild());
       generalPool_->setMemoryUsageTracker(tracker->addChild());
     }
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        *generalPool_, compressionBlockSize + PAGE_HEADER_SIZE);
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize + PAGE_HEADER_SIZE));
   }
 
   bool hasStream(const DwrfStreamIdentifier& stream) const {
@@ -103,6 +108,7 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamMutex_);
     DWIO_ENSURE(
         !hasStream(stream), "Stream already exists ", stream.toString());
     streams_.emplace(
@@ -143,6 +149,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& ek,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(dictEncoderMutex_);
     auto result = dictEncoders_.find(ek);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -174,6 +181,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamMutex_);
     DWIO_ENSURE(hasStream(stream));
     auto& collector = streams_.at(stream);
     collector.suppress();
@@ -301,18 +309,31 @@ class WriterContext : public CompressionBufferPool {
     }
   }
 
+  // Returns a compression buffer. A single buffer is reused when streams are
+  // written serially. When column writers run in parallel on 'executor_',
+  // each concurrent compression gets its own buffer, allocated from the
+  // general pool so that the extra memory is accounted for.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    DWIO_ENSURE_NOT_NULL(compressionBuffer_);
-    DWIO_ENSURE_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
+    const auto bufferSize = compressionBlockSize + PAGE_HEADER_SIZE;
+    DWIO_ENSURE_GE(bufferSize, size);
+    {
+      std::lock_guard<std::mutex> l(compressionBufferMutex_);
+      if (!compressionBuffers_.empty()) {
+        auto buffer = std::move(compressionBuffers_.back());
+        compressionBuffers_.pop_back();
+        return buffer;
+      }
+    }
+    return std::make_unique<dwio::common::DataBuffer<char>>(
+        *generalPool_, bufferSize);
   }
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     DWIO_ENSURE_NOT_NULL(buffer);
-    DWIO_ENSURE(!compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    compressionBuffers_.push_back(std::move(buffer));
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -392,6 +413,12 @@ class WriterContext : public CompressionBufferPool {
     return lowMemoryMode_;
   }
 
+  // Returns the executor on which the writers of top level columns run in
+  // parallel, or nullptr if they run on the calling thread.
+  folly::Executor* getExecutor() const {
+    return executor_.get();
+  }
+
   class LocalDecodedVector {
    public:
     explicit LocalDecodedVector(WriterContext& context)
@@ -421,19 +448,42 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (UNLIKELY(!selectivityVector_)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
+  class LocalSelectivityVector {
+   public:
+    LocalSelectivityVector(WriterContext& context, velox::vector_size_t size)
+        : context_(context), vector_(context_.getSelectivityVector(size)) {}
+
+    LocalSelectivityVector(LocalSelectivityVector&& other) noexcept
+        : context_{other.context_}, vector_{std::move(other.vector_)} {}
+
+    LocalSelectivityVector& operator=(LocalSelectivityVector&& other) = delete;
+
+    ~LocalSelectivityVector() {
+      if (vector_) {
+        context_.releaseSelectivityVector(std::move(vector_));
+      }
+    }
+
+    SelectivityVector& get() {
+      return *vector_;
     }
-    return *selectivityVector_;
+
+   private:
+    WriterContext& context_;
+    std::unique_ptr<velox::SelectivityVector> vector_;
+  };
+
+  // Returns a reusable SelectivityVector of 'size'. Column writers that decode
+  // in parallel on 'executor_' get different vectors.
+  LocalSelectivityVector getLocalSelectivityVector(velox::vector_size_t size) {
+    return LocalSelectivityVector{*this, size};
   }
 
  private:
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -443,9 +493,33 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector(
+      velox::vector_size_t size) {
+    std::unique_ptr<velox::SelectivityVector> vector;
+    {
+      std::lock_guard<std::mutex> l(selectivityVectorMutex_);
+      if (!selectivityVectorPool_.empty()) {
+        vector = std::move(selectivityVectorPool_.back());
+        selectivityVectorPool_.pop_back();
+      }
+    }
+    if (UNLIKELY(!vector)) {
+      return std::make_unique<velox::SelectivityVector>(size);
+    }
+    vector->resize(size);
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(selectivityVectorMutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   std::shared_ptr<const Config> config_;
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -466,13 +540,23 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // The mutexes below guard the state shared by column writers, which may run
+  // in parallel on 'executor_'.
+  std::mutex streamMutex_;
+  std::mutex dictEncoderMutex_;
+  std::mutex compressionBufferMutex_;
+  std::mutex decodedVectorMutex_;
+  std::mutex selectivityVectorMutex_;
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors. Holds one vector per column writer
+  // that decodes at the same time.
+  std::vector<std::unique_ptr<velox::SelectivityVector>> selectivityVectorPool_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
+  std::shared_ptr<folly::Executor> executor_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize;
   CompressionRatioTracker compressionRatioTracker_;
   FlushOverheadRatioTracker flushOverheadRatioTracker_;
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+#include <folly/Varint.h>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the Parquet DELTA_BINARY_PACKED encoding. The encoded
+/// run starts with a header of <block size> <miniblocks per block>
+/// <total value count> <first value>, followed by blocks of <min
+/// delta> <miniblock bit widths> <bit packed miniblocks>. Decodes a
+/// whole run at a time. Miniblocks of up to 32 bits are unpacked with
+/// the vectorized dwio::common::unpack().
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end)
+      : bufferStart_(start), bufferEnd_(end) {
+    blockSize_ = readVarint();
+    miniBlocksPerBlock_ = readVarint();
+    VELOX_CHECK_GT(miniBlocksPerBlock_, 0);
+    VELOX_CHECK_EQ(
+        blockSize_ % miniBlocksPerBlock_,
+        0,
+        "Block size must be a multiple of miniblocks per block");
+    valuesPerMiniBlock_ = blockSize_ / miniBlocksPerBlock_;
+    VELOX_CHECK(
+        valuesPerMiniBlock_ > 0 && valuesPerMiniBlock_ % 8 == 0,
+        "Values per miniblock must be a positive multiple of 8");
+    numValues_ = readVarint();
+    firstValue_ = readZigZag();
+  }
+
+  /// Returns the number of values in the encoded run.
+  int64_t numValues() const {
+    return numValues_;
+  }
+
+  /// Decodes all values into 'result', which must have space for
+  /// numValues() elements. T is int32_t or int64_t. The arithmetic
+  /// wraps around at the width of T like in the writer.
+  template <typename T>
+  void readValues(T* FOLLY_NONNULL result) {
+    if (numValues_ == 0) {
+      return;
+    }
+    uint64_t value = firstValue_;
+    result[0] = static_cast<T>(value);
+    int64_t numRead = 1;
+    while (numRead < numValues_) {
+      const uint64_t minDelta = readZigZag();
+      VELOX_CHECK_LE(
+          miniBlocksPerBlock_,
+          bufferEnd_ - bufferStart_,
+          "Truncated DELTA_BINARY_PACKED block");
+      auto bitWidths = reinterpret_cast<const uint8_t*>(bufferStart_);
+      bufferStart_ += miniBlocksPerBlock_;
+      for (auto i = 0; i < miniBlocksPerBlock_ && numRead < numValues_; ++i) {
+        auto numInMiniBlock =
+            std::min<int64_t>(valuesPerMiniBlock_, numValues_ - numRead);
+        readMiniBlock(
+            bitWidths[i], numInMiniBlock, minDelta, value, result + numRead);
+        numRead += numInMiniBlock;
+      }
+    }
+  }
+
+  /// Returns the first byte after the encoded run. Valid after
+  /// readValues(). Used for encodings that append data after a delta
+  /// encoded run, e.g. DELTA_LENGTH_BYTE_ARRAY.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+ private:
+  uint64_t readVarint() {
+    auto maxVarIntLen = std::min<uint64_t>(
+        (uint64_t)folly::kMaxVarintLength64, bufferEnd_ - bufferStart_);
+    folly::ByteRange range(
+        reinterpret_cast<const unsigned char*>(bufferStart_),
+        reinterpret_cast<const unsigned char*>(bufferStart_ + maxVarIntLen));
+    auto result = folly::decodeVarint(range);
+    bufferStart_ = reinterpret_cast<const char*>(range.begin());
+    return result;
+  }
+
+  int64_t readZigZag() {
+    return folly::decodeZigZag(readVarint());
+  }
+
+  // Decodes 'numValues' deltas of 'bitWidth' bits, each added to
+  // 'minDelta', and writes the running sum starting at 'value' to
+  // 'result'. The miniblock occupies 'bitWidth' * 'valuesPerMiniBlock_'
+  // bits even when not all of its values are used.
+  template <typename T>
+  void readMiniBlock(
+      uint8_t bitWidth,
+      int64_t numValues,
+      uint64_t minDelta,
+      uint64_t& value,
+      T* FOLLY_NONNULL result) {
+    VELOX_CHECK_LE(bitWidth, 64);
+    if (bitWidth == 0) {
+      for (auto i = 0; i < numValues; ++i) {
+        value += minDelta;
+        result[i] = static_cast<T>(value);
+      }
+      return;
+    }
+    auto available = bufferEnd_ - bufferStart_;
+    VELOX_CHECK_LE(
+        bits::roundUp(numValues * bitWidth, 8) / 8,
+        available,
+        "Truncated DELTA_BINARY_PACKED miniblock");
+    auto input = reinterpret_cast<const uint8_t*>(bufferStart_);
+    int64_t miniBlockBytes =
+        static_cast<int64_t>(bitWidth) * valuesPerMiniBlock_ / 8;
+    auto numToUnpack = bits::roundUp(numValues, 8);
+    if (bitWidth <= 32 && numToUnpack * bitWidth / 8 <= available) {
+      deltas_.resize(valuesPerMiniBlock_);
+      auto output = deltas_.data();
+      dwio::common::unpack<uint32_t>(
+          input, available, numToUnpack, bitWidth, output);
+      for (auto i = 0; i < numValues; ++i) {
+        value += minDelta + deltas_[i];
+        result[i] = static_cast<T>(value);
+      }
+    } else {
+      // Deltas wider than 32 bits or a last miniblock without padding.
+      for (auto i = 0; i < numValues; ++i) {
+        value += minDelta + extractBits(input, i * bitWidth, bitWidth);
+        result[i] = static_cast<T>(value);
+      }
+    }
+    bufferStart_ += std::min<int64_t>(miniBlockBytes, available);
+  }
+
+  // Returns the 'bitWidth' bits starting at bit 'bitOffset' of
+  // 'data'. Does not access bytes past the last bit of the field.
+  static uint64_t extractBits(
+      const uint8_t* FOLLY_NONNULL data,
+      uint64_t bitOffset,
+      int32_t bitWidth) {
+    uint64_t result = 0;
+    int32_t numExtracted = 0;
+    while (numExtracted < bitWidth) {
+      auto bit = bitOffset & 7;
+      auto numBits = std::min<int32_t>(8 - bit, bitWidth - numExtracted);
+      uint64_t byteBits = (data[bitOffset / 8] >> bit) & ((1 << numBits) - 1);
+      result |= byteBits << numExtracted;
+      numExtracted += numBits;
+      bitOffset += numBits;
+    }
+    return result;
+  }
+
+  const char* FOLLY_NONNULL bufferStart_;
+  const char* FOLLY_NONNULL const bufferEnd_;
+  int64_t blockSize_;
+  int64_t miniBlocksPerBlock_;
+  int64_t valuesPerMiniBlock_;
+  int64_t numValues_;
+  int64_t firstValue_;
+
+  // Unpacked deltas of the current miniblock.
+  raw_vector<uint32_t> deltas_;
+};
+
+} // namespace facebook::velox::parquet
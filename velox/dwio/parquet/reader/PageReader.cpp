@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
@@ -547,6 +548,29 @@ int32_t parquetTypeBytes(thrift::Type::type type) {
       VELOX_FAIL("Type does not have a byte width {}", type);
   }
 }
+
+// Interleaves the 'width' byte streams of a BYTE_STREAM_SPLIT page. Byte 'b'
+// of value 'i' is at 'i' in stream 'b'. Each value is gathered from its lane
+// in all streams and stored whole, so that the output is written
+// sequentially and the streams are read sequentially in parallel. A
+// 'kWidth' of 0 means the width is only known at runtime.
+template <int32_t kWidth>
+void gatherByteStreams(
+    const char* input,
+    int64_t numValues,
+    int32_t width,
+    char* output) {
+  if constexpr (kWidth != 0) {
+    width = kWidth;
+  }
+  for (int64_t i = 0; i < numValues; ++i) {
+    const char* lane = input + i;
+    for (auto stream = 0; stream < width; ++stream) {
+      output[stream] = lane[stream * numValues];
+    }
+    output += width;
+  }
+}
 } // namespace
 
 void PageReader::preloadRepDefs() {
@@ -661,7 +685,6 @@ int32_t PageReader::getLengthsAndNulls(
 }
 
 void PageReader::makeDecoder() {
-  auto parquetType = type_->parquetType_.value();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -669,32 +692,163 @@ void PageReader::makeDecoder() {
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              type_->typeLength_,
-              true);
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
+      makePlainDecoder();
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      decodeDeltaBinaryPacked();
+      makePlainDecoder();
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      decodeDeltaByteArray();
+      makePlainDecoder();
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      decodeByteStreamSplit();
+      makePlainDecoder();
+      break;
+    default:
+      VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
+  }
+}
+
+void PageReader::makePlainDecoder() {
+  auto parquetType = type_->parquetType_.value();
+  switch (parquetType) {
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              pageData_, encodedDataSize_),
+          false,
+          type_->typeLength_,
+          true);
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              pageData_, encodedDataSize_),
+          false,
+          parquetTypeBytes(parquetType));
+    }
+  }
+}
+
+void PageReader::decodeDeltaBinaryPacked() {
+  auto parquetType = type_->parquetType_.value();
+  VELOX_CHECK(
+      parquetType == thrift::Type::INT32 || parquetType == thrift::Type::INT64,
+      "DELTA_BINARY_PACKED is only defined for INT32 and INT64");
+  DeltaBpDecoder decoder(pageData_, pageData_ + encodedDataSize_);
+  auto numValues = decoder.numValues();
+  auto numBytes = numValues * parquetTypeBytes(parquetType);
+  dwio::common::ensureCapacity<char>(decodedPage_, numBytes, &pool_);
+  if (parquetType == thrift::Type::INT32) {
+    decoder.readValues(decodedPage_->asMutable<int32_t>());
+  } else {
+    decoder.readValues(decodedPage_->asMutable<int64_t>());
+  }
+  pageData_ = decodedPage_->as<char>();
+  encodedDataSize_ = numBytes;
+}
+
+void PageReader::decodeDeltaByteArray() {
+  auto parquetType = type_->parquetType_.value();
+  VELOX_CHECK(
+      parquetType == thrift::Type::BYTE_ARRAY ||
+          parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY,
+      "{} is only defined for BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY",
+      encoding_);
+  auto data = pageData_;
+  auto end = pageData_ + encodedDataSize_;
+
+  // DELTA_BYTE_ARRAY is a run of delta encoded prefix lengths followed by the
+  // suffixes in DELTA_LENGTH_BYTE_ARRAY. Each value is the prefix of the
+  // previous value followed by its suffix.
+  int64_t numValues = 0;
+  raw_vector<int32_t> prefixLengths;
+  if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    DeltaBpDecoder prefixDecoder(data, end);
+    numValues = prefixDecoder.numValues();
+    prefixLengths.resize(numValues);
+    prefixDecoder.readValues(prefixLengths.data());
+    data = prefixDecoder.bufferStart();
+  }
+  DeltaBpDecoder lengthDecoder(data, end);
+  if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    VELOX_CHECK_EQ(numValues, lengthDecoder.numValues());
+  }
+  numValues = lengthDecoder.numValues();
+  raw_vector<int32_t> lengths(numValues);
+  lengthDecoder.readValues(lengths.data());
+  data = lengthDecoder.bufferStart();
+
+  // The values are laid out like PLAIN, i.e. each BYTE_ARRAY prefixed with its
+  // 4 byte length. The padding allows StringDecoder to use wide loads.
+  const bool hasLength = parquetType == thrift::Type::BYTE_ARRAY;
+  int64_t numBytes = 0;
+  int64_t numSuffixBytes = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    VELOX_CHECK_GE(lengths[i], 0);
+    numSuffixBytes += lengths[i];
+    numBytes += lengths[i] + (hasLength ? sizeof(int32_t) : 0) +
+        (prefixLengths.empty() ? 0 : prefixLengths[i]);
+  }
+  VELOX_CHECK_LE(numSuffixBytes, end - data, "Truncated {} page", encoding_);
+  dwio::common::ensureCapacity<char>(
+      decodedPage_, numBytes + simd::kPadding, &pool_);
+  auto output = decodedPage_->asMutable<char>();
+  const char* previous = nullptr;
+  int32_t previousLength = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    int32_t prefixLength = prefixLengths.empty() ? 0 : prefixLengths[i];
+    VELOX_CHECK(
+        prefixLength >= 0 && prefixLength <= previousLength,
+        "Bad prefix length {} in DELTA_BYTE_ARRAY",
+        prefixLength);
+    int32_t length = prefixLength + lengths[i];
+    if (hasLength) {
+      *reinterpret_cast<int32_t*>(output) = length;
+      output += sizeof(int32_t);
+    }
+    if (prefixLength) {
+      memcpy(output, previous, prefixLength);
+    }
+    memcpy(output + prefixLength, data, lengths[i]);
+    data += lengths[i];
+    previous = output;
+    previousLength = length;
+    output += length;
+  }
+  pageData_ = decodedPage_->as<char>();
+  encodedDataSize_ = numBytes;
+}
+
+void PageReader::decodeByteStreamSplit() {
+  auto parquetType = type_->parquetType_.value();
+  const int32_t width = parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY
+      ? type_->typeLength_
+      : parquetTypeBytes(parquetType);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % width, 0, "Bad BYTE_STREAM_SPLIT page size");
+  auto numValues = encodedDataSize_ / width;
+  dwio::common::ensureCapacity<char>(decodedPage_, encodedDataSize_, &pool_);
+  auto output = decodedPage_->asMutable<char>();
+
+  switch (width) {
+    case 4:
+      gatherByteStreams<4>(pageData_, numValues, width, output);
+      break;
+    case 8:
+      gatherByteStreams<8>(pageData_, numValues, width, output);
+      break;
     default:
-      VELOX_UNSUPPORTED("Encoding not supported yet");
+      gatherByteStreams<0>(pageData_, numValues, width, output);
   }
+  pageData_ = decodedPage_->as<char>();
 }
 
 void PageReader::skip(int64_t numRows) {
@@ -29,7 +29,9 @@ namespace facebook::velox::parquet {
 
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
-/// continuous stream accessible via readWithVisitor().
+/// continuous stream accessible via readWithVisitor(). If 'stream' starts at a
+/// data page after the first, 'firstRow' is the row number of that page in the
+/// ColumnChunk and rows before it must not be accessed.
 class PageReader {
  public:
   PageReader(
@@ -37,7 +39,8 @@ class PageReader {
       memory::MemoryPool& pool,
       ParquetTypeWithIdPtr nodeType,
       thrift::CompressionCodec::type codec,
-      int64_t chunkSize)
+      int64_t chunkSize,
+      int64_t firstRow = 0)
       : pool_(pool),
         inputStream_(std::move(stream)),
         type_(std::move(nodeType)),
@@ -46,6 +49,7 @@ class PageReader {
         isTopLevel_(maxRepeat_ == 0 && maxDefine_ <= 1),
         codec_(codec),
         chunkSize_(chunkSize),
+        rowOfPage_(firstRow),
         nullConcatenation_(pool_) {
     type_->makeLevelInfo(leafInfo_);
   }
@@ -170,6 +174,17 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Makes a PLAIN decoder for 'encodedDataSize_' bytes at 'pageData_'.
+  void makePlainDecoder();
+
+  // Decode the encodings that have no decoder of their own into
+  // 'decodedPage_' in PLAIN layout and point 'pageData_' and
+  // 'encodedDataSize_' to the result. The PLAIN decoders then apply
+  // filters and visitors as for PLAIN pages.
+  void decodeDeltaBinaryPacked();
+  void decodeDeltaByteArray();
+  void decodeByteStreamSplit();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -373,6 +388,10 @@ class PageReader {
   // Uncompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr uncompressedData_;
 
+  // Values of a DELTA_BINARY_PACKED, DELTA_LENGTH_BYTE_ARRAY,
+  // DELTA_BYTE_ARRAY or BYTE_STREAM_SPLIT page decoded to PLAIN layout.
+  BufferPtr decodedPage_;
+
   // First byte of uncompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -436,7 +455,6 @@ class PageReader {
   std::unique_ptr<dwio::common::DirectDecoder<true>> directDecoder_;
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
-  // Add decoders for other encodings here.
 };
 
 template <typename Visitor>
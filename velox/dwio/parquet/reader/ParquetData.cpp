@@ -15,16 +15,66 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
+namespace {
+// Returns a copy of 'length' bytes at 'offset'.
+std::vector<char> readBuffer(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length) {
+  auto stream = input.read(offset, length, dwio::common::LogType::FOOTER);
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), copy.data(), bufferStart, bufferEnd);
+  return copy;
+}
+
+// Deserializes the Thrift struct at the start of 'buffer'. Returns its
+// size.
+template <typename T>
+uint32_t deserializeThrift(const std::vector<char>& buffer, T& result) {
+  auto thriftTransport = std::make_shared<thrift::ThriftBufferedTransport>(
+      buffer.data(), buffer.size());
+  auto thriftProtocol =
+      std::make_unique<apache::thrift::protocol::TCompactProtocolT<
+          thrift::ThriftBufferedTransport>>(thriftTransport);
+  return result.read(thriftProtocol.get());
+}
+
+// Reads and deserializes the Thrift struct of 'length' bytes at 'offset'.
+template <typename T>
+void readThrift(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length,
+    T& result) {
+  deserializeThrift(readBuffer(input, offset, length), result);
+}
+
+// Returns the first offset of 'chunk', which is the dictionary page if any.
+uint64_t chunkReadOffset(const thrift::ColumnMetaData& metaData) {
+  if (metaData.__isset.dictionary_page_offset &&
+      metaData.dictionary_page_offset >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    return metaData.dictionary_page_offset;
+  }
+  return metaData.data_page_offset;
+}
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), input_);
 }
 
 void ParquetData::filterRowGroups(
@@ -77,9 +127,270 @@ bool ParquetData::rowGroupMatches(
         rowGroup.columns[column].meta_data.statistics,
         *type,
         rowGroup.num_rows);
-    return testFilter(filter, columnStats.get(), rowGroup.num_rows, type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.num_rows, type)) {
+      return false;
+    }
+  }
+  return bloomFilterMatches(rowGroupId, *filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto& chunk = rowGroups_[rowGroupId].columns[type_->column];
+  if (!input_ || !chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset || filter.testNull()) {
+    // Nulls are not in the Bloom filter.
+    return true;
+  }
+  std::vector<uint64_t> hashes;
+  if (!bloomFilterHashes(filter, hashes)) {
+    return true;
+  }
+  uint64_t bitsetOffset;
+  const auto numBytes = readBloomFilterHeader(
+      chunk.meta_data.bloom_filter_offset, bitsetOffset);
+  if (numBytes == 0) {
+    return true;
+  }
+  constexpr int32_t kBlockSize = SplitBlockBloomFilter::kBytesPerBlock;
+  const uint64_t numBlocks = numBytes / kBlockSize;
+  // Each value needs only the block it maps to. A few values read their
+  // blocks. More values read the bitset once.
+  std::vector<char> bitset;
+  if (hashes.size() > kMaxBloomFilterBlockReads) {
+    bitset = readBuffer(*input_, bitsetOffset, numBytes);
+  }
+  for (auto hash : hashes) {
+    const uint64_t blockOffset =
+        SplitBlockBloomFilter::blockIndex(hash, numBlocks) * kBlockSize;
+    if (bitset.empty()) {
+      auto block = readBuffer(*input_, bitsetOffset + blockOffset, kBlockSize);
+      if (SplitBlockBloomFilter::blockMayContain(block.data(), hash)) {
+        return true;
+      }
+    } else if (SplitBlockBloomFilter::blockMayContain(
+                   bitset.data() + blockOffset, hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParquetData::bloomFilterHashes(
+    const common::Filter& filter,
+    std::vector<uint64_t>& hashes) const {
+  if (!type_->parquetType_.has_value()) {
+    return false;
+  }
+  auto physicalType = type_->parquetType_.value();
+  auto kind = type_->type->kind();
+  bool isInteger = (kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+                    kind == TypeKind::INTEGER || kind == TypeKind::BIGINT) &&
+      (physicalType == thrift::Type::INT32 ||
+       physicalType == thrift::Type::INT64);
+  bool isBytes = (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) &&
+      physicalType == thrift::Type::BYTE_ARRAY;
+  // Values that do not fit the physical type are not in the column and
+  // get no hash.
+  auto addInteger = [&](int64_t value) {
+    if (physicalType == thrift::Type::INT64) {
+      hashes.push_back(SplitBlockBloomFilter::hash(value));
+    } else if (
+        value >= std::numeric_limits<int32_t>::min() &&
+        value <= std::numeric_limits<int32_t>::max()) {
+      hashes.push_back(
+          SplitBlockBloomFilter::hash(static_cast<int32_t>(value)));
+    }
+  };
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto range = static_cast<const common::BigintRange*>(&filter);
+      if (!isInteger || !range->isSingleValue()) {
+        return false;
+      }
+      addInteger(range->lower());
+      return true;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      if (!isInteger) {
+        return false;
+      }
+      for (auto value :
+           static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+               ->values()) {
+        addInteger(value);
+      }
+      return true;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      if (!isInteger) {
+        return false;
+      }
+      for (auto value :
+           static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+               ->values()) {
+        addInteger(value);
+      }
+      return true;
+    case common::FilterKind::kBytesRange: {
+      auto range = static_cast<const common::BytesRange*>(&filter);
+      if (!isBytes || !range->isSingleValue()) {
+        return false;
+      }
+      hashes.push_back(SplitBlockBloomFilter::hash(range->lower()));
+      return true;
+    }
+    case common::FilterKind::kBytesValues:
+      if (!isBytes) {
+        return false;
+      }
+      for (auto& value :
+           static_cast<const common::BytesValues*>(&filter)->values()) {
+        hashes.push_back(SplitBlockBloomFilter::hash(value));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+int32_t ParquetData::readBloomFilterHeader(
+    uint64_t offset,
+    uint64_t& bitsetOffset) {
+  // The footer has only the offset of the Bloom filter. The header is a
+  // few bytes followed by the bitset.
+  constexpr uint64_t kMaxHeaderSize = 256;
+  uint64_t fileSize = input_->getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bad Bloom filter offset");
+  thrift::BloomFilterHeader header;
+  auto headerSize = deserializeThrift(
+      readBuffer(
+          *input_, offset, std::min(kMaxHeaderSize, fileSize - offset)),
+      header);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % SplitBlockBloomFilter::kBytesPerBlock != 0) {
+    return 0;
+  }
+  VELOX_CHECK_LE(offset + headerSize + header.numBytes, fileSize);
+  bitsetOffset = offset + headerSize;
+  return header.numBytes;
+}
+
+const thrift::OffsetIndex* FOLLY_NULLABLE
+ParquetData::offsetIndex(uint32_t index, dwio::common::BufferedInput& input) {
+  auto it = offsetIndexes_.find(index);
+  if (it != offsetIndexes_.end()) {
+    return &it->second;
+  }
+  auto& chunk = rowGroups_[index].columns[type_->column];
+  if (!chunk.__isset.offset_index_offset ||
+      !chunk.__isset.offset_index_length) {
+    return nullptr;
+  }
+  auto& offsetIndex = offsetIndexes_[index];
+  readThrift(
+      input, chunk.offset_index_offset, chunk.offset_index_length, offsetIndex);
+  return &offsetIndex;
+}
+
+void ParquetData::filterPages(
+    uint32_t index,
+    common::Filter* FOLLY_NONNULL filter,
+    dwio::common::BufferedInput& input,
+    RowRanges& skippedRows) {
+  auto& chunk = rowGroups_[index].columns[type_->column];
+  if (!isFlat() || !chunk.__isset.column_index_offset ||
+      !chunk.__isset.column_index_length) {
+    return;
+  }
+  auto pageIndex = offsetIndex(index, input);
+  if (!pageIndex) {
+    return;
+  }
+  thrift::ColumnIndex columnIndex;
+  readThrift(
+      input, chunk.column_index_offset, chunk.column_index_length, columnIndex);
+  auto& pages = pageIndex->page_locations;
+  VELOX_CHECK_EQ(pages.size(), columnIndex.null_pages.size());
+  const bool hasNullCounts = columnIndex.__isset.null_counts &&
+      columnIndex.null_counts.size() == pages.size();
+  const int64_t numRows = rowGroups_[index].num_rows;
+  for (auto i = 0; i < pages.size(); ++i) {
+    auto begin = pages[i].first_row_index;
+    auto end = i + 1 < pages.size() ? pages[i + 1].first_row_index : numRows;
+    // Build the same statistics as for a row group from the page's entry in
+    // the ColumnIndex.
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(end - begin);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type_->type, end - begin);
+    if (!testFilter(filter, columnStats.get(), end - begin, type_->type)) {
+      skippedRows.push_back({begin, end});
+    }
   }
-  return true;
+}
+
+void ParquetData::setSkippedRows(
+    uint32_t index,
+    const RowRanges& skippedRows,
+    dwio::common::BufferedInput& input) {
+  chunkRanges_.erase(index);
+  if (skippedRows.empty() || !isFlat()) {
+    return;
+  }
+  const int64_t numRows = rowGroups_[index].num_rows;
+  // 'skippedRows' are sorted and disjoint. If the first range covers the row
+  // group, no page is needed and the column chunk is not read.
+  if (skippedRows.front().begin == 0 && skippedRows.front().end >= numRows) {
+    chunkRanges_[index] = {0, 0, numRows};
+    return;
+  }
+  auto pageIndex = offsetIndex(index, input);
+  if (!pageIndex || pageIndex->page_locations.empty()) {
+    return;
+  }
+  auto& pages = pageIndex->page_locations;
+  // First and last needed row.
+  const int64_t firstRow =
+      skippedRows.front().begin == 0 ? skippedRows.front().end : 0;
+  const int64_t lastRow = skippedRows.back().end >= numRows
+      ? skippedRows.back().begin - 1
+      : numRows - 1;
+  VELOX_DCHECK_LE(firstRow, lastRow);
+  auto pageOfRow = [&](int64_t row) {
+    auto it = std::upper_bound(
+        pages.begin(),
+        pages.end(),
+        row,
+        [](int64_t value, const thrift::PageLocation& page) {
+          return value < page.first_row_index;
+        });
+    return std::max<int32_t>(0, it - pages.begin() - 1);
+  };
+  auto firstPage = pageOfRow(firstRow);
+  auto lastPage = pageOfRow(lastRow);
+
+  auto& metaData = rowGroups_[index].columns[type_->column].meta_data;
+  auto chunkStart = chunkReadOffset(metaData);
+  // A dictionary page precedes the data pages. If there is one, the range must
+  // start with it.
+  const bool startsWithPage = chunkStart == pages[0].offset;
+  uint64_t begin = startsWithPage ? pages[firstPage].offset : chunkStart;
+  uint64_t end = pages[lastPage].offset + pages[lastPage].compressed_page_size;
+  VELOX_CHECK_LT(begin, end);
+  chunkRanges_[index] = {
+      begin,
+      end - begin,
+      startsWithPage ? pages[firstPage].first_row_index : 0};
 }
 
 void ParquetData::enqueueRowGroup(
@@ -97,33 +408,56 @@ void ParquetData::enqueueRowGroup(
       type_->column);
   auto& metaData = chunk.meta_data;
 
-  uint64_t chunkReadOffset = metaData.data_page_offset;
-  if (metaData.__isset.dictionary_page_offset &&
-      metaData.dictionary_page_offset >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = metaData.dictionary_page_offset;
-  }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
+  uint64_t readOffset = chunkReadOffset(metaData);
+  VELOX_CHECK_GE(readOffset, 0);
 
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
 
+  auto it = chunkRanges_.find(index);
+  if (it != chunkRanges_.end()) {
+    if (it->second.size == 0) {
+      // All rows are skipped. seekToRowGroup() makes an empty reader.
+      streams_[index] = nullptr;
+      return;
+    }
+    readOffset = it->second.offset;
+    readSize = it->second.size;
+  }
+
   auto id = dwio::common::StreamIdentifier(type_->column);
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({readOffset, readSize}, &id);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
-  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   auto& metadata = rowGroups_[index].columns[type_->column].meta_data;
+  int64_t chunkSize = metadata.total_compressed_size;
+  int64_t firstRow = 0;
+  auto it = chunkRanges_.find(index);
+  if (it != chunkRanges_.end()) {
+    chunkSize = it->second.size;
+    firstRow = it->second.firstRow;
+    chunkRanges_.erase(it);
+    if (chunkSize == 0) {
+      // All rows of the row group are skipped and nothing was read. The
+      // reader is positioned past the last row and is never read.
+      streams_[index] =
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              static_cast<const char*>(nullptr), 0);
+    }
+  }
+  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
+  offsetIndexes_.erase(index);
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
       type_,
       metadata.codec,
-      metadata.total_compressed_size);
+      chunkSize,
+      firstRow);
   return dwio::common::PositionProvider(empty);
 }
 
@@ -22,20 +22,37 @@
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/ScanSpec.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
+
+/// A range of top level rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
+/// Sorted, non-overlapping row ranges.
+using RowRanges = std::vector<RowRange>;
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
-  ParquetParams(memory::MemoryPool& pool, const thrift::FileMetaData& metaData)
-      : FormatParams(pool), metaData_(metaData) {}
+  /// 'input' reads the file for metadata beyond the footer, like
+  /// Bloom filters. If nullptr, such metadata is not used.
+  ParquetParams(
+      memory::MemoryPool& pool,
+      const thrift::FileMetaData& metaData,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
+      : FormatParams(pool), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+  dwio::common::BufferedInput* FOLLY_NULLABLE const input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -44,10 +61,12 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -66,6 +85,28 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Adds to 'skippedRows' the ranges of rows of 'index'th row group
+  /// in which no value can pass 'filter' according to the ColumnIndex
+  /// of the column. The ranges are pages given by the OffsetIndex and
+  /// are not sorted. Reads the page index through 'input'. Does
+  /// nothing if the column is not a top level primitive or has no page
+  /// index.
+  void filterPages(
+      uint32_t index,
+      common::Filter* FOLLY_NONNULL filter,
+      dwio::common::BufferedInput& input,
+      RowRanges& skippedRows);
+
+  /// Restricts the read of 'index'th row group to the pages that
+  /// cover rows outside of 'skippedRows'. The pages before the first
+  /// and after the last needed page are not read from storage. If
+  /// all rows are skipped, nothing is read. Must be called before
+  /// enqueueRowGroup().
+  void setSkippedRows(
+      uint32_t index,
+      const RowRanges& skippedRows,
+      dwio::common::BufferedInput& input);
+
   PageReader* FOLLY_NONNULL reader() const {
     return reader_.get();
   }
@@ -176,10 +217,56 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // False if 'filter' is a set of values none of which is in the Bloom
+  // filter of the column in 'rowGroupId'th row group.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  // Sets 'hashes' to the Bloom filter hashes of the values that pass
+  // 'filter'. Returns false if 'filter' is not an equality or IN filter
+  // on a column type with a known hash.
+  bool bloomFilterHashes(
+      const common::Filter& filter,
+      std::vector<uint64_t>& hashes) const;
+
+  // Reads the header of the Bloom filter at 'offset' through 'input_'.
+  // Returns the size of the bitset and sets 'bitsetOffset' to its
+  // start. Returns 0 if the filter uses an unknown algorithm, hash or
+  // compression.
+  int32_t readBloomFilterHeader(uint64_t offset, uint64_t& bitsetOffset);
+
+  // Maximum number of values tested against a Bloom filter by reading
+  // only the block of each value. The bitset is read whole for more
+  // values.
+  static constexpr int32_t kMaxBloomFilterBlockReads = 8;
+
+  // True if 'this' is a top level primitive column, i.e. the pages in
+  // its page index start at top level rows.
+  bool isFlat() const {
+    return maxRepeat_ == 0 && maxDefine_ <= 1;
+  }
+
+  // Returns the OffsetIndex of the column in 'index'th row group or
+  // nullptr if the file has none. Reads it through 'input' on first
+  // use.
+  const thrift::OffsetIndex* FOLLY_NULLABLE
+  offsetIndex(uint32_t index, dwio::common::BufferedInput& input);
+
+  // The byte range of a column chunk to read if only some pages are
+  // needed.
+  struct ChunkRange {
+    uint64_t offset;
+    uint64_t size;
+    // Row number of the first page in the range.
+    int64_t firstRow;
+  };
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  // Reads Bloom filters. Goes through the AsyncDataCache if the file is
+  // read through one. Bloom filters are not used if nullptr.
+  dwio::common::BufferedInput* FOLLY_NULLABLE const input_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
@@ -197,6 +284,13 @@ class ParquetData : public dwio::common::FormatData {
 
   // Count of leading skipped positions in 'presetNulls_'
   int32_t presetNullsConsumed_{0};
+
+  // OffsetIndex of the column for row groups where page skipping was
+  // considered.
+  std::unordered_map<uint32_t, thrift::OffsetIndex> offsetIndexes_;
+
+  // Part of the column chunk to read for row groups with skipped pages.
+  std::unordered_map<uint32_t, ChunkRange> chunkRanges_;
 };
 
 } // namespace facebook::velox::parquet
@@ -450,12 +450,14 @@ void ReaderBase::scheduleRowGroups(
   auto input = inputs_[thisGroup].get();
   if (!input) {
     auto newInput = input_->clone();
+    reader.filterPages(thisGroup, *input_);
     reader.enqueueRowGroup(thisGroup, *newInput);
     newInput->load(dwio::common::LogType::STRIPE);
     inputs_[thisGroup] = std::move(newInput);
   }
   if (nextGroup) {
     auto newInput = input_->clone();
+    reader.filterPages(nextGroup, *input_);
     reader.enqueueRowGroup(nextGroup, *newInput);
     newInput->load(dwio::common::LogType::STRIPE);
     inputs_[nextGroup] = std::move(newInput);
@@ -507,7 +509,8 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, readerBase_->fileMetaData());
+  ParquetParams params(
+      pool_, readerBase_->fileMetaData(), &readerBase_->bufferedInput());
 
   columnReader_ = ParquetColumnReader::build(
       readerBase_->schemaWithId(), // Id is schema id
@@ -555,15 +558,27 @@ void ParquetRowReader::filterRowGroups() {
 uint64_t ParquetRowReader::next(uint64_t size, velox::VectorPtr& result) {
   VELOX_CHECK_GT(size, 0);
 
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_) {
-    // attempt to advance to next row group
-    if (!advanceToNextRowGroup()) {
-      return 0;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_) {
+      // attempt to advance to next row group
+      if (!advanceToNextRowGroup()) {
+        return 0;
+      }
+    }
+    skipPages();
+    if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+      break;
     }
   }
 
   uint64_t rowsToRead = std::min(
       static_cast<uint64_t>(size), rowsInCurrentRowGroup_ - currentRowInGroup_);
+  if (nextSkippedRange_ < skippedRows_.size()) {
+    // Stop at the next skipped range.
+    rowsToRead = std::min<uint64_t>(
+        rowsToRead,
+        skippedRows_[nextSkippedRange_].begin - currentRowInGroup_);
+  }
 
   if (rowsToRead > 0) {
     columnReader_->next(rowsToRead, result, nullptr);
@@ -588,9 +603,28 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowInGroup_ = 0;
   currentRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  skippedRows_ = dynamic_cast<StructColumnReader&>(*columnReader_)
+                     .takeSkippedRows(nextRowGroupIndex);
+  nextSkippedRange_ = 0;
   return true;
 }
 
+void ParquetRowReader::skipPages() {
+  while (nextSkippedRange_ < skippedRows_.size() &&
+         skippedRows_[nextSkippedRange_].begin <= currentRowInGroup_) {
+    auto end = std::min<uint64_t>(
+        skippedRows_[nextSkippedRange_].end, rowsInCurrentRowGroup_);
+    if (end > currentRowInGroup_) {
+      // The column readers skip the rows, and the pages that only hold such
+      // rows, when the next read starts past them.
+      columnReader_->setReadOffset(
+          columnReader_->readOffset() + end - currentRowInGroup_);
+      currentRowInGroup_ = end;
+    }
+    ++nextSkippedRange_;
+  }
+}
+
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -147,6 +148,10 @@ class ParquetRowReader : public dwio::common::RowReader {
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Advances past the rows of the current row group that are ruled
+  // out by page indexes and start at the current row.
+  void skipPages();
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions& options_;
@@ -164,6 +169,12 @@ class ParquetRowReader : public dwio::common::RowReader {
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
+  // Rows of the current row group skipped based on page indexes.
+  RowRanges skippedRows_;
+
+  // Index of the first range in 'skippedRows_' that is not passed.
+  size_t nextSkippedRange_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include "velox/common/base/SimdUtil.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// The salts of the Parquet specification.
+alignas(32) constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+using Batch = xsimd::batch<uint32_t>;
+static_assert(8 % Batch::size == 0);
+
+// Returns the bit to set in each of 'Batch::size' words starting at
+// word 'offset' of a block for 'hash'.
+inline Batch blockMask(uint64_t hash, int32_t offset) {
+  auto key = Batch::broadcast(static_cast<uint32_t>(hash));
+  return Batch::broadcast(1)
+      << ((key * Batch::load_aligned(kSalt + offset)) >> 27);
+}
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(int32_t numBytes) {
+  VELOX_CHECK(
+      numBytes > 0 && numBytes % kBytesPerBlock == 0,
+      "Bad Bloom filter size {}",
+      numBytes);
+  numBlocks_ = numBytes / kBytesPerBlock;
+  words_.resize(numBytes / sizeof(uint32_t));
+}
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(
+    const char* FOLLY_NONNULL data,
+    int32_t numBytes)
+    : SplitBlockBloomFilter(numBytes) {
+  memcpy(words_.data(), data, numBytes);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  auto words = words_.data() + blockOffset(hash);
+  for (auto i = 0; i < kWordsPerBlock; i += Batch::size) {
+    (Batch::load_unaligned(words + i) | blockMask(hash, i))
+        .store_unaligned(words + i);
+  }
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  return blockMayContain(
+      reinterpret_cast<const char*>(words_.data() + blockOffset(hash)), hash);
+}
+
+// static
+bool SplitBlockBloomFilter::blockMayContain(
+    const char* FOLLY_NONNULL block,
+    uint64_t hash) {
+  auto words = reinterpret_cast<const uint32_t*>(block);
+  for (auto i = 0; i < kWordsPerBlock; i += Batch::size) {
+    auto mask = blockMask(hash, i);
+    if (simd::toBitMask((Batch::load_unaligned(words + i) & mask) != mask)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+/// Parquet split block Bloom filter. The bitset consists of 32 byte
+/// blocks of 8 32-bit words. The high 32 bits of the xxHash64 of a
+/// value select the block and the low 32 bits, multiplied by a
+/// different salt per word, select one bit in each of the 8 words. A
+/// block is probed with one SIMD operation on platforms with 256 bit
+/// vectors.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Makes an empty filter of 'numBytes' bytes. 'numBytes' must be a
+  /// positive multiple of kBytesPerBlock.
+  explicit SplitBlockBloomFilter(int32_t numBytes);
+
+  /// Makes a filter with a copy of the bitset in 'data'.
+  SplitBlockBloomFilter(const char* FOLLY_NONNULL data, int32_t numBytes);
+
+  /// Returns the hash of a value as specified for Parquet, i.e. the
+  /// xxHash64 with seed 0 of the PLAIN encoding of the value without
+  /// any length prefix.
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(std::string_view value);
+
+  void insert(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was inserted.
+  bool mayContain(uint64_t hash) const;
+
+  /// Returns the index of the block for 'hash' in a filter of 'numBlocks'
+  /// blocks.
+  static uint64_t blockIndex(uint64_t hash, uint64_t numBlocks) {
+    return (hash >> 32) * numBlocks >> 32;
+  }
+
+  /// Returns false if no value with 'hash' was inserted into a filter
+  /// whose block for 'hash' is the kBytesPerBlock bytes at 'block'. Allows
+  /// probing a filter in a file without reading all of it.
+  static bool blockMayContain(const char* FOLLY_NONNULL block, uint64_t hash);
+
+  /// Returns true if mayContain() is true for any of 'hashes'.
+  bool mayContainAny(const std::vector<uint64_t>& hashes) const {
+    for (auto hash : hashes) {
+      if (mayContain(hash)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int32_t numBytes() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+  const char* FOLLY_NONNULL data() const {
+    return reinterpret_cast<const char*>(words_.data());
+  }
+
+ private:
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  // Returns the index of the first word of the block for 'hash'.
+  uint64_t blockOffset(uint64_t hash) const {
+    return blockIndex(hash, numBlocks_) * kWordsPerBlock;
+  }
+
+  uint64_t numBlocks_;
+  std::vector<uint32_t> words_;
+};
+
+} // namespace facebook::velox::parquet
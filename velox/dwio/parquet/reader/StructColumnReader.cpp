@@ -108,6 +108,64 @@ void StructColumnReader::enqueueRowGroup(
   }
 }
 
+void StructColumnReader::filterPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  auto& skipped = skippedRows_[index];
+  skipped.clear();
+  if (nodeType_->parent) {
+    return;
+  }
+  for (auto& child : children_) {
+    auto kind = child->type()->kind();
+    if (kind == TypeKind::ROW || kind == TypeKind::ARRAY ||
+        kind == TypeKind::MAP) {
+      return;
+    }
+  }
+  for (auto& child : children_) {
+    if (auto filter = child->scanSpec()->filter()) {
+      child->formatData().as<ParquetData>().filterPages(
+          index, filter, input, skipped);
+    }
+  }
+  if (skipped.empty()) {
+    return;
+  }
+  // A row is skipped if any filter rules it out. Merge the pages of
+  // all filtered columns into disjoint ranges.
+  std::sort(
+      skipped.begin(),
+      skipped.end(),
+      [](const RowRange& left, const RowRange& right) {
+        return left.begin < right.begin;
+      });
+  int32_t numMerged = 0;
+  for (auto i = 1; i < skipped.size(); ++i) {
+    if (skipped[i].begin <= skipped[numMerged].end) {
+      skipped[numMerged].end =
+          std::max(skipped[numMerged].end, skipped[i].end);
+    } else {
+      skipped[++numMerged] = skipped[i];
+    }
+  }
+  skipped.resize(numMerged + 1);
+  for (auto& child : children_) {
+    child->formatData().as<ParquetData>().setSkippedRows(
+        index, skipped, input);
+  }
+}
+
+RowRanges StructColumnReader::takeSkippedRows(uint32_t index) {
+  auto it = skippedRows_.find(index);
+  if (it == skippedRows_.end()) {
+    return {};
+  }
+  auto rows = std::move(it->second);
+  skippedRows_.erase(it);
+  return rows;
+}
+
 void StructColumnReader::seekToRowGroup(uint32_t index) {
   SelectiveColumnReader::seekToRowGroup(index);
   BufferPtr noBuffer;
@@ -36,6 +36,19 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   /// Creates the streams for 'rowGroup in 'input'. Does not load yet.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  /// Finds the rows of 'index'th row group that cannot pass the
+  /// filters of the top level columns according to the page indexes
+  /// of the columns. Prepares all columns to skip the pages that only
+  /// hold such rows. Reads the page indexes through 'input'. Must be
+  /// called before enqueueRowGroup() for the same row group. Only
+  /// applies to the root reader when all columns are primitive, since
+  /// pages of nested columns do not start at top level rows.
+  void filterPages(uint32_t index, dwio::common::BufferedInput& input);
+
+  /// Returns and forgets the rows found by filterPages() for 'index'th
+  /// row group.
+  RowRanges takeSkippedRows(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -77,6 +90,9 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   ::parquet::internal::LevelInfo levelInfo_;
+
+  // Rows skipped by page indexes for row groups passed to filterPages().
+  std::unordered_map<uint32_t, RowRanges> skippedRows_;
 };
 
 } // namespace facebook::velox::parquet
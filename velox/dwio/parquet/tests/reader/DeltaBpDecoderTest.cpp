@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+class DeltaBpDecoderTest : public testing::Test {
+ protected:
+  // Encodes 'values' as DELTA_BINARY_PACKED like the reference writers. The
+  // deltas wrap around at the width of T. If 'padLastMiniBlock' is false, the
+  // encoding ends after the last bit of the last value instead of at the end
+  // of its miniblock, as some writers do.
+  template <typename T>
+  std::string encode(
+      const std::vector<T>& values,
+      bool padLastMiniBlock = true,
+      int32_t blockSize = 128,
+      int32_t miniBlocksPerBlock = 4) {
+    using U = std::make_unsigned_t<T>;
+    std::string result;
+    writeVarint(blockSize, result);
+    writeVarint(miniBlocksPerBlock, result);
+    writeVarint(values.size(), result);
+    writeZigZag(values.empty() ? 0 : values[0], result);
+    const int32_t valuesPerMiniBlock = blockSize / miniBlocksPerBlock;
+    for (size_t start = 1; start < values.size(); start += blockSize) {
+      const auto numDeltas = std::min<size_t>(blockSize, values.size() - start);
+      std::vector<T> deltas(numDeltas);
+      for (size_t i = 0; i < numDeltas; ++i) {
+        deltas[i] = static_cast<T>(
+            static_cast<U>(values[start + i]) -
+            static_cast<U>(values[start + i - 1]));
+      }
+      const T minDelta = *std::min_element(deltas.begin(), deltas.end());
+      writeZigZag(minDelta, result);
+      const auto bitWidthsOffset = result.size();
+      result.append(miniBlocksPerBlock, 0);
+      for (auto miniBlock = 0; miniBlock < miniBlocksPerBlock; ++miniBlock) {
+        const size_t first = miniBlock * valuesPerMiniBlock;
+        if (first >= numDeltas) {
+          break;
+        }
+        const auto numInMiniBlock =
+            std::min<size_t>(valuesPerMiniBlock, numDeltas - first);
+        U maxDelta = 0;
+        for (auto i = first; i < first + numInMiniBlock; ++i) {
+          maxDelta = std::max<U>(maxDelta, delta(deltas[i], minDelta));
+        }
+        const int32_t bitWidth =
+            maxDelta == 0 ? 0 : 64 - __builtin_clzll(maxDelta);
+        result[bitWidthsOffset + miniBlock] = bitWidth;
+        const bool isLast = start + first + numInMiniBlock == values.size();
+        const size_t numPacked = isLast && !padLastMiniBlock
+            ? numInMiniBlock
+            : valuesPerMiniBlock;
+        const auto numBits = bitWidth * numPacked;
+        std::string packed(bits::roundUp(numBits, 8) / 8, 0);
+        for (size_t i = 0; i < numInMiniBlock; ++i) {
+          const uint64_t packedDelta = delta(deltas[first + i], minDelta);
+          for (auto bit = 0; bit < bitWidth; ++bit) {
+            if (packedDelta >> bit & 1) {
+              const auto offset = i * bitWidth + bit;
+              packed[offset / 8] |= 1 << (offset % 8);
+            }
+          }
+        }
+        result += packed;
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  void testRoundTrip(const std::vector<T>& values, bool padLastMiniBlock) {
+    auto encoded = encode(values, padLastMiniBlock);
+    DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size());
+    ASSERT_EQ(decoder.numValues(), static_cast<int64_t>(values.size()));
+    std::vector<T> result(values.size());
+    decoder.readValues(result.data());
+    for (auto i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(result[i], values[i]) << i;
+    }
+    // The decoder consumes exactly the encoded run.
+    EXPECT_EQ(decoder.bufferStart(), encoded.data() + encoded.size());
+  }
+
+  // Returns 'value' - 'minDelta' with wraparound at the width of T.
+  template <typename T>
+  static std::make_unsigned_t<T> delta(T value, T minDelta) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(value) - static_cast<U>(minDelta));
+  }
+
+  static void writeVarint(uint64_t value, std::string& out) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+
+  static void writeZigZag(int64_t value, std::string& out) {
+    const auto unsignedValue = static_cast<uint64_t>(value);
+    writeVarint((unsignedValue << 1) ^ static_cast<uint64_t>(value >> 63), out);
+  }
+
+  std::mt19937_64 rng_{1};
+};
+
+TEST_F(DeltaBpDecoderTest, narrow) {
+  std::vector<int64_t> values(1'000);
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = i * 3 + rng_() % 1'000;
+  }
+  testRoundTrip(values, true);
+}
+
+TEST_F(DeltaBpDecoderTest, constantDelta) {
+  // All deltas equal the min delta. The miniblocks have a bit width of 0
+  // and no data.
+  std::vector<int32_t> values(300);
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = 7 - 5 * i;
+  }
+  testRoundTrip(values, true);
+  testRoundTrip(values, false);
+}
+
+TEST_F(DeltaBpDecoderTest, wide) {
+  // Deltas of up to 64 bits take the scalar path.
+  for (auto bitWidth : {33, 40, 57, 63, 64}) {
+    SCOPED_TRACE(bitWidth);
+    const uint64_t mask = bitWidth == 64 ? ~0ULL : (1ULL << bitWidth) - 1;
+    std::vector<int64_t> values(513);
+    for (auto i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<int64_t>(rng_() & mask);
+    }
+    testRoundTrip(values, true);
+  }
+  // Extreme values make deltas that overflow int64_t.
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 200; ++i) {
+    values.push_back(
+        i % 2 ? std::numeric_limits<int64_t>::max() - i
+              : std::numeric_limits<int64_t>::min() + i);
+  }
+  testRoundTrip(values, true);
+}
+
+TEST_F(DeltaBpDecoderTest, int32Wraparound) {
+  // The deltas between the extremes overflow int32_t and are encoded
+  // wrapped around to 32 bits.
+  std::vector<int32_t> values;
+  for (auto i = 0; i < 1'037; ++i) {
+    values.push_back(
+        i % 2 ? std::numeric_limits<int32_t>::max() - i
+              : std::numeric_limits<int32_t>::min() + i);
+  }
+  testRoundTrip(values, true);
+  testRoundTrip(values, false);
+}
+
+TEST_F(DeltaBpDecoderTest, unpaddedLastMiniBlock) {
+  // The last miniblock ends after its last value for both the vectorized
+  // and the scalar bit widths. The decoder must not read past the end.
+  for (auto numValues : {2, 9, 33, 130, 1'000}) {
+    SCOPED_TRACE(numValues);
+    std::vector<int32_t> narrow(numValues);
+    std::vector<int64_t> wide(numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      narrow[i] = rng_() % 100'000;
+      wide[i] = static_cast<int64_t>(rng_() >> 8);
+    }
+    testRoundTrip(narrow, false);
+    testRoundTrip(wide, false);
+  }
+}
+
+TEST_F(DeltaBpDecoderTest, trailingData) {
+  // DELTA_LENGTH_BYTE_ARRAY appends the values after the lengths.
+  std::vector<int32_t> lengths = {3, 0, 5, 1};
+  auto encoded = encode(lengths);
+  const auto runSize = encoded.size();
+  encoded += "abcdefghi";
+  DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size());
+  std::vector<int32_t> result(lengths.size());
+  decoder.readValues(result.data());
+  EXPECT_EQ(result, lengths);
+  EXPECT_EQ(decoder.bufferStart(), encoded.data() + runSize);
+}
+
+TEST_F(DeltaBpDecoderTest, truncated) {
+  std::vector<int64_t> values(200);
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = rng_() % 1'000'000;
+  }
+  auto encoded = encode(values);
+  DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size() / 2);
+  std::vector<int64_t> result(values.size());
+  EXPECT_THROW(decoder.readValues(result.data()), VeloxException);
+}
@@ -15,10 +15,15 @@
  */
 
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
+#include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
 #include <folly/init/Init.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -74,6 +79,160 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
+  // Returns a copy of the file in 'sinkPtr_' with a ColumnIndex and an
+  // OffsetIndex for each column chunk, built from the data page headers
+  // and their statistics. The data of the pages in 'corruptRows' is
+  // overwritten so that reading them fails.
+  std::string addPageIndexes(std::function<bool(int64_t)> corruptRows) {
+    std::string file(sinkPtr_->getData(), sinkPtr_->size());
+    auto fileMetaData = removeFooter(file);
+
+    for (auto& rowGroup : fileMetaData.row_groups) {
+      for (auto& chunk : rowGroup.columns) {
+        auto& metaData = chunk.meta_data;
+        thrift::ColumnIndex columnIndex;
+        thrift::OffsetIndex offsetIndex;
+        int64_t offset = metaData.data_page_offset;
+        int64_t row = 0;
+        while (row < metaData.num_values) {
+          thrift::PageHeader header;
+          auto headerSize = deserialize(
+              file.data() + offset, file.size() - offset, header);
+          EXPECT_EQ(thrift::PageType::DATA_PAGE, header.type);
+          auto& pageHeader = header.data_page_header;
+          auto& stats = pageHeader.statistics;
+          thrift::PageLocation location;
+          location.offset = offset;
+          location.compressed_page_size =
+              headerSize + header.compressed_page_size;
+          location.first_row_index = row;
+          offsetIndex.page_locations.push_back(location);
+          columnIndex.null_pages.push_back(
+              stats.null_count == pageHeader.num_values);
+          columnIndex.min_values.push_back(
+              stats.__isset.min_value ? stats.min_value : stats.min);
+          columnIndex.max_values.push_back(
+              stats.__isset.max_value ? stats.max_value : stats.max);
+          columnIndex.null_counts.push_back(stats.null_count);
+          if (corruptRows(row) &&
+              corruptRows(row + pageHeader.num_values - 1)) {
+            memset(
+                file.data() + offset + headerSize,
+                0xff,
+                header.compressed_page_size);
+          }
+          offset += location.compressed_page_size;
+          row += pageHeader.num_values;
+        }
+        columnIndex.__isset.null_counts = true;
+        columnIndex.boundary_order = thrift::BoundaryOrder::UNORDERED;
+        chunk.__set_column_index_offset(file.size());
+        chunk.__set_column_index_length(append(columnIndex, file));
+        chunk.__set_offset_index_offset(file.size());
+        chunk.__set_offset_index_length(append(offsetIndex, file));
+      }
+    }
+    appendFooter(fileMetaData, file);
+    return file;
+  }
+
+  // Returns a copy of the file in 'sinkPtr_' with a Bloom filter of
+  // 'numBytes' for each column chunk of 'column'. 'makeBloomFilter'
+  // inserts the values of a row group.
+  std::string addBloomFilters(
+      int32_t column,
+      int32_t numBytes,
+      std::function<void(int32_t rowGroup, SplitBlockBloomFilter&)>
+          makeBloomFilter) {
+    std::string file(sinkPtr_->getData(), sinkPtr_->size());
+    auto fileMetaData = removeFooter(file);
+    for (auto i = 0; i < fileMetaData.row_groups.size(); ++i) {
+      SplitBlockBloomFilter bloomFilter(numBytes);
+      makeBloomFilter(i, bloomFilter);
+      thrift::BloomFilterHeader header;
+      header.__set_numBytes(numBytes);
+      header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+      header.hash.__set_XXHASH(thrift::XxHash());
+      header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+      fileMetaData.row_groups[i]
+          .columns[column]
+          .meta_data.__set_bloom_filter_offset(file.size());
+      append(header, file);
+      file.append(bloomFilter.data(), bloomFilter.numBytes());
+    }
+    appendFooter(fileMetaData, file);
+    return file;
+  }
+
+  // Removes the footer from 'file' and returns the FileMetaData in it.
+  static thrift::FileMetaData removeFooter(std::string& file) {
+    uint32_t footerLength;
+    memcpy(&footerLength, file.data() + file.size() - 8, sizeof(uint32_t));
+    auto footerStart = file.size() - 8 - footerLength;
+    thrift::FileMetaData fileMetaData;
+    deserialize(file.data() + footerStart, footerLength, fileMetaData);
+    file.resize(footerStart);
+    return fileMetaData;
+  }
+
+  static void appendFooter(
+      const thrift::FileMetaData& fileMetaData,
+      std::string& file) {
+    uint32_t footerLength = append(fileMetaData, file);
+    file.append(reinterpret_cast<const char*>(&footerLength), sizeof(uint32_t));
+    file.append("PAR1");
+  }
+
+  // Reads 'file' with 'spec'. Returns the rows and sets
+  // 'skippedRowGroups'.
+  std::vector<RowVectorPtr> readFile(
+      const std::string& file,
+      const std::shared_ptr<ScanSpec>& spec,
+      int64_t& skippedRowGroups) {
+    ReaderOptions readerOpts;
+    RowReaderOptions rowReaderOpts;
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(std::string_view(file)),
+        readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<RowVectorPtr> result;
+    VectorPtr batch = BaseVector::create(rowType_, 1, pool_.get());
+    while (rowReader->next(1000, batch)) {
+      if (batch->size() > 0) {
+        result.push_back(std::static_pointer_cast<RowVector>(batch));
+        batch = BaseVector::create(rowType_, 1, pool_.get());
+      }
+    }
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    skippedRowGroups = stats.skippedStrides;
+    return result;
+  }
+
+  template <typename T>
+  static uint32_t deserialize(const char* data, uint64_t size, T& result) {
+    auto transport =
+        std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+    apache::thrift::protocol::TCompactProtocolT<thrift::ThriftBufferedTransport>
+        protocol(transport);
+    return result.read(&protocol);
+  }
+
+  // Serializes 'object' at the end of 'file'. Returns its size.
+  template <typename T>
+  static int32_t append(const T& object, std::string& file) {
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocolT<
+        apache::thrift::transport::TMemoryBuffer>
+        protocol(buffer);
+    object.write(&protocol);
+    auto serialized = buffer->getBufferAsString();
+    file.append(serialized);
+    return serialized.size();
+  }
+
   std::unique_ptr<facebook::velox::parquet::Writer> writer_;
   std::shared_ptr<::parquet::WriterProperties> writerProperties_;
   int32_t rowGroupSize_{10000};
@@ -106,6 +265,23 @@ TEST_F(E2EFilterTest, integerDirect) {
       {"short_val", "int_val", "long_val"},
       20);
 }
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  writerProperties_ =
+      ::parquet::WriterProperties::Builder()
+          .disable_dictionary()
+          ->encoding(::parquet::Encoding::DELTA_BINARY_PACKED)
+          ->data_pagesize(4 * 1024)
+          ->build();
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {::parquet::Compression::SNAPPY,
@@ -229,6 +405,29 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  writerProperties_ =
+      ::parquet::WriterProperties::Builder()
+          .disable_dictionary()
+          ->encoding(::parquet::Encoding::BYTE_STREAM_SPLIT)
+          ->data_pagesize(4 * 1024)
+          ->build();
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -497,6 +696,324 @@ TEST_F(E2EFilterTest, map) {
       10);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  // Sorted ids in small pages. The Arrow writer does not write page
+  // indexes, so they are added to the file after writing.
+  constexpr int32_t kNumRows = 20000;
+  rowGroupSize_ = kNumRows;
+  writerProperties_ = ::parquet::WriterProperties::Builder()
+                          .disable_dictionary()
+                          ->write_batch_size(128)
+                          ->data_pagesize(1024)
+                          ->build();
+  rowType_ = ROW({"id", "value"}, {BIGINT(), BIGINT()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kNumRows, pool_.get());
+  auto values = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kNumRows, pool_.get());
+  for (auto i = 0; i < kNumRows; ++i) {
+    ids->set(i, i);
+    values->set(i, i * 3);
+  }
+  std::vector<RowVectorPtr> batches{std::make_shared<RowVector>(
+      pool_.get(),
+      rowType_,
+      nullptr,
+      kNumRows,
+      std::vector<VectorPtr>{ids, values})};
+  writeToMemory(rowType_, batches, false);
+
+  // The pages that can be skipped are unreadable.
+  auto file = addPageIndexes(
+      [](int64_t row) { return row < 5000 || row >= 15000; });
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  auto idSpec = spec->getOrCreateChild(Subfield("id"));
+  idSpec->setProjectOut(true);
+  idSpec->setChannel(0);
+  idSpec->setFilter(std::make_unique<BigintRange>(10000, 10010, false));
+  auto valueSpec = spec->getOrCreateChild(Subfield("value"));
+  valueSpec->setProjectOut(true);
+  valueSpec->setChannel(1);
+
+  int64_t skippedRowGroups;
+  int64_t expected = 10000;
+  for (auto& rows : readFile(file, spec, skippedRowGroups)) {
+    auto resultIds = rows->childAt(0)->asFlatVector<int64_t>();
+    auto resultValues = rows->childAt(1)->asFlatVector<int64_t>();
+    for (auto i = 0; i < rows->size(); ++i) {
+      EXPECT_EQ(expected, resultIds->valueAt(i));
+      EXPECT_EQ(expected * 3, resultValues->valueAt(i));
+      ++expected;
+    }
+  }
+  EXPECT_EQ(10011, expected);
+}
+
+TEST_F(E2EFilterTest, pageIndexSkipsAllRows) {
+  // Each filter passes the row group statistics and some pages. The pages
+  // that pass one filter fail the other, so that no row is read.
+  constexpr int32_t kNumRows = 20000;
+  rowGroupSize_ = kNumRows;
+  writerProperties_ = ::parquet::WriterProperties::Builder()
+                          .disable_dictionary()
+                          ->write_batch_size(128)
+                          ->data_pagesize(1024)
+                          ->build();
+  rowType_ = ROW({"id", "value"}, {BIGINT(), BIGINT()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kNumRows, pool_.get());
+  auto values = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kNumRows, pool_.get());
+  for (auto i = 0; i < kNumRows; ++i) {
+    ids->set(i, i);
+    values->set(i, i * 3);
+  }
+  std::vector<RowVectorPtr> batches{std::make_shared<RowVector>(
+      pool_.get(),
+      rowType_,
+      nullptr,
+      kNumRows,
+      std::vector<VectorPtr>{ids, values})};
+  writeToMemory(rowType_, batches, false);
+
+  // All pages are unreadable.
+  auto file = addPageIndexes([](int64_t /*row*/) { return true; });
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  auto idSpec = spec->getOrCreateChild(Subfield("id"));
+  idSpec->setProjectOut(true);
+  idSpec->setChannel(0);
+  idSpec->setFilter(std::make_unique<BigintRange>(5000, 5010, false));
+  auto valueSpec = spec->getOrCreateChild(Subfield("value"));
+  valueSpec->setProjectOut(true);
+  valueSpec->setChannel(1);
+  valueSpec->setFilter(std::make_unique<BigintRange>(45000, 45030, false));
+
+  int64_t skippedRowGroups;
+  int64_t numRows = 0;
+  for (auto& rows : readFile(file, spec, skippedRowGroups)) {
+    numRows += rows->size();
+  }
+  EXPECT_EQ(0, numRows);
+  EXPECT_EQ(0, skippedRowGroups);
+}
+
+TEST_F(E2EFilterTest, bloomFilter) {
+  // Ids and names are scattered over all row groups, so that min/max
+  // statistics do not skip any. The Arrow writer does not write Bloom
+  // filters, so they are added to the file after writing.
+  constexpr int32_t kNumRows = 20000;
+  constexpr int32_t kRowGroupSize = 5000;
+  rowGroupSize_ = kRowGroupSize;
+  rowType_ = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  auto idAt = [](int64_t row) { return row * 7919 % kNumRows; };
+  auto nameAt = [&](int64_t row) { return fmt::format("name{}", idAt(row)); };
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kNumRows, pool_.get());
+  auto names = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kNumRows, pool_.get());
+  std::vector<std::string> nameStrings(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    ids->set(i, idAt(i));
+    nameStrings[i] = nameAt(i);
+    names->set(i, StringView(nameStrings[i]));
+  }
+  std::vector<RowVectorPtr> batches{std::make_shared<RowVector>(
+      pool_.get(),
+      rowType_,
+      nullptr,
+      kNumRows,
+      std::vector<VectorPtr>{ids, names})};
+  writeToMemory(rowType_, batches, false);
+
+  // About 10 values per 32 byte block.
+  constexpr int32_t kBloomFilterBytes = 16 << 10;
+  auto withIds = addBloomFilters(
+      0, kBloomFilterBytes, [&](int32_t rowGroup, auto& bloomFilter) {
+        for (auto i = 0; i < kRowGroupSize; ++i) {
+          bloomFilter.insert(SplitBlockBloomFilter::hash(
+              idAt(rowGroup * kRowGroupSize + i)));
+        }
+      });
+
+  auto makeSpec = [](std::unique_ptr<Filter> idFilter,
+                     std::unique_ptr<Filter> nameFilter) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    auto idSpec = spec->getOrCreateChild(Subfield("id"));
+    idSpec->setProjectOut(true);
+    idSpec->setChannel(0);
+    if (idFilter) {
+      idSpec->setFilter(std::move(idFilter));
+    }
+    auto nameSpec = spec->getOrCreateChild(Subfield("name"));
+    nameSpec->setProjectOut(true);
+    nameSpec->setChannel(1);
+    if (nameFilter) {
+      nameSpec->setFilter(std::move(nameFilter));
+    }
+    return spec;
+  };
+  auto countRows = [](const std::vector<RowVectorPtr>& result) {
+    int64_t numRows = 0;
+    for (auto& rows : result) {
+      numRows += rows->size();
+    }
+    return numRows;
+  };
+
+  // Ids in the third row group and one that is not in the file.
+  int64_t skippedRowGroups;
+  auto result = readFile(
+      withIds,
+      makeSpec(
+          createBigintValues(
+              {idAt(10000), idAt(10001), idAt(12345), kNumRows + 1}, false),
+          nullptr),
+      skippedRowGroups);
+  EXPECT_EQ(3, skippedRowGroups);
+  EXPECT_EQ(3, countRows(result));
+
+  result = readFile(
+      withIds,
+      makeSpec(
+          std::make_unique<BigintRange>(idAt(100), idAt(100), false),
+          nullptr),
+      skippedRowGroups);
+  EXPECT_EQ(3, skippedRowGroups);
+  EXPECT_EQ(1, countRows(result));
+
+  // Nulls are not in the Bloom filter.
+  result = readFile(
+      withIds,
+      makeSpec(createBigintValues({idAt(100), idAt(101)}, true), nullptr),
+      skippedRowGroups);
+  EXPECT_EQ(0, skippedRowGroups);
+  EXPECT_EQ(2, countRows(result));
+
+  auto withNames = addBloomFilters(
+      1, kBloomFilterBytes, [&](int32_t rowGroup, auto& bloomFilter) {
+        for (auto i = 0; i < kRowGroupSize; ++i) {
+          bloomFilter.insert(SplitBlockBloomFilter::hash(
+              std::string_view(nameAt(rowGroup * kRowGroupSize + i))));
+        }
+      });
+  result = readFile(
+      withNames,
+      makeSpec(
+          nullptr,
+          std::make_unique<BytesValues>(
+              std::vector<std::string>{nameAt(5000), nameAt(6000), "none"},
+              false)),
+      skippedRowGroups);
+  EXPECT_EQ(3, skippedRowGroups);
+  EXPECT_EQ(2, countRows(result));
+}
+
+TEST_F(E2EFilterTest, bloomFilterWrittenByArrow) {
+  // bloom_filter.parquet is written by Arrow 26 with Bloom filters of 2KB for
+  // all columns. It has 2 row groups of 1000 rows. Row i has id and id32
+  // 2 * i and name "name<2 * i>". The odd values that pass the filters of
+  // each row group were found with an independent implementation of the
+  // Parquet specification.
+  LocalReadFile localFile(facebook::velox::test::getDataFilePath(
+      "velox/dwio/parquet/tests/reader", "../examples/bloom_filter.parquet"));
+  const auto file = localFile.pread(0, localFile.size());
+  auto footerless = file;
+  auto fileMetaData = removeFooter(footerless);
+  ASSERT_EQ(2, fileMetaData.row_groups.size());
+  const std::vector<std::vector<std::vector<int32_t>>> kFalsePositives = {
+      {{}, {265, 1629}, {487, 1699}}, {{2365, 2947, 3795}, {2441, 3423}, {}}};
+  for (auto rowGroup = 0; rowGroup < 2; ++rowGroup) {
+    auto& columns = fileMetaData.row_groups[rowGroup].columns;
+    ASSERT_EQ(3, columns.size());
+    for (auto column = 0; column < 3; ++column) {
+      SCOPED_TRACE(fmt::format("{} {}", rowGroup, column));
+      auto hashAt = [&](int32_t value) {
+        switch (column) {
+          case 0:
+            return SplitBlockBloomFilter::hash(static_cast<int64_t>(value));
+          case 1:
+            return SplitBlockBloomFilter::hash(value);
+          default:
+            return SplitBlockBloomFilter::hash(
+                std::string_view(fmt::format("name{}", value)));
+        }
+      };
+      const auto offset = columns[column].meta_data.bloom_filter_offset;
+      thrift::BloomFilterHeader header;
+      auto headerSize =
+          deserialize(file.data() + offset, file.size() - offset, header);
+      ASSERT_TRUE(header.algorithm.__isset.BLOCK);
+      ASSERT_TRUE(header.hash.__isset.XXHASH);
+      ASSERT_EQ(2048, header.numBytes);
+      SplitBlockBloomFilter bloomFilter(
+          file.data() + offset + headerSize, header.numBytes);
+      std::vector<int32_t> falsePositives;
+      for (auto i = rowGroup * 2000; i < (rowGroup + 1) * 2000; ++i) {
+        auto passed = bloomFilter.mayContain(hashAt(i));
+        if (i % 2 == 0) {
+          ASSERT_TRUE(passed) << i;
+        } else if (passed) {
+          falsePositives.push_back(i);
+        }
+      }
+      EXPECT_EQ(kFalsePositives[rowGroup][column], falsePositives);
+    }
+  }
+
+  // The statistics of one row group pass each value. The Bloom filters
+  // reject 1001 and name1001. 2365 and name487 are false positives.
+  rowType_ = ROW({"id", "id32", "name"}, {BIGINT(), INTEGER(), VARCHAR()});
+  auto makeSpec = [&](int32_t column, std::unique_ptr<Filter> filter) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    for (auto i = 0; i < rowType_->size(); ++i) {
+      auto childSpec = spec->getOrCreateChild(Subfield(rowType_->nameOf(i)));
+      childSpec->setProjectOut(true);
+      childSpec->setChannel(i);
+      if (i == column) {
+        childSpec->setFilter(std::move(filter));
+      }
+    }
+    return spec;
+  };
+  int64_t skippedRowGroups;
+  auto result = readFile(
+      file,
+      makeSpec(0, std::make_unique<BigintRange>(1001, 1001, false)),
+      skippedRowGroups);
+  EXPECT_EQ(2, skippedRowGroups);
+  EXPECT_TRUE(result.empty());
+
+  result = readFile(
+      file,
+      makeSpec(0, createBigintValues({1000, 2365}, false)),
+      skippedRowGroups);
+  EXPECT_EQ(0, skippedRowGroups);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(1, result[0]->size());
+
+  result = readFile(
+      file,
+      makeSpec(
+          2,
+          std::make_unique<BytesValues>(
+              std::vector<std::string>{"name1001"}, false)),
+      skippedRowGroups);
+  EXPECT_EQ(2, skippedRowGroups);
+  EXPECT_TRUE(result.empty());
+
+  result = readFile(
+      file,
+      makeSpec(
+          2,
+          std::make_unique<BytesValues>(
+              std::vector<std::string>{"name487"}, false)),
+      skippedRowGroups);
+  EXPECT_EQ(1, skippedRowGroups);
+  EXPECT_TRUE(result.empty());
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
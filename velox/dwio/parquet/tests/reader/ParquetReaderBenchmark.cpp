@@ -39,7 +39,9 @@ const double kFilterErrorMargin = 0.2;
 
 class ParquetReaderBenchmark {
  public:
-  explicit ParquetReaderBenchmark(bool disableDictionary)
+  explicit ParquetReaderBenchmark(
+      bool disableDictionary,
+      ::parquet::Encoding::type encoding = ::parquet::Encoding::PLAIN)
       : disableDictionary_(disableDictionary) {
     pool_ = memory::getDefaultMemoryPool();
     dataSetBuilder_ = std::make_unique<DataSetBuilder>(*pool_.get(), 0);
@@ -47,9 +49,11 @@ class ParquetReaderBenchmark {
     auto sink = std::make_unique<LocalFileSink>("test.parquet");
     std::shared_ptr<::parquet::WriterProperties> writerProperties;
     if (disableDictionary_) {
-      // The parquet file is in plain encoding format.
-      writerProperties =
-          ::parquet::WriterProperties::Builder().disable_dictionary()->build();
+      // The parquet file is in plain or the given non-dictionary encoding.
+      writerProperties = ::parquet::WriterProperties::Builder()
+                             .disable_dictionary()
+                             ->encoding(encoding)
+                             ->build();
     } else {
       // The parquet file is in dictionary encoding format.
       writerProperties = ::parquet::WriterProperties::Builder().build();
@@ -258,6 +262,41 @@ void run(
       nextSize);
 }
 
+// Compares the native and DuckDB readers on files where all pages have
+// 'encoding'.
+void runEncoding(
+    uint32_t,
+    const TypePtr& type,
+    ::parquet::Encoding::type encoding,
+    ParquetReaderType parquetReaderType,
+    float filterRateX100) {
+  ParquetReaderBenchmark benchmark(true, encoding);
+  benchmark.readSingleColumn(
+      parquetReaderType,
+      type->toString(),
+      type,
+      0,
+      filterRateX100,
+      20,
+      10000);
+}
+
+#define PARQUET_ENCODING_BENCHMARKS(_type_, _name_, _encoding_, _filter_) \
+  BENCHMARK_NAMED_PARAM(                                                  \
+      runEncoding,                                                        \
+      _name_##_##_encoding_##_Filter_##_filter_##_native,                 \
+      _type_,                                                             \
+      ::parquet::Encoding::_encoding_,                                    \
+      ParquetReaderType::NATIVE,                                          \
+      _filter_);                                                          \
+  BENCHMARK_NAMED_PARAM(                                                  \
+      runEncoding,                                                        \
+      _name_##_##_encoding_##_Filter_##_filter_##_duckdb,                 \
+      _type_,                                                             \
+      ::parquet::Encoding::_encoding_,                                    \
+      ParquetReaderType::DUCKDB,                                          \
+      _filter_);
+
 #define PARQUET_BENCHMARKS_NULLS_FILTER(_type_, _name_, _filter_, _null_) \
   BENCHMARK_NAMED_PARAM(                                                  \
       run,                                                                \
@@ -359,6 +398,12 @@ void run(
 PARQUET_BENCHMARKS(BIGINT(), BigInt);
 PARQUET_BENCHMARKS(DOUBLE(), Double);
 
+PARQUET_ENCODING_BENCHMARKS(BIGINT(), BigInt, DELTA_BINARY_PACKED, 20);
+PARQUET_ENCODING_BENCHMARKS(BIGINT(), BigInt, DELTA_BINARY_PACKED, 100);
+PARQUET_ENCODING_BENCHMARKS(DOUBLE(), Double, BYTE_STREAM_SPLIT, 20);
+PARQUET_ENCODING_BENCHMARKS(DOUBLE(), Double, BYTE_STREAM_SPLIT, 100);
+BENCHMARK_DRAW_LINE();
+
 // TODO: Add all data types
 
 int main(int argc, char** argv) {
@@ -126,3 +126,63 @@ TEST_F(ParquetReaderTest, parseRowMapArray) {
   auto col0_1_1_0 = col0_1_1->childAt(0);
   EXPECT_EQ(col0_1_1_0->type->kind(), TypeKind::INTEGER);
 }
+
+TEST_F(ParquetReaderTest, readDeltaEncodings) {
+  // delta_encodings.parquet is written by Arrow with no dictionary and no
+  // compression. It holds 1037 rows in one row group, without nulls:
+  //   int32_wrap: INTEGER, DELTA_BINARY_PACKED. Alternates between the
+  //     extremes so that the deltas overflow int32_t.
+  //   int64_wide: BIGINT, DELTA_BINARY_PACKED. Deltas wider than 32 bits.
+  //   delta_length: VARCHAR, DELTA_LENGTH_BYTE_ARRAY.
+  //   delta_byte: VARCHAR, DELTA_BYTE_ARRAY. Consecutive values share
+  //     prefixes.
+  //   float_split: REAL, BYTE_STREAM_SPLIT.
+  //   double_split: DOUBLE, BYTE_STREAM_SPLIT.
+  constexpr int32_t kSize = 1037;
+  const std::string sample(getExampleFilePath("delta_encodings.parquet"));
+
+  ReaderOptions readerOptions;
+  ParquetReader reader = createReader(sample, readerOptions);
+  EXPECT_EQ(reader.numberOfRows(), 1037ULL);
+
+  auto schema =
+      ROW({"int32_wrap",
+           "int64_wide",
+           "delta_length",
+           "delta_byte",
+           "float_split",
+           "double_split"},
+          {INTEGER(), BIGINT(), VARCHAR(), VARCHAR(), REAL(), DOUBLE()});
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(makeScanSpec(schema));
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+
+  std::vector<std::string> deltaLength(kSize);
+  std::vector<std::string> deltaByte(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    for (auto j = 0; j < i % 3; ++j) {
+      deltaLength[i] += fmt::format("value-{}", i);
+    }
+    deltaByte[i] = fmt::format("prefix-{}-{}", i / 10, i);
+  }
+  auto expected = vectorMaker_->rowVector({
+      vectorMaker_->flatVector<int32_t>(
+          kSize,
+          [](auto row) {
+            return row % 2 ? std::numeric_limits<int32_t>::max() - row
+                           : std::numeric_limits<int32_t>::min() + row;
+          }),
+      vectorMaker_->flatVector<int64_t>(
+          kSize,
+          [](auto row) {
+            return (row % 2 ? 1 : -1) * (static_cast<int64_t>(row) << 40);
+          }),
+      vectorMaker_->flatVector(deltaLength),
+      vectorMaker_->flatVector(deltaByte),
+      vectorMaker_->flatVector<float>(
+          kSize, [](auto row) { return row * 0.5f; }),
+      vectorMaker_->flatVector<double>(
+          kSize, [](auto row) { return row * 0.5; }),
+  });
+  assertReadExpected(*rowReader, expected);
+}
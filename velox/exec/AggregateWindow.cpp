@@ -29,6 +29,11 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Frames that do not allow incremental aggregation are answered from a
+// segment tree when they are large on average. The tree is built once per
+// partition from intermediate results of the aggregate. Each frame is then
+// computed by combining O(log n) tree nodes with a few raw input rows.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -37,7 +42,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
       const TypePtr& resultType,
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator), name_(name) {
     argTypes_.reserve(args.size());
     argIndices_.reserve(args.size());
     argVectors_.reserve(args.size());
@@ -104,6 +109,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTreeBuilt_ = false;
+    segmentTreeArgs_.clear();
+    segmentTreeLevels_.clear();
   }
 
   void apply(
@@ -147,6 +155,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(rawFrameStarts, rawFrameEnds, numRows)) {
+      if (!segmentTreeBuilt_) {
+        buildSegmentTree();
+      }
+      segmentTreeAggregation(
+          numRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -299,6 +313,171 @@ class AggregateWindowFunction : public exec::WindowFunction {
     }
   }
 
+  // Returns true if the frames of this block should be computed from the
+  // segment tree. Once the tree is built, it is used for the rest of the
+  // partition.
+  bool useSegmentTree(
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t numRows) const {
+    if (segmentTreeBuilt_) {
+      return true;
+    }
+    int64_t totalFrameSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      totalFrameSize +=
+          std::max<vector_size_t>(0, rawFrameEnds[i] - rawFrameStarts[i] + 1);
+    }
+    return totalFrameSize >= kSegmentTreeMinFrameSize * numRows;
+  }
+
+  // Builds the segment tree for the current partition. Level 0 is the raw
+  // input of the whole partition in 'segmentTreeArgs_'. Node i of level l > 0
+  // holds the intermediate result for rows [i * F^l, (i + 1) * F^l) of the
+  // partition, where F is kSegmentTreeFanout. Only complete nodes are built.
+  void buildSegmentTree() {
+    const auto numPartitionRows = partition_->numRows();
+    segmentTreeArgs_.reserve(argIndices_.size());
+    for (int i = 0; i < argIndices_.size(); i++) {
+      if (argIndices_[i] == kConstantChannel) {
+        segmentTreeArgs_.push_back(
+            BaseVector::wrapInConstant(numPartitionRows, 0, argVectors_[i]));
+      } else {
+        auto vector = BaseVector::create(argTypes_[i], numPartitionRows, pool_);
+        partition_->extractColumn(
+            argIndices_[i], 0, numPartitionRows, 0, vector);
+        segmentTreeArgs_.push_back(std::move(vector));
+      }
+    }
+    segmentTreeRows_.resize(numPartitionRows, false);
+    if (!intermediateType_) {
+      intermediateType_ = exec::Aggregate::intermediateType(name_, argTypes_);
+    }
+
+    // Accumulators of one level are laid out one after the other in a single
+    // buffer. They are destroyed once their intermediate results are
+    // extracted.
+    const auto groupStride = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    const std::vector<VectorPtr>* input = &segmentTreeArgs_;
+    for (auto numNodes = numPartitionRows / kSegmentTreeFanout; numNodes > 0;
+         numNodes /= kSegmentTreeFanout) {
+      auto groupsBuffer =
+          AlignedBuffer::allocate<char>(numNodes * groupStride, pool_);
+      std::vector<char*> groups(numNodes);
+      std::vector<vector_size_t> newGroups(numNodes);
+      for (auto i = 0; i < numNodes; ++i) {
+        groups[i] = groupsBuffer->asMutable<char>() + i * groupStride;
+        newGroups[i] = i;
+      }
+      aggregate_->initializeNewGroups(groups.data(), newGroups);
+
+      const auto numInputRows = numNodes * kSegmentTreeFanout;
+      std::vector<char*> inputGroups(numInputRows);
+      for (auto row = 0; row < numInputRows; ++row) {
+        inputGroups[row] = groups[row / kSegmentTreeFanout];
+      }
+      SelectivityVector inputRows(numInputRows);
+      if (input == &segmentTreeArgs_) {
+        aggregate_->addRawInput(inputGroups.data(), inputRows, *input, false);
+      } else {
+        aggregate_->addIntermediateResults(
+            inputGroups.data(), inputRows, *input, false);
+      }
+
+      auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(groups.data(), numNodes, &level);
+      aggregate_->destroy(folly::Range(groups.data(), numNodes));
+      segmentTreeLevels_.push_back({std::move(level)});
+      input = &segmentTreeLevels_.back();
+    }
+    segmentTreeBuilt_ = true;
+  }
+
+  void segmentTreeAggregation(
+      vector_size_t numRows,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    for (int i = 0; i < numRows; i++) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      aggregateSegmentTreeRange(frameStartsVector[i], frameEndsVector[i] + 1);
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    }
+  }
+
+  // Adds partition rows [begin, end) to the single group. Starting from the
+  // raw input, the rows at either end of the range that do not fill a
+  // complete node of the next level are added at the current level. The
+  // remaining range is then covered by the next level. The rows are added in
+  // partition order for order sensitive aggregates like array_agg: the left
+  // fringes bottom-up, then the middle of the top level, then the right
+  // fringes top-down.
+  void aggregateSegmentTreeRange(vector_size_t begin, vector_size_t end) {
+    segmentTreeRightFringes_.clear();
+    for (size_t level = 0; begin < end; ++level) {
+      const auto nextBegin = bits::roundUp(begin, kSegmentTreeFanout);
+      const auto nextEnd = end / kSegmentTreeFanout * kSegmentTreeFanout;
+      if (level == segmentTreeLevels_.size() || nextBegin >= nextEnd) {
+        addSegmentTreeRows(level, begin, end);
+        break;
+      }
+      addSegmentTreeRows(level, begin, nextBegin);
+      segmentTreeRightFringes_.push_back({level, nextEnd, end});
+      begin = nextBegin / kSegmentTreeFanout;
+      end = nextEnd / kSegmentTreeFanout;
+    }
+    for (auto it = segmentTreeRightFringes_.rbegin();
+         it != segmentTreeRightFringes_.rend();
+         ++it) {
+      addSegmentTreeRows(it->level, it->begin, it->end);
+    }
+  }
+
+  // Adds rows [begin, end) of 'level' of the segment tree to the single
+  // group.
+  void addSegmentTreeRows(
+      size_t level,
+      vector_size_t begin,
+      vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    segmentTreeRows_.setValidRange(begin, end, true);
+    segmentTreeRows_.setActiveRange(begin, end);
+    if (level == 0) {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, segmentTreeRows_, segmentTreeArgs_, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_,
+          segmentTreeRows_,
+          segmentTreeLevels_[level - 1],
+          false);
+    }
+    segmentTreeRows_.setValidRange(begin, end, false);
+  }
+
+  // Number of nodes of one level of the segment tree that are combined into
+  // a node of the next level.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // Minimum average frame size for which frames that cannot be aggregated
+  // incrementally are computed from the segment tree instead of from raw
+  // input.
+  static constexpr vector_size_t kSegmentTreeMinFrameSize = 64;
+
+  const std::string name_;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -329,6 +508,32 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
+
+  // Segment tree for the current partition. Valid if 'segmentTreeBuilt_' is
+  // true. 'segmentTreeArgs_' are the argument vectors for all rows of the
+  // partition. 'segmentTreeLevels_[l]' holds the intermediate results of
+  // level l + 1 as the single argument to addIntermediateResults.
+  bool segmentTreeBuilt_{false};
+  std::vector<VectorPtr> segmentTreeArgs_;
+  std::vector<std::vector<VectorPtr>> segmentTreeLevels_;
+
+  // Intermediate type of the aggregate. Resolved on first use.
+  TypePtr intermediateType_;
+
+  // Rows passed to the aggregate when adding a range of a segment tree level.
+  // All rows are deselected between uses.
+  SelectivityVector segmentTreeRows_;
+
+  // A range of rows of a segment tree level.
+  struct SegmentTreeRange {
+    size_t level;
+    vector_size_t begin;
+    vector_size_t end;
+  };
+
+  // Right fringes of the frame being aggregated. Added after the levels above
+  // them.
+  std::vector<SegmentTreeRange> segmentTreeRightFringes_;
 };
 
 } // namespace
@@ -138,6 +138,9 @@ enum class BlockingReason {
   /// Build operator is blocked waiting for all its peers to stop to run group
   /// spill on all of them.
   kWaitForSpill,
+  /// Parallel OrderBy operator is blocked waiting for its peers to exchange
+  /// samples or key ranges.
+  kWaitForPeers,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -438,6 +441,20 @@ struct DriverFactory {
 
     return joinNodeIds;
   }
+
+  /// Returns plan node IDs of all NestedLoopJoinNode's in the pipeline.
+  std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const {
+    std::vector<core::PlanNodeId> joinNodeIds;
+    for (const auto& planNode : planNodes) {
+      if (auto joinNode =
+              std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(
+                  planNode)) {
+        joinNodeIds.emplace_back(joinNode->id());
+      }
+    }
+
+    return joinNodeIds;
+  }
 };
 
 // Begins and ends a section where a thread is running but not
@@ -17,6 +17,7 @@
 #include <velox/common/base/Exceptions.h>
 #include <velox/common/memory/Memory.h>
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -373,7 +374,11 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   VectorStreamGroup::read(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+      inputStream_.get(),
+      operatorCtx_->pool(),
+      outputType_,
+      &result_,
+      serdeOptions_.get());
 
   {
     auto lockedStats = stats_.wlock();
@@ -390,6 +395,16 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
+    const core::QueryConfig& queryConfig) {
+  return std::make_unique<
+      serializer::presto::PrestoVectorSerde::PrestoOptions>(
+      false /*useLosslessTimestamp*/,
+      common::stringToCompressionKind(queryConfig.shuffleCompressionKind()),
+      0.8 /*minCompressionRatio*/,
+      queryConfig.shufflePreserveEncodings());
+}
+
 VELOX_REGISTER_EXCHANGE_SOURCE_METHOD_DEFINITION(
     ExchangeSource,
     createLocalExchangeSource);
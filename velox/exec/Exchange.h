@@ -20,9 +20,16 @@
 #include <memory>
 #include "velox/common/memory/ByteStream.h"
 #include "velox/exec/Operator.h"
+#include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
+/// Returns the serde options for the pages exchanged between the tasks of a
+/// query with 'queryConfig'. PartitionedOutput and the exchange operators
+/// reading its pages must use the same options.
+std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
+    const core::QueryConfig& queryConfig);
+
 // Corresponds to Presto SerializedPage, i.e. a container for
 // serialize vectors in Presto wire format.
 class SerializedPage {
@@ -359,6 +366,7 @@ class Exchange : public SourceOperator {
             exchangeNode->id(),
             "Exchange"),
         planNodeId_(exchangeNode->id()),
+        serdeOptions_(getVectorSerdeOptions(ctx->queryConfig())),
         exchangeClient_(std::move(exchangeClient)) {
     if (operatorCtx_->driverCtx()->driverId == 0) {
       // As all Exchange operators share the same ExchangeClient, we only
@@ -398,6 +406,7 @@ class Exchange : public SourceOperator {
   bool getSplits(ContinueFuture* FOLLY_NONNULL future);
 
   const core::PlanNodeId planNodeId_;
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
@@ -67,6 +67,7 @@ GroupingSet::GroupingSet(
       spillConfig_(spillConfig),
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
+      intermediateRows_(operatorCtx->pool()),
       isAdaptive_(operatorCtx->task()
                       ->queryCtx()
                       ->queryConfig()
@@ -404,7 +405,18 @@ bool GroupingSet::getOutput(
     return getGlobalAggregationOutput(batchSize, isPartial_, iterator, result);
   }
   if (spiller_) {
-    return getOutputWithSpill(batchSize, result);
+    if (getOutputWithSpill(batchSize, result)) {
+      return true;
+    }
+    if (!preGroupedKeyChannels_.empty() && !noMoreInput_) {
+      // The spilled groups of pre-grouped keys are done. The remaining input
+      // starts the next group.
+      resetSpill();
+      if (remainingInput_) {
+        addRemainingInput();
+      }
+    }
+    return false;
   }
 
   // @lint-ignore CLANGTIDY
@@ -455,6 +467,53 @@ void GroupingSet::resetPartial() {
   }
 }
 
+void GroupingSet::toIntermediate(
+    const RowVectorPtr& input,
+    const RowVectorPtr& result) {
+  VELOX_CHECK(isPartial_ && isRawInput_ && !isGlobal_);
+  if (!table_) {
+    // The table sets up the row layout of the aggregates.
+    createHashTable();
+  }
+
+  const auto numRows = input->size();
+  activeRows_.resize(numRows);
+  activeRows_.setAll();
+  masks_.addInput(input, activeRows_);
+
+  result->resize(numRows);
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    result->childAt(i) =
+        BaseVector::loadedVectorShared(input->childAt(keyChannels_[i]));
+  }
+
+  const auto rowSize = table_->rows()->fixedRowSize();
+  intermediateGroups_.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    intermediateGroups_[i] = intermediateRows_.allocateFixed(rowSize);
+    memset(intermediateGroups_[i], 0, rowSize);
+  }
+  intermediateRowNumbers_.resize(numRows);
+  std::iota(intermediateRowNumbers_.begin(), intermediateRowNumbers_.end(), 0);
+
+  auto* groups = intermediateGroups_.data();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    aggregates_[i]->initializeNewGroups(groups, intermediateRowNumbers_);
+    const auto& rows = getSelectivityVector(i);
+    if (rows.hasSelections()) {
+      populateTempVectors(i, input);
+      aggregates_[i]->addRawInput(groups, rows, tempVectors_, false);
+    }
+    aggregates_[i]->extractAccumulators(
+        groups, numRows, &result->childAt(keyChannels_.size() + i));
+    if (aggregates_[i]->accumulatorUsesExternalMemory()) {
+      aggregates_[i]->destroy(folly::Range(groups, numRows));
+    }
+  }
+  tempVectors_.clear();
+  intermediateRows_.clear();
+}
+
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
     return table_->allocatedBytes();
@@ -573,7 +632,8 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->maxFileSize,
         spillConfig_->minSpillRunSize,
         Spiller::spillPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->compressionKind);
   }
   spiller_->spill(targetRows, targetBytes);
 }
@@ -598,6 +658,15 @@ bool GroupingSet::getOutputWithSpill(
         false,
         &pool_,
         ContainerRowSerde::instance());
+    if (!preGroupedKeyChannels_.empty()) {
+      // The next group of pre-grouped keys needs a new hash table.
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      for (const auto& hasher : table_->hashers()) {
+        hashers.push_back(
+            VectorHasher::create(hasher->type(), hasher->channel()));
+      }
+      hashers_ = std::move(hashers);
+    }
     // Take ownership of the rows and free the hash table. The table will not be
     // needed for producing spill output.
     rowsWhileReadingSpill_ = table_->moveRows();
@@ -631,6 +700,20 @@ bool GroupingSet::getOutputWithSpill(
   return false;
 }
 
+void GroupingSet::resetSpill() {
+  VELOX_CHECK_NULL(table_);
+  finishedSpillStats_ += spiller_->stats();
+  merge_.reset();
+  spiller_.reset();
+  mergeRows_.reset();
+  mergeState_ = nullptr;
+  nextKeyIsEqual_ = false;
+  outputPartition_ = -1;
+  nonSpilledRows_.reset();
+  nonSpilledIndex_ = 0;
+  rowsWhileReadingSpill_.reset();
+}
+
 bool GroupingSet::mergeNext(int32_t batchSize, const RowVectorPtr& result) {
   for (;;) {
     auto next = merge_->nextWithEquals();
@@ -66,6 +66,13 @@ class GroupingSet {
 
   void resetPartial();
 
+  /// Converts each row of 'input' into an intermediate result of its own
+  /// without adding it to the hash table. Sets the grouping keys of 'result'
+  /// to the keys of 'input' and the aggregates to the accumulators of the
+  /// single row groups. Used by a partial aggregation over raw input that
+  /// has stopped aggregating because its input has few duplicate keys.
+  void toIntermediate(const RowVectorPtr& input, const RowVectorPtr& result);
+
   const HashLookup& hashLookup() const;
 
   /// Spills content until under 'targetRows' and under 'targetBytes'
@@ -79,7 +86,11 @@ class GroupingSet {
 
   /// Returns the spiller stats including total bytes and rows spilled so far.
   Spiller::Stats spilledStats() const {
-    return spiller_ != nullptr ? spiller_->stats() : Spiller::Stats{};
+    auto stats = finishedSpillStats_;
+    if (spiller_ != nullptr) {
+      stats += spiller_->stats();
+    }
+    return stats;
   }
 
   /// Returns the hashtable stats.
@@ -134,6 +145,11 @@ class GroupingSet {
   // the max number of output rows in 'result'.
   bool getOutputWithSpill(int32_t batchSize, const RowVectorPtr& result);
 
+  // Clears the spill state after all spilled output of a group of pre-grouped
+  // keys is produced. The next group is accumulated in a new hash table and
+  // spills to new files.
+  void resetSpill();
+
   // Reads rows from the current spilled partition until producing a batch of
   // final results in 'result'. Returns false and leaves 'result' empty when
   // the partition is fully read. 'batchSize' specifies the max number of output
@@ -206,6 +222,12 @@ class GroupingSet {
   // aggregation
   HashStringAllocator stringAllocator_;
   AllocationPool rows_;
+
+  // Single row groups for toIntermediate(). The rows have the layout of the
+  // rows of 'table_', which the aggregates' offsets refer to.
+  AllocationPool intermediateRows_;
+  std::vector<char*> intermediateGroups_;
+  std::vector<vector_size_t> intermediateRowNumbers_;
   const bool isAdaptive_;
 
   bool noMoreInput_{false};
@@ -259,6 +281,10 @@ class GroupingSet {
   // 'table_' when starting to read spill output.
   std::unique_ptr<RowContainer> rowsWhileReadingSpill_;
 
+  // The spill stats of the groups of pre-grouped keys whose output is
+  // produced.
+  Spiller::Stats finishedSpillStats_;
+
   // Counts input batches and triggers spilling if folly hash of this % 100 <=
   // 'testSpillPct_';.
   uint64_t spillTestCounter_{0};
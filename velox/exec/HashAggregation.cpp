@@ -42,10 +42,20 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().partialAggregationGoodPct()),
       maxExtendedPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxExtendedPartialAggregationMemoryUsage()),
+      abandonPartialAggregationMinRows_(
+          driverCtx->queryConfig().abandonPartialAggregationMinRows()),
+      abandonPartialAggregationMinPct_(
+          driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      canAbandonPartialAggregation_(
+          aggregationNode->step() == core::AggregationNode::Step::kPartial &&
+          !isGlobal_ && aggregationNode->preGroupedKeys().empty() &&
+          !aggregationNode->ignoreNullKeys() &&
+          abandonPartialAggregationMinRows_ > 0),
       spillConfig_(
           aggregationNode->canSpill(driverCtx->queryConfig())
               ? operatorCtx_->makeSpillConfig(Spiller::Type::kAggregate)
               : std::nullopt),
+      streamDistinct_(isDistinct_ && !spillConfig_.has_value()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {
   VELOX_CHECK_NOT_NULL(memoryTracker_, "Memory usage tracker is not set");
@@ -166,33 +176,54 @@ HashAggregation::HashAggregation(
       operatorCtx_.get());
 }
 
+void HashAggregation::updateRuntimeStats() {
+  const auto spillStats = groupingSet_->spilledStats();
+  const auto hashTableStats = groupingSet_->hashTableStats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledUncompressedBytes = spillStats.spilledUncompressedBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+
+  lockedStats->runtimeStats["hashtable.capacity"] =
+      RuntimeMetric(hashTableStats.capacity);
+  lockedStats->runtimeStats["hashtable.numRehashes"] =
+      RuntimeMetric(hashTableStats.numRehashes);
+  lockedStats->runtimeStats["hashtable.numDistinct"] =
+      RuntimeMetric(hashTableStats.numDistinct);
+  if (hashTableStats.numTombstones != 0) {
+    lockedStats->runtimeStats["hashtable.numTombstones"] =
+        RuntimeMetric(hashTableStats.numTombstones);
+  }
+}
+
+void HashAggregation::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+  // Once all input is received the output is produced from the hash table or
+  // the spill files. Neither state can be spilled.
+  if (noMoreInput_ || groupingSet_ == nullptr ||
+      groupingSet_->numRows() == 0) {
+    return;
+  }
+  groupingSet_->spill(0, 0);
+  updateRuntimeStats();
+  memoryTracker_->release();
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
+  if (abandonedPartialAggregation_) {
+    // The rows are converted in getOutput().
+    input_ = input;
+    return;
+  }
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
-  {
-    const auto spillStats = groupingSet_->spilledStats();
-    const auto hashTableStats = groupingSet_->hashTableStats();
-    auto lockedStats = stats_.wlock();
-    lockedStats->spilledBytes = spillStats.spilledBytes;
-    lockedStats->spilledRows = spillStats.spilledRows;
-    lockedStats->spilledPartitions = spillStats.spilledPartitions;
-    lockedStats->spilledFiles = spillStats.spilledFiles;
-
-    lockedStats->runtimeStats["hashtable.capacity"] =
-        RuntimeMetric(hashTableStats.capacity);
-    lockedStats->runtimeStats["hashtable.numRehashes"] =
-        RuntimeMetric(hashTableStats.numRehashes);
-    lockedStats->runtimeStats["hashtable.numDistinct"] =
-        RuntimeMetric(hashTableStats.numDistinct);
-    if (hashTableStats.numTombstones != 0) {
-      lockedStats->runtimeStats["hashtable.numTombstones"] =
-          RuntimeMetric(hashTableStats.numTombstones);
-    }
-  }
+  updateRuntimeStats();
 
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
@@ -202,7 +233,13 @@ void HashAggregation::addInput(RowVectorPtr input) {
     partialFull_ = true;
   }
 
-  if (isDistinct_) {
+  // Flush early if the aggregation does not reduce the input. The flush
+  // abandons the partial aggregation.
+  if (abandonPartialAggregation(groupingSet_->numRows())) {
+    partialFull_ = true;
+  }
+
+  if (streamDistinct_) {
     newDistincts_ = !groupingSet_->hashLookup().newGroups.empty();
 
     if (newDistincts_) {
@@ -239,13 +276,23 @@ void HashAggregation::resetPartialOutputIfNeed() {
   }
   groupingSet_->resetPartial();
   partialFull_ = false;
+  if (!finished_ && abandonPartialAggregation(numOutputRows_)) {
+    abandonedPartialAggregation_ = true;
+    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  }
   numOutputRows_ = 0;
   numInputRows_ = 0;
-  if (!finished_) {
+  if (!finished_ && !abandonedPartialAggregation_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
 }
 
+bool HashAggregation::abandonPartialAggregation(int64_t numGroups) const {
+  return canAbandonPartialAggregation_ &&
+      numInputRows_ >= abandonPartialAggregationMinRows_ &&
+      100 * numGroups >= abandonPartialAggregationMinPct_ * numInputRows_;
+}
+
 void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     double aggregationPct) {
   VELOX_DCHECK(isPartialOutput_);
@@ -283,6 +330,10 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
 
+  if (abandonedPartialAggregation_) {
+    return getAbandonedPartialOutput();
+  }
+
   // Produce results if one of the following is true:
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
@@ -294,11 +345,13 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
 
-  if (isDistinct_) {
+  if (streamDistinct_) {
     if (!newDistincts_) {
       if (noMoreInput_) {
         finished_ = true;
       }
+      // All distinct keys are already returned.
+      resetPartialOutputIfNeed();
       return nullptr;
     }
 
@@ -337,6 +390,27 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+RowVectorPtr HashAggregation::getAbandonedPartialOutput() {
+  if (input_ == nullptr) {
+    if (noMoreInput_) {
+      finished_ = true;
+    }
+    return nullptr;
+  }
+  const auto numRows = input_->size();
+  RowVectorPtr output;
+  if (isDistinct_) {
+    output = fillOutput(numRows, nullptr);
+  } else {
+    output = std::static_pointer_cast<RowVector>(
+        BaseVector::create(outputType_, numRows, pool()));
+    groupingSet_->toIntermediate(input_, output);
+  }
+  input_ = nullptr;
+  addRuntimeStat("abandonedPartialAggregationRows", RuntimeCounter(numRows));
+  return output;
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -32,7 +32,8 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ &&
+        !(abandonedPartialAggregation_ && input_ != nullptr);
   }
 
   void noMoreInput() override {
@@ -51,7 +52,16 @@ class HashAggregation : public Operator {
     groupingSet_.reset();
   }
 
+  bool canReclaim() const override {
+    return spillConfig_.has_value();
+  }
+
+  void reclaim(uint64_t targetBytes) override;
+
  private:
+  // Copies the spill and hash table stats to the operator stats.
+  void updateRuntimeStats();
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -64,6 +74,15 @@ class HashAggregation : public Operator {
   // measure of the effectiveness of the partial aggregation.
   void maybeIncreasePartialAggregationMemoryUsage(double aggregationPct);
 
+  // Returns true if the partial aggregation has seen enough input rows since
+  // the last flush to tell that 'numGroups' groups are too many to be worth
+  // aggregating.
+  bool abandonPartialAggregation(int64_t numGroups) const;
+
+  // Returns the intermediate results of 'input_' without aggregation after
+  // the partial aggregation is abandoned.
+  RowVectorPtr getAbandonedPartialOutput();
+
   // Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
@@ -73,12 +92,24 @@ class HashAggregation : public Operator {
   const std::shared_ptr<memory::MemoryUsageTracker> memoryTracker_;
   const double partialAggregationGoodPct_;
   const int64_t maxExtendedPartialAggregationMemoryUsage_;
+  const int64_t abandonPartialAggregationMinRows_;
+  const int32_t abandonPartialAggregationMinPct_;
+  // True if this is a partial aggregation over raw input with grouping keys
+  // whose input rows can be turned into intermediate results one by one.
+  const bool canAbandonPartialAggregation_;
   const std::optional<Spiller::Config> spillConfig_;
+  // True if a distinct aggregation returns the new keys of each input batch.
+  // A spillable distinct aggregation returns its keys after all input since
+  // a spilled key is new again when it reappears in later input.
+  const bool streamDistinct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
   bool partialFull_ = false;
+  // True if the partial aggregation has stopped aggregating. Each input row
+  // is then output as an intermediate result of its own.
+  bool abandonedPartialAggregation_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
   RowContainerIterator resultIterator_;
@@ -15,7 +15,10 @@
  */
 
 #include "velox/exec/HashBuild.h"
+#include "velox/common/base/BloomFilter.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/connectors/Connector.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -41,6 +44,84 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+// Bloom filter over the hashes of join keys. The bits are allocated from the
+// pool of the HashBuild operator.
+using KeyBloomFilter = BloomFilter<false, memory::StlAllocator<uint64_t>>;
+
+// Adds the hashes of the non-null values of the first 'numRows' rows of flat
+// 'keys' to 'bloomFilter'.
+template <typename T>
+void addToBloomFilter(
+    const VectorPtr& keys,
+    vector_size_t numRows,
+    KeyBloomFilter& bloomFilter) {
+  const auto* values = keys->asFlatVector<T>();
+  for (auto row = 0; row < numRows; ++row) {
+    if (values->isNullAt(row)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = values->valueAt(row);
+      bloomFilter.insert(common::ValuesUsingBloomFilter::hashBytes(
+          value.data(), value.size()));
+    } else {
+      bloomFilter.insert(
+          common::ValuesUsingBloomFilter::hashInt64(values->valueAt(row)));
+    }
+  }
+}
+
+// Returns true if a dynamic filter on column 'name' of the output of 'node'
+// can be pushed down to a TableScan. Follows the column through filters,
+// identity projections and the probe sides of other joins like
+// Driver::canPushdownFilters() does for the operators.
+bool canPushdownToScan(
+    const core::PlanNodePtr& node,
+    const std::string& name) {
+  if (auto scan = dynamic_cast<const core::TableScanNode*>(node.get())) {
+    return connector::getConnector(scan->tableHandle()->connectorId())
+        ->canAddDynamicFilter();
+  }
+  if (dynamic_cast<const core::FilterNode*>(node.get())) {
+    return canPushdownToScan(node->sources()[0], name);
+  }
+  if (auto project = dynamic_cast<const core::ProjectNode*>(node.get())) {
+    const auto& names = project->names();
+    for (auto i = 0; i < names.size(); ++i) {
+      if (names[i] != name) {
+        continue;
+      }
+      auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(
+          project->projections()[i].get());
+      if (field == nullptr || !field->inputs().empty()) {
+        return false;
+      }
+      return canPushdownToScan(node->sources()[0], field->name());
+    }
+    return false;
+  }
+  if (auto join = dynamic_cast<const core::HashJoinNode*>(node.get())) {
+    const auto& probeSource = join->sources()[0];
+    return probeSource->outputType()->containsChild(name) &&
+        canPushdownToScan(probeSource, name);
+  }
+  return false;
+}
+
+bool isBloomFilterKeyType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -160,6 +241,9 @@ void HashBuild::setupTable() {
           pool());
     }
   }
+  table_->setPartitionedProbe(operatorCtx_->driverCtx()
+                                  ->queryConfig()
+                                  .hashProbePartitioningEnabled());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -203,7 +287,8 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.compressionKind);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -639,6 +724,36 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
   }
 }
 
+void HashBuild::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+  if (spiller_ == nullptr || !isRunning() || noMoreInput_ ||
+      isInputFromSpill() || spiller_->isAllSpilled()) {
+    return;
+  }
+  spillGroup_->reclaim(&HashBuild::runReclaim);
+}
+
+// static
+void HashBuild::runReclaim(const std::vector<Operator*>& spillOperators) {
+  for (auto* spillOp : spillOperators) {
+    HashBuild* build = dynamic_cast<HashBuild*>(spillOp);
+    VELOX_CHECK_NOT_NULL(build);
+    auto* spiller = build->spiller_.get();
+    if (spiller == nullptr || spiller->isAllSpilled()) {
+      continue;
+    }
+    const uint32_t numPartitions = spiller->hashBits().numPartitions();
+    std::vector<Spiller::SpillableStats> spillableStats(numPartitions);
+    spiller->fillSpillRuns(spillableStats);
+    SpillPartitionNumSet partitions;
+    for (uint32_t partition = 0; partition < numPartitions; ++partition) {
+      partitions.insert(partition);
+    }
+    spiller->spill(partitions);
+    build->pool()->getMemoryUsageTracker()->release();
+  }
+}
+
 void HashBuild::addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes) {
   numRows += numSpillRows_;
   numSpillRows_ = 0;
@@ -718,6 +833,8 @@ bool HashBuild::finishHashBuild() {
         {
           auto lockedStats = stats_.wlock();
           lockedStats->spilledBytes += spillStats.spilledBytes;
+          lockedStats->spilledUncompressedBytes +=
+              spillStats.spilledUncompressedBytes;
           lockedStats->spilledRows += spillStats.spilledRows;
           lockedStats->spilledPartitions += spillStats.spilledPartitions;
           lockedStats->spilledFiles += spillStats.spilledFiles;
@@ -736,16 +853,26 @@ bool HashBuild::finishHashBuild() {
       // https://github.com/facebookincubator/velox/issues/3567 is fixed.
       const bool allowPrallelJoinBuild =
           !otherTables.empty() && spillPartitions.empty();
+      const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
       table_->prepareJoinTable(
           std::move(otherTables),
           allowPrallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
-                                : nullptr);
+                                : nullptr,
+          queryConfig.hashProbeBloomFilterEnabled());
+
+      // The probe side does not push down dynamic filters if there is spilled
+      // data.
+      std::vector<std::shared_ptr<common::Filter>> keyBloomFilters;
+      if (spillPartitions.empty() && !isInputFromSpill()) {
+        keyBloomFilters = makeKeyBloomFilters();
+      }
 
       addRuntimeStats();
       if (joinBridge_->setHashTable(
               std::move(table_),
               std::move(spillPartitions),
-              joinHasNullKeys_)) {
+              joinHasNullKeys_,
+              std::move(keyBloomFilters))) {
         spillGroup_->restart();
       }
     }
@@ -820,6 +947,85 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeKeyBloomFilters() {
+  if (!operatorCtx_->driverCtx()->queryConfig().hashJoinBloomFilterEnabled() ||
+      table_->hashMode() != BaseHashTable::HashMode::kHash ||
+      table_->numDistinct() == 0 ||
+      table_->numDistinct() > kMaxBloomFilterEntries) {
+    return {};
+  }
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return {};
+  }
+
+  // Makes filters only for the keys that some probe side scan can accept. The
+  // filters are allocated from the pool of 'this', like the table.
+  const auto& keyTypes = table_->rows()->keyTypes();
+  const auto& probeKeys = joinNode_->leftKeys();
+  const auto& probeSource = joinNode_->sources()[0];
+  memory::StlAllocator<uint64_t> allocator(*pool());
+  std::vector<std::shared_ptr<KeyBloomFilter>> bloomFilters(keyTypes.size());
+  bool hasBloomFilter = false;
+  for (auto i = 0; i < keyTypes.size(); ++i) {
+    if (isBloomFilterKeyType(keyTypes[i]->kind()) &&
+        canPushdownToScan(probeSource, probeKeys[i]->name())) {
+      bloomFilters[i] = std::make_shared<KeyBloomFilter>(allocator);
+      bloomFilters[i]->reset(table_->numDistinct());
+      hasBloomFilter = true;
+    }
+  }
+  if (!hasBloomFilter) {
+    return {};
+  }
+
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> rows(kBatchSize);
+  std::vector<VectorPtr> keys(keyTypes.size());
+  BaseHashTable::RowsIterator iter;
+  while (auto numRows = table_->listAllRows(
+             &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < keyTypes.size(); ++i) {
+      if (bloomFilters[i] == nullptr) {
+        continue;
+      }
+      if (keys[i] == nullptr) {
+        keys[i] = BaseVector::create(keyTypes[i], kBatchSize, pool());
+      }
+      table_->rows()->extractColumn(rows.data(), numRows, i, keys[i]);
+      switch (keyTypes[i]->kind()) {
+        case TypeKind::TINYINT:
+          addToBloomFilter<int8_t>(keys[i], numRows, *bloomFilters[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addToBloomFilter<int16_t>(keys[i], numRows, *bloomFilters[i]);
+          break;
+        case TypeKind::INTEGER:
+          addToBloomFilter<int32_t>(keys[i], numRows, *bloomFilters[i]);
+          break;
+        case TypeKind::BIGINT:
+          addToBloomFilter<int64_t>(keys[i], numRows, *bloomFilters[i]);
+          break;
+        default:
+          addToBloomFilter<StringView>(keys[i], numRows, *bloomFilters[i]);
+          break;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> keyFilters(keyTypes.size());
+  for (auto i = 0; i < keyTypes.size(); ++i) {
+    if (bloomFilters[i] != nullptr) {
+      keyFilters[i] = std::make_shared<common::ValuesUsingBloomFilter>(
+          [bloomFilter = std::move(bloomFilters[i])](uint64_t hash) {
+            return bloomFilter->mayContain(hash);
+          },
+          false);
+    }
+  }
+  return keyFilters;
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -79,7 +79,19 @@ class HashBuild final : public Operator {
 
   void close() override {}
 
+  bool canReclaim() const override {
+    return spillEnabled();
+  }
+
+  // Spills all the partitions of this and its peer operators so that the
+  // hash join can be built from consistently spilled partitions.
+  void reclaim(uint64_t targetBytes) override;
+
  private:
+  // Maximum number of distinct keys for building Bloom filters for dynamic
+  // filtering. The filters take 2 bytes per key, i.e. up to 8MB per join key.
+  static constexpr uint64_t kMaxBloomFilterEntries = 4 << 20;
+
   void setState(State state);
   void checkStateTransition(State state);
 
@@ -196,6 +208,10 @@ class HashBuild final : public Operator {
   // 'spillOperators'.
   void runSpill(const std::vector<Operator*>& spillOperators);
 
+  // The callback passed to 'spillGroup_' on reclaim to spill all the
+  // partitions of 'spillOperators'.
+  static void runReclaim(const std::vector<Operator*>& spillOperators);
+
   // Invoked by 'runSpill' to sum up the spill targets from all the operators in
   // 'numRows' and 'numBytes'.
   void addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes);
@@ -224,6 +240,14 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Returns a Bloom filter over the values of each join key of 'table_' to push
+  // down as a dynamic filter. Returns an empty vector if 'table_' is not in
+  // kHash mode, in which case the probe side makes the dynamic filters from
+  // the key hashers, or if the join type does not allow dynamic filters. The
+  // filter of a key is null if its type is not supported or if no scan on the
+  // probe side can accept a filter on the key.
+  std::vector<std::shared_ptr<common::Filter>> makeKeyBloomFilters();
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
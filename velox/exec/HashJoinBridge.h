@@ -37,11 +37,14 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'keyBloomFilters' is either empty
+  /// or has a Bloom filter over the values of each join key, which is null if
+  /// the key type is not supported.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> keyBloomFilters = {});
 
   void setAntiJoinHasNullKeys();
 
@@ -56,11 +59,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _keyBloomFilters)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          keyBloomFilters(std::move(_keyBloomFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -68,6 +73,9 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    // Bloom filters over the values of the join keys for dynamic filtering if
+    // the table is in kHash mode. Empty or null for a key if not built.
+    std::vector<std::shared_ptr<common::Filter>> keyBloomFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -263,7 +263,8 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.compressionKind);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -318,24 +319,32 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->keyBloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. In kHash mode, the filters are the Bloom filters
+    // made by the build side.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& keyBloomFilters = hashBuildResult->keyBloomFilters;
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() == BaseHashTable::HashMode::kHash) {
+        if (keyBloomFilters[i] != nullptr) {
+          dynamicFilters_.emplace(keyChannels_[i], keyBloomFilters[i]);
         }
+      } else if (auto filter = buildHashers[i]->getFilter(false)) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
   }
@@ -495,9 +504,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -594,6 +606,10 @@ void HashProbe::addInput(RowVectorPtr input) {
     activeRows_.applyToSelected(
         [&](auto row) { lookup_->rows.push_back(row); });
   }
+  if (useBloomFilter_ && table_->hasJoinBloomFilter() &&
+      !lookup_->rows.empty()) {
+    bloomFilterProbe();
+  }
 
   passingInputRowsInitialized_ = false;
   if (isLeftJoin(joinType_) || isFullJoin(joinType_) || isAntiJoin(joinType_) ||
@@ -626,6 +642,22 @@ void HashProbe::addInput(RowVectorPtr input) {
   results_.reset(*lookup_);
 }
 
+void HashProbe::bloomFilterProbe() {
+  const auto numInput = lookup_->rows.size();
+  table_->joinBloomFilterProbe(*lookup_);
+  const auto numPassed = lookup_->rows.size();
+  addRuntimeStat("bloomFilterProbeInputRows", RuntimeCounter(numInput));
+  addRuntimeStat("bloomFilterProbePassedRows", RuntimeCounter(numPassed));
+
+  bloomFilterInputRows_ += numInput;
+  bloomFilterPassedRows_ += numPassed;
+  if (bloomFilterInputRows_ >= kBloomFilterMinInputRows &&
+      bloomFilterPassedRows_ * 100 >
+          bloomFilterInputRows_ * kBloomFilterMaxPassedPct) {
+    useBloomFilter_ = false;
+  }
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -107,6 +107,10 @@ class HashProbe : public Operator {
       const std::optional<SpillPartitionId>& restoredSpillPartitionId,
       const SpillPartitionIdSet& spillPartitionIds);
 
+  // Removes the rows of 'lookup_' that miss the Bloom filter of 'table_'.
+  // Stops using the filter if most of the first rows pass it.
+  void bloomFilterProbe();
+
   // Sets up 'filter_' and related members.p
   void initializeFilter(
       const core::TypedExprPtr& filter,
@@ -306,6 +310,23 @@ class HashProbe : public Operator {
   // True if the join became a no-op after pushing down the filter.
   bool replacedWithDynamicFilter_{false};
 
+  // Minimum number of rows tested against the Bloom filter of 'table_' before
+  // deciding whether the filter pays off.
+  static constexpr int64_t kBloomFilterMinInputRows = 10'000;
+
+  // The Bloom filter of 'table_' is no longer used if more than this
+  // percentage of the tested rows pass it.
+  static constexpr int64_t kBloomFilterMaxPassedPct = 70;
+
+  // False once the Bloom filter of 'table_' has turned out to drop too few
+  // rows.
+  bool useBloomFilter_{true};
+
+  // The number of rows tested against and passing the Bloom filter of
+  // 'table_'.
+  int64_t bloomFilterInputRows_{0};
+  int64_t bloomFilterPassedRows_{0};
+
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
   // Table shared between other HashProbes in other Drivers of the
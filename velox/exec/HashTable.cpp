@@ -21,6 +21,7 @@
 #include "velox/common/process/ProcessBase.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/vector/VectorTypeUtils.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -509,6 +510,51 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::probePartitionBits(int32_t numRows) const {
+  if (!partitionedProbe_ || capacity_ < 2 * kProbePartitionSlots ||
+      numRows < 2 * kMinRowsPerProbePartition) {
+    return 0;
+  }
+  const int32_t tableBits = sizeBits_ - __builtin_ctzll(kProbePartitionSlots);
+  const int32_t rowBits =
+      31 - __builtin_clz(numRows / kMinRowsPerProbePartition);
+  return std::min({tableBits, rowBits, kMaxProbePartitionBits});
+}
+
+template <bool ignoreNullKeys>
+folly::Range<const vector_size_t*>
+HashTable<ignoreNullKeys>::partitionProbeRows(
+    HashLookup& lookup,
+    int32_t numBits) const {
+  // The bits of the hash number that select the slot are the low 'sizeBits_'
+  // bits. The top 'numBits' of these select the region.
+  const HashBitRange bitRange(sizeBits_ - numBits, sizeBits_);
+  const auto* hashes = lookup.hashes.data();
+  std::array<int32_t, (1 << kMaxProbePartitionBits) + 1> offsets{};
+  for (auto row : lookup.rows) {
+    ++offsets[bitRange.partition(hashes[row]) + 1];
+  }
+  for (auto i = 1; i <= bitRange.numPartitions(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  auto& partitionedRows = lookup.partitionedRows;
+  partitionedRows.resize(lookup.rows.size());
+  for (auto row : lookup.rows) {
+    partitionedRows[offsets[bitRange.partition(hashes[row])]++] = row;
+  }
+  return folly::Range<const vector_size_t*>(
+      partitionedRows.data(), partitionedRows.size());
+}
+
+template <bool ignoreNullKeys>
+FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::prefetchProbe(
+    uint64_t hash) const {
+  const auto offset = ProbeState::tagsByteOffset(hash, sizeMask_);
+  __builtin_prefetch(tags_ + offset);
+  __builtin_prefetch(table_ + offset);
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   if (hashMode_ == HashMode::kArray) {
@@ -521,25 +567,42 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
+  }
+  // Probing the rows region by region keeps the recently loaded tags and row
+  // pointers in cache for the next rows. Prefetching the entries of the rows
+  // ahead overlaps the cache misses of a large table.
+  folly::Range<const vector_size_t*> rows(
+      lookup.rows.data(), lookup.rows.size());
+  if (auto numBits = probePartitionBits(rows.size())) {
+    rows = partitionProbeRows(lookup, numBits);
+  }
+  const bool prefetch = partitionedProbe_ && capacity_ >= kMinPrefetchSlots;
+  if (hashMode_ == HashMode::kNormalizedKey) {
+    joinNormalizedKeyProbe(lookup, rows, prefetch);
     return;
   }
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  int32_t numProbes = rows.size();
+  const uint64_t* hashes = lookup.hashes.data();
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    const auto prefetchIndex = probeIndex + kPrefetchDistance;
+    if (prefetch && prefetchIndex + 4 <= numProbes) {
+      for (auto i = 0; i < 4; ++i) {
+        prefetchProbe(hashes[rows[prefetchIndex + i]]);
+      }
+    }
     int32_t row = rows[probeIndex];
-    state1.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state1.preProbe(tags_, sizeMask_, hashes[row], row);
     row = rows[probeIndex + 1];
-    state2.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state2.preProbe(tags_, sizeMask_, hashes[row], row);
     row = rows[probeIndex + 2];
-    state3.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state3.preProbe(tags_, sizeMask_, hashes[row], row);
     row = rows[probeIndex + 3];
-    state4.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state4.preProbe(tags_, sizeMask_, hashes[row], row);
     state1.firstProbe(table_, 0);
     state2.firstProbe(table_, 0);
     state3.firstProbe(table_, 0);
@@ -551,17 +614,19 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
-    state1.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state1.preProbe(tags_, sizeMask_, hashes[row], row);
     state1.firstProbe(table_, 0);
     fullProbe<true>(lookup, state1, false);
   }
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
+void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(
+    HashLookup& lookup,
+    folly::Range<const vector_size_t*> rows,
+    bool prefetch) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  int32_t numProbes = rows.size();
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -570,6 +635,12 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    const auto prefetchIndex = probeIndex + kPrefetchDistance;
+    if (prefetch && prefetchIndex + 4 <= numProbes) {
+      for (auto i = 0; i < 4; ++i) {
+        prefetchProbe(hashes[rows[prefetchIndex + i]]);
+      }
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(tags_, sizeMask_, hashes[row], row);
     row = rows[probeIndex + 1];
@@ -593,7 +664,7 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
-    state1.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
+    state1.preProbe(tags_, sizeMask_, hashes[row], row);
     state1.firstProbe(table_, 0);
     hits[row] =
         state1.joinNormalizedKeyFullProbe(tags_, table_, sizeMask_, keys);
@@ -632,6 +703,7 @@ void HashTable<ignoreNullKeys>::clear() {
     memset(table_, 0, sizeof(char*) * capacity_);
   }
   numDistinct_ = 0;
+  joinBloomFilter_.reset();
 }
 
 template <bool ignoreNullKeys>
@@ -1388,7 +1460,8 @@ bool mayUseValueIds(const BaseHashTable& table) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::prepareJoinTable(
     std::vector<std::unique_ptr<BaseHashTable>> tables,
-    folly::Executor* FOLLY_NULLABLE executor) {
+    folly::Executor* FOLLY_NULLABLE executor,
+    bool buildBloomFilter) {
   buildExecutor_ = executor;
   otherTables_.reserve(tables.size());
   for (auto& table : tables) {
@@ -1431,6 +1504,77 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
   } else {
     decideHashMode(0);
   }
+  if (buildBloomFilter && hashMode_ == HashMode::kHash &&
+      numDistinct_ >= kMinJoinBloomFilterRows) {
+    buildJoinBloomFilter();
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildJoinBloomFilter() {
+  joinBloomFilter_.emplace(memory::StlAllocator<uint64_t>(*rows_->pool()));
+  joinBloomFilter_->reset(std::min(numDistinct_, kMaxJoinBloomFilterRows));
+  if (buildExecutor_ == nullptr || otherTables_.empty()) {
+    addToJoinBloomFilter(*this, false);
+    for (auto& other : otherTables_) {
+      addToJoinBloomFilter(*other, false);
+    }
+    return;
+  }
+
+  // Each table holds the rows of one build operator. Hash these in parallel.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(steps, error, true);
+  });
+  for (auto i = 0; i <= otherTables_.size(); ++i) {
+    auto table = i == 0 ? this : otherTables_[i - 1].get();
+    steps.push_back(std::make_shared<AsyncSource<bool>>([this, table]() {
+      addToJoinBloomFilter(*table, true);
+      return std::make_unique<bool>(true);
+    }));
+    assert(!steps.empty()); // lint
+    buildExecutor_->add([step = steps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  syncWorkItems(steps, error);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::addToJoinBloomFilter(
+    HashTable<ignoreNullKeys>& table,
+    bool concurrent) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  RowContainerIterator iter;
+  while (auto numRows = table.rows_->listRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    hashRows(folly::Range<char**>(rows.data(), numRows), false, hashes);
+    if (concurrent) {
+      for (auto i = 0; i < numRows; ++i) {
+        joinBloomFilter_->insertConcurrent(hashes[i]);
+      }
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        joinBloomFilter_->insert(hashes[i]);
+      }
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinBloomFilterProbe(
+    HashLookup& lookup) const {
+  VELOX_DCHECK(joinBloomFilter_.has_value());
+  lookup.rows.resize(joinBloomFilter_->filterRows(
+      lookup.hashes.data(), lookup.rows.data(), lookup.rows.size()));
 }
 
 template <bool ignoreNullKeys>
@@ -17,6 +17,7 @@
 
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -46,6 +47,9 @@ struct HashLookup {
   // corresponding group row.
   raw_vector<char*> hits;
   std::vector<vector_size_t> newGroups;
+  // 'rows' reordered by the region of the join table they probe. Scratch
+  // memory for HashTable::joinProbe.
+  raw_vector<vector_size_t> partitionedRows;
 };
 
 struct HashTableStats {
@@ -164,9 +168,29 @@ class BaseHashTable {
       uint64_t maxBytes,
       char* FOLLY_NULLABLE* FOLLY_NULLABLE rows) = 0;
 
+  /// Prepares 'this' for join probe. See HashTable::prepareJoinTable. If
+  /// 'buildBloomFilter' is true and the table ends up in kHash mode with
+  /// enough rows, also builds a Bloom filter over the hash numbers of the
+  /// keys. See joinBloomFilterProbe().
   virtual void prepareJoinTable(
       std::vector<std::unique_ptr<BaseHashTable>> tables,
-      folly::Executor* FOLLY_NULLABLE executor = nullptr) = 0;
+      folly::Executor* FOLLY_NULLABLE executor = nullptr,
+      bool buildBloomFilter = false) = 0;
+
+  /// Returns true if prepareJoinTable() built a Bloom filter for 'this'.
+  virtual bool hasJoinBloomFilter() const = 0;
+
+  /// If 'enabled', joinProbe() partitions large batches of probe rows by
+  /// region of the table and prefetches the table entries of the rows ahead.
+  /// Off by default.
+  virtual void setPartitionedProbe(bool enabled) = 0;
+
+  /// Removes the rows of 'lookup.rows' whose hash number misses the Bloom
+  /// filter over the build side keys. These rows have no match in 'this'.
+  /// 'lookup.hashes' must be computed for kHash mode. The filter fits in cache
+  /// so that this is cheaper than joinProbe() for rows that miss. Requires
+  /// hasJoinBloomFilter().
+  virtual void joinBloomFilterProbe(HashLookup& lookup) const = 0;
 
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
@@ -380,7 +404,8 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // for each row: 1 byte per tag + sizeof(Entry) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return (1 + sizeof(char*)) * capacity_ + rows_->allocatedBytes();
+    return (1 + sizeof(char*)) * capacity_ + rows_->allocatedBytes() +
+        (joinBloomFilter_.has_value() ? joinBloomFilter_->sizeInBytes() : 0);
   }
 
   HashStringAllocator* FOLLY_NULLABLE stringAllocator() override {
@@ -424,7 +449,18 @@ class HashTable : public BaseHashTable {
   // and VectorHashers and decides the hash mode and representation.
   void prepareJoinTable(
       std::vector<std::unique_ptr<BaseHashTable>> tables,
-      folly::Executor* FOLLY_NULLABLE executor = nullptr) override;
+      folly::Executor* FOLLY_NULLABLE executor = nullptr,
+      bool buildBloomFilter = false) override;
+
+  bool hasJoinBloomFilter() const override {
+    return joinBloomFilter_.has_value();
+  }
+
+  void setPartitionedProbe(bool enabled) override {
+    partitionedProbe_ = enabled;
+  }
+
+  void joinBloomFilterProbe(HashLookup& lookup) const override;
 
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
@@ -454,6 +490,7 @@ class HashTable : public BaseHashTable {
     setHashMode(mode, numNew);
   }
 
+
  private:
   // Returns the number of entries after which the table gets rehashed.
   static uint64_t rehashSize(int64_t size) {
@@ -601,8 +638,27 @@ class HashTable : public BaseHashTable {
   template <bool isJoin>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
-  // Shortcut for probe with normalized keys.
-  void joinNormalizedKeyProbe(HashLookup& lookup);
+  // Shortcut for probe with normalized keys. Probes 'rows' in order and
+  // prefetches the table entries of the rows ahead if 'prefetch' is true.
+  void joinNormalizedKeyProbe(
+      HashLookup& lookup,
+      folly::Range<const vector_size_t*> rows,
+      bool prefetch);
+
+  // Returns the number of hash bits that partition 'numRows' probe rows by
+  // the region of the table they start at. 0 if the table is small enough to
+  // stay in cache or there are too few rows for the partitions to matter.
+  int32_t probePartitionBits(int32_t numRows) const;
+
+  // Returns the rows of 'lookup' in the order of the 2^'numBits' regions of
+  // the table they start probing at. The rows are in
+  // 'lookup.partitionedRows'.
+  folly::Range<const vector_size_t*> partitionProbeRows(
+      HashLookup& lookup,
+      int32_t numBits) const;
+
+  // Prefetches the tags and row pointers a probe for 'hash' starts at.
+  void prefetchProbe(uint64_t hash) const;
 
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
@@ -625,6 +681,15 @@ class HashTable : public BaseHashTable {
       int32_t partitionEnd,
       std::vector<char*>* FOLLY_NULLABLE overflows);
 
+  // Fills 'joinBloomFilter_' with the hash numbers of the rows of 'this' and
+  // 'otherTables_'. The tables are hashed in parallel on 'buildExecutor_' if
+  // set.
+  void buildJoinBloomFilter();
+
+  // Adds the hash numbers of the rows of 'table' to 'joinBloomFilter_'.
+  // 'concurrent' is true if other threads add to the filter at the same time.
+  void addToJoinBloomFilter(HashTable<ignoreNullKeys>& table, bool concurrent);
+
   // Updates 'hashers_' to correspond to the keys in the
   // content. Returns true if all hashers offer a mapping to value ids
   // for array or normalized key.
@@ -679,6 +744,43 @@ class HashTable : public BaseHashTable {
   // execute the parallel build steps.
   folly::Executor* FOLLY_NULLABLE buildExecutor_{nullptr};
 
+  // Number of slots in a region of the table that probe rows are partitioned
+  // by. The tags and row pointers of 128K slots take about 1MB, the size of
+  // an L2 cache.
+  static constexpr int64_t kProbePartitionSlots = 128 << 10;
+
+  // Minimum average number of probe rows per region.
+  static constexpr int32_t kMinRowsPerProbePartition = 16;
+
+  // Maximum number of hash bits for partitioning probe rows.
+  static constexpr int32_t kMaxProbePartitionBits = 10;
+
+  // Minimum number of slots for prefetching table entries during join probe.
+  // The tags and row pointers of smaller tables mostly stay in cache.
+  static constexpr int64_t kMinPrefetchSlots = 1 << 20;
+
+  // Number of probe rows between prefetching and probing a row.
+  static constexpr int32_t kPrefetchDistance = 16;
+
+  // True if join probe may partition the probe rows and prefetch the table
+  // entries of the rows ahead. See probePartitionBits().
+  bool partitionedProbe_{false};
+
+  // Minimum number of rows of a kHash join table for building a Bloom filter.
+  // Smaller tables mostly stay in cache and are probed directly.
+  static constexpr int64_t kMinJoinBloomFilterRows = 128 << 10;
+
+  // Maximum number of rows a Bloom filter is sized for. At 2 bytes per row,
+  // this keeps the filter within 4MB. Larger tables get a filter with fewer
+  // bits per row and more false positives.
+  static constexpr int64_t kMaxJoinBloomFilterRows = 2 << 20;
+
+  // Bloom filter over the hash numbers of the keys of a kHash join table. Set
+  // by prepareJoinTable() if requested. The bits are allocated from the pool
+  // of 'rows_' and count towards allocatedBytes().
+  std::optional<BloomFilter<false, memory::StlAllocator<uint64_t>>>
+      joinBloomFilter_;
+
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 };
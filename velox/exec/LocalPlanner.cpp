@@ -29,6 +29,8 @@
 #include "velox/exec/Limit.h"
 #include "velox/exec/Merge.h"
 #include "velox/exec/MergeJoin.h"
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/NestedLoopJoinProbe.h"
 #include "velox/exec/OrderBy.h"
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/StreamingAggregation.h"
@@ -109,6 +111,13 @@ OperatorSupplier makeConsumerSupplier(
     };
   }
 
+  if (auto join =
+          std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(planNode)) {
+    return [join](int32_t operatorId, DriverCtx* ctx) {
+      return std::make_unique<NestedLoopJoinBuild>(operatorId, ctx, join);
+    };
+  }
+
   if (auto join =
           std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
     auto planNodeId = planNode->id();
@@ -191,8 +200,9 @@ uint32_t maxDrivers(const DriverFactory& driverFactory) {
     } else if (
         auto orderBy =
             std::dynamic_pointer_cast<const core::OrderByNode>(node)) {
-      // final orderby must run single-threaded
-      if (!orderBy->isPartial()) {
+      // final orderby must run single-threaded unless it sorts key ranges in
+      // parallel.
+      if (!orderBy->isPartial() && !orderBy->isParallel()) {
         return 1;
       }
     } else if (
@@ -340,6 +350,12 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
             std::dynamic_pointer_cast<const core::CrossJoinNode>(planNode)) {
       operators.push_back(
           std::make_unique<CrossJoinProbe>(id, ctx.get(), joinNode));
+    } else if (
+        auto joinNode =
+            std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(
+                planNode)) {
+      operators.push_back(
+          std::make_unique<NestedLoopJoinProbe>(id, ctx.get(), joinNode));
     } else if (
         auto aggregationNode =
             std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
@@ -34,8 +34,11 @@ MergeJoin::MergeJoin(
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()} {
   VELOX_USER_CHECK(
-      joinNode->isInnerJoin() || joinNode->isLeftJoin(),
-      "Merge join supports only inner and left joins. Other join types are not supported yet.");
+      joinNode->isInnerJoin() || joinNode->isLeftJoin() ||
+          joinNode->isRightJoin() || joinNode->isFullJoin() ||
+          joinNode->isLeftSemiFilterJoin() || joinNode->isAntiJoin(),
+      "Merge join supports only inner, left, right, full, left semi filter and anti joins: {}",
+      core::joinTypeName(joinType_));
 
   leftKeys_.reserve(numKeys_);
   rightKeys_.reserve(numKeys_);
@@ -69,9 +72,13 @@ MergeJoin::MergeJoin(
   if (joinNode->filter()) {
     initializeFilter(joinNode->filter(), leftType, rightType);
 
-    if (joinNode->isLeftJoin()) {
+    if (leftMissesInOutput() || joinNode->isLeftSemiFilterJoin()) {
       leftJoinTracker_ = LeftJoinTracker(outputBatchSize_, pool());
     }
+
+    if (rightMissesInOutput()) {
+      rightJoinTracker_ = RightJoinTracker(outputBatchSize_);
+    }
   }
 }
 
@@ -156,6 +163,53 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+bool hasNullKey(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t index) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->isNullAt(index)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+vector_size_t firstNonNull(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t start = 0) {
+  for (auto i = start; i < rowVector->size(); ++i) {
+    if (!hasNullKey(rowVector, keys, i)) {
+      return i;
+    }
+  }
+
+  return rowVector->size();
+}
+} // namespace
+
+int32_t MergeJoin::compare() const {
+  if (rightMissesInOutput()) {
+    if (hasNullKey(input_, leftKeys_, index_)) {
+      return -1;
+    }
+    if (hasNullKey(rightInput_, rightKeys_, rightIndex_)) {
+      return 1;
+    }
+  }
+  return compare(
+      leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
+}
+
+vector_size_t MergeJoin::nextRightIndex(vector_size_t start) const {
+  if (rightMissesInOutput()) {
+    return start;
+  }
+  return firstNonNull(rightInput_, rightKeys_, start);
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -223,6 +277,32 @@ void MergeJoin::addOutputRowForLeftJoin(
     leftJoinTracker_->addMiss(outputSize_);
   }
 
+  if (rightJoinTracker_) {
+    rightJoinTracker_->addMiss(outputSize_);
+  }
+
+  ++outputSize_;
+}
+
+void MergeJoin::addOutputRowForRightJoin(
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+
+  for (const auto& projection : leftProjections_) {
+    const auto& target = output_->childAt(projection.outputChannel);
+    target->setNull(outputSize_, true);
+  }
+
+  if (leftJoinTracker_) {
+    leftJoinTracker_->addMiss(outputSize_);
+  }
+
+  if (rightJoinTracker_) {
+    // Record right-side row with no match on the left side.
+    rightJoinTracker_->addMiss(outputSize_);
+  }
+
   ++outputSize_;
 }
 
@@ -300,8 +380,25 @@ void MergeJoin::prepareOutput() {
 }
 
 bool MergeJoin::addToOutput() {
+  if (!filter_) {
+    if (isAntiJoin(joinType_)) {
+      // Left-side rows with a match are not part of the output.
+      leftMatch_.reset();
+      rightMatch_.reset();
+      return false;
+    }
+
+    if (isLeftSemiFilterJoin(joinType_)) {
+      return addLeftMatchToOutput();
+    }
+  }
+
   prepareOutput();
 
+  if (rightJoinTracker_ && !leftMatch_->cursor) {
+    rightJoinTracker_->startMatch(rightMatch_.value());
+  }
+
   size_t firstLeftBatch;
   vector_size_t leftStartIndex;
   if (leftMatch_->cursor) {
@@ -342,39 +439,61 @@ bool MergeJoin::addToOutput() {
             rightMatch_->setCursor(r, j);
             return true;
           }
+          if (rightJoinTracker_) {
+            // Record right-side row with a match on the left-side.
+            rightJoinTracker_->addMatch(r, j, outputSize_);
+          }
           addOutputRow(left, i, right, j);
         }
       }
     }
   }
 
+  if (rightJoinTracker_) {
+    rightJoinTracker_->finishMatch();
+  }
+
   leftMatch_.reset();
   rightMatch_.reset();
 
   return outputSize_ == outputBatchSize_;
 }
 
-namespace {
-vector_size_t firstNonNull(
-    const RowVectorPtr& rowVector,
-    const std::vector<column_index_t>& keys,
-    vector_size_t start = 0) {
-  for (auto i = start; i < rowVector->size(); ++i) {
-    bool hasNull = false;
-    for (auto key : keys) {
-      if (rowVector->childAt(key)->isNullAt(i)) {
-        hasNull = true;
-        break;
+bool MergeJoin::addLeftMatchToOutput() {
+  prepareOutput();
+
+  size_t firstLeftBatch = 0;
+  vector_size_t leftStartIndex = leftMatch_->startIndex;
+  if (leftMatch_->cursor) {
+    firstLeftBatch = leftMatch_->cursor->batchIndex;
+    leftStartIndex = leftMatch_->cursor->index;
+  }
+
+  const size_t numLefts = leftMatch_->inputs.size();
+  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
+    const auto& left = leftMatch_->inputs[l];
+    const auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
+    const auto leftEnd =
+        l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+
+    for (auto i = leftStart; i < leftEnd; ++i) {
+      if (outputSize_ == outputBatchSize_) {
+        leftMatch_->setCursor(l, i);
+        // The right-side rows are not part of the output. Set the cursor to
+        // mark the match as in progress.
+        rightMatch_->setCursor(0, rightMatch_->startIndex);
+        return true;
       }
-    }
-    if (!hasNull) {
-      return i;
+      copyRow(left, i, output_, outputSize_, leftProjections_);
+      ++outputSize_;
     }
   }
 
-  return rowVector->size();
+  leftMatch_.reset();
+  rightMatch_.reset();
+
+  return outputSize_ == outputBatchSize_;
 }
-} // namespace
 
 RowVectorPtr MergeJoin::getOutput() {
   // Make sure to have is-blocked or needs-input as true if returning null
@@ -415,7 +534,7 @@ RowVectorPtr MergeJoin::getOutput() {
         }
 
         if (rightInput_) {
-          rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          rightIndex_ = nextRightIndex(0);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -444,6 +563,19 @@ RowVectorPtr MergeJoin::doGetOutput() {
     }
   }
 
+  // Add the right-side rows that failed the filter on all their matches.
+  if (rightJoinTracker_ && rightJoinTracker_->hasMisses()) {
+    prepareOutput();
+    while (rightJoinTracker_->hasMisses()) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+
+      auto [right, rightIndex] = rightJoinTracker_->nextMiss();
+      addOutputRowForRightJoin(right, rightIndex);
+    }
+  }
+
   // There is no output-in-progress match, but there could be incomplete
   // match.
   if (leftMatch_) {
@@ -474,8 +606,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
-        rightIndex_ =
-            firstNonNull(rightInput_, rightKeys_, rightMatch_->endIndex);
+        rightIndex_ = nextRightIndex(rightMatch_->endIndex);
         if (rightIndex_ == rightInput_->size()) {
           rightInput_ = nullptr;
         }
@@ -500,35 +631,49 @@ RowVectorPtr MergeJoin::doGetOutput() {
   }
 
   if (!input_ || !rightInput_) {
-    if (isLeftJoin(joinType_)) {
-      if (input_ && noMoreRightInput_) {
-        prepareOutput();
-        while (true) {
-          if (outputSize_ == outputBatchSize_) {
-            return std::move(output_);
-          }
+    if (leftMissesInOutput() && input_ && noMoreRightInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
 
-          addOutputRowForLeftJoin(input_, index_);
+        addOutputRowForLeftJoin(input_, index_);
 
-          ++index_;
-          if (index_ == input_->size()) {
-            // Ran out of rows on the left side.
-            input_ = nullptr;
-            return nullptr;
-          }
+        ++index_;
+        if (index_ == input_->size()) {
+          // Ran out of rows on the left side.
+          input_ = nullptr;
+          return nullptr;
+        }
+      }
+    }
+
+    if (rightMissesInOutput() && rightInput_ && noMoreInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+
+        ++rightIndex_;
+        if (rightIndex_ == rightInput_->size()) {
+          // Ran out of rows on the right side.
+          rightInput_ = nullptr;
+          return nullptr;
         }
       }
+    }
 
-      if (noMoreInput_ && output_) {
+    if (noMoreInput_ || noMoreRightInput_) {
+      if (output_) {
         output_->resize(outputSize_);
         return std::move(output_);
       }
-    } else {
-      if (noMoreInput_ || noMoreRightInput_) {
-        if (output_) {
-          output_->resize(outputSize_);
-          return std::move(output_);
-        }
+      if (noMoreRightInput_ && !leftMissesInOutput()) {
+        // The remaining left-side rows have no match.
         input_ = nullptr;
       }
     }
@@ -543,7 +688,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
-      if (isLeftJoin(joinType_)) {
+      if (leftMissesInOutput()) {
         prepareOutput();
 
         if (outputSize_ == outputBatchSize_) {
@@ -564,7 +709,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (rightMissesInOutput()) {
+        prepareOutput();
+
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+      }
+
+      rightIndex_ = nextRightIndex(rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -615,7 +770,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       index_ = endIndex;
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, endRightIndex);
+      rightIndex_ = nextRightIndex(endRightIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -643,8 +798,10 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
   auto rawIndices = indices->asMutable<vector_size_t>();
   vector_size_t numPassed = 0;
 
-  if (leftJoinTracker_) {
-    const auto& filterRows = leftJoinTracker_->matchingRows(numRows);
+  if (leftJoinTracker_ || rightJoinTracker_) {
+    const auto& filterRows = leftJoinTracker_
+        ? leftJoinTracker_->matchingRows(numRows)
+        : rightJoinTracker_->matchingRows(numRows);
 
     if (!filterRows.hasSelections()) {
       // No matches in the output, no need to evaluate the filter.
@@ -654,8 +811,13 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
     evaluateFilter(filterRows);
 
     // If all matches for a given left-side row fail the filter, add a row to
-    // the output with nulls for the right-side columns.
+    // the output with nulls for the right-side columns. Left semi joins drop
+    // such a row.
     auto onMiss = [&](auto row) {
+      if (isLeftSemiFilterJoin(joinType_)) {
+        return;
+      }
+
       rawIndices[numPassed++] = row;
 
       for (auto& projection : rightProjections_) {
@@ -669,21 +831,49 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
         const bool passed = !decodedFilterResult_.isNullAt(i) &&
             decodedFilterResult_.valueAt<bool>(i);
 
-        leftJoinTracker_->processFilterResult(i, passed, onMiss);
+        bool keep = passed;
+        if (leftJoinTracker_) {
+          const bool firstPassed =
+              leftJoinTracker_->processFilterResult(i, passed, onMiss);
+          if (isLeftSemiFilterJoin(joinType_)) {
+            // Output each left-side row once.
+            keep = firstPassed;
+          } else if (isAntiJoin(joinType_)) {
+            // Only left-side rows without a passing match are output.
+            keep = false;
+          }
+        }
+
+        if (rightJoinTracker_) {
+          rightJoinTracker_->processFilterResult(i, passed);
+        }
 
-        if (passed) {
+        if (keep) {
           rawIndices[numPassed++] = i;
         }
       } else {
-        // This row doesn't have a match on the right side. Keep it
+        // This row doesn't have a match on the other side. Keep it
         // unconditionally.
         rawIndices[numPassed++] = i;
       }
     }
 
-    if (!leftMatch_) {
+    // The output rows of the last left-side row continue in the next batch of
+    // output only if the output filled up in the middle of its matches.
+    // Otherwise, the last left-side row has all its filter results and
+    // 'onMiss' must be called while its output rows are in 'output'.
+    const bool leftRowContinues = leftMatch_ && leftMatch_->cursor &&
+        (rightMatch_->cursor->batchIndex != 0 ||
+         rightMatch_->cursor->index != rightMatch_->startIndex);
+    if (leftJoinTracker_ && !leftRowContinues) {
       leftJoinTracker_->noMoreFilterResults(onMiss);
     }
+
+    if (rightJoinTracker_) {
+      // Right-side rows that failed the filter on all their matches are added
+      // to the next batch of output.
+      rightJoinTracker_->noMoreFilterResults();
+    }
   } else {
     filterRows_.resize(numRows);
     filterRows_.setAll();
@@ -720,7 +910,65 @@ void MergeJoin::evaluateFilter(const SelectivityVector& rows) {
 }
 
 bool MergeJoin::isFinished() {
+  if (rightMissesInOutput()) {
+    // Right-side rows without a match are output after the left side is
+    // exhausted.
+    return noMoreInput_ && noMoreRightInput_ && output_ == nullptr &&
+        !(rightJoinTracker_ && rightJoinTracker_->hasMisses());
+  }
   return noMoreInput_ && input_ == nullptr;
 }
 
+void MergeJoin::RightJoinTracker::startMatch(const Match& match) {
+  MatchRows rows;
+  rows.inputs = match.inputs;
+  rows.startIndex = match.startIndex;
+  rows.endIndex = match.endIndex;
+  rows.batchOffsets.reserve(match.inputs.size());
+  vector_size_t offset = -match.startIndex;
+  for (const auto& input : match.inputs) {
+    rows.batchOffsets.push_back(offset);
+    offset += input->size();
+  }
+  rows.passed.resize(rows.batchOffsets.back() + match.endIndex, false);
+  matches_.push_back(std::move(rows));
+}
+
+void MergeJoin::RightJoinTracker::addMatch(
+    size_t batchIndex,
+    vector_size_t index,
+    vector_size_t outputIndex) {
+  VELOX_CHECK(!matches_.empty());
+  matchingRows_.setValid(outputIndex, true);
+  matchIndices_[outputIndex] = matches_.size() - 1;
+  rowNumbers_[outputIndex] = matches_.back().batchOffsets[batchIndex] + index;
+}
+
+void MergeJoin::RightJoinTracker::processFilterResult(
+    vector_size_t outputIndex,
+    bool passed) {
+  if (passed) {
+    matches_[matchIndices_[outputIndex]].passed[rowNumbers_[outputIndex]] =
+        true;
+  }
+}
+
+void MergeJoin::RightJoinTracker::noMoreFilterResults() {
+  while (!matches_.empty() && matches_.front().finished) {
+    const auto& rows = matches_.front();
+    const auto numInputs = rows.inputs.size();
+    for (auto i = 0; i < numInputs; ++i) {
+      const auto& input = rows.inputs[i];
+      const auto start = i == 0 ? rows.startIndex : 0;
+      const auto end = i == numInputs - 1 ? rows.endIndex : input->size();
+      for (auto j = start; j < end; ++j) {
+        if (!rows.passed[rows.batchOffsets[i] + j]) {
+          misses_.emplace_back(input, j);
+        }
+      }
+    }
+    matches_.pop_front();
+  }
+}
+
 } // namespace facebook::velox::exec
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <deque>
+
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
 
@@ -60,10 +62,11 @@ class MergeJoin : public Operator {
       vector_size_t otherIndex);
 
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
-  int32_t compare() const {
-    return compare(
-        leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
-  }
+  // In right and full joins the right side keeps the rows with null keys, which
+  // match no row. A null key on the left compares as less and a null key on
+  // the right as greater, so that the side with the null key advances and
+  // outputs the row as a miss.
+  int32_t compare() const;
 
   // Compare two rows on the left: index_ and index.
   int32_t compareLeft(vector_size_t index) const {
@@ -147,6 +150,24 @@ class MergeJoin : public Operator {
       const RowVectorPtr& input,
       const std::vector<column_index_t>& keys);
 
+  /// Returns the first row of 'rightInput_' at or after 'start' to process.
+  /// Rows with null keys match no row and are skipped unless they need to be
+  /// output in right and full joins.
+  vector_size_t nextRightIndex(vector_size_t start) const;
+
+  /// True if the left-side rows without a match are added to the output, i.e.
+  /// in left, full and anti joins.
+  bool leftMissesInOutput() const {
+    return isLeftJoin(joinType_) || isFullJoin(joinType_) ||
+        isAntiJoin(joinType_);
+  }
+
+  /// True if the right-side rows without a match are added to the output, i.e.
+  /// in right and full joins.
+  bool rightMissesInOutput() const {
+    return isRightJoin(joinType_) || isFullJoin(joinType_);
+  }
+
   /// Initialize 'output_' vector using 'ouputType_' and 'outputBatchSize_' if
   /// it is null.
   void prepareOutput();
@@ -160,6 +181,11 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Appends each row of leftMatch_ to output_ once. Used for left semi joins
+  // without a filter, where the right-side rows only need to exist. Returns
+  // true if output_ is full.
+  bool addLeftMatchToOutput();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
@@ -180,6 +206,13 @@ class MergeJoin : public Operator {
       const RowVectorPtr& left,
       vector_size_t leftIndex);
 
+  /// Adds one row of output for a right-side row with no left-side match.
+  /// Copies values from the 'rightIndex' row of 'right' and fills in nulls
+  /// for columns that correspond to the left side.
+  void addOutputRowForRightJoin(
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
   /// Evaluates join filter on 'filterInput_' and returns 'output' that contains
   /// a subset of rows on which the filter passed. Returns nullptr if no rows
   /// passed the filter.
@@ -261,9 +294,10 @@ class MergeJoin : public Operator {
     /// with the first row. Calls 'onMiss' if the filter failed on all output
     /// rows that correspond to a single left-side row. Use
     /// 'noMoreFilterResults' to make sure 'onMiss' is called for the last
-    /// left-side row.
+    /// left-side row. Returns true if this is the first row for its left-side
+    /// row that passed the filter. Left semi joins output only that row.
     template <typename TOnMiss>
-    void processFilterResult(
+    bool processFilterResult(
         vector_size_t outputIndex,
         bool passed,
         TOnMiss onMiss) {
@@ -279,9 +313,11 @@ class MergeJoin : public Operator {
         currentRow_ = outputIndex;
       }
 
+      const bool firstPassed = passed && !currentRowPassed_;
       if (passed) {
         currentRowPassed_ = true;
       }
+      return firstPassed;
     }
 
     /// Called when all rows from the current output batch are processed and the
@@ -335,6 +371,112 @@ class MergeJoin : public Operator {
 
   std::optional<LeftJoinTracker> leftJoinTracker_{std::nullopt};
 
+  /// In right and full joins with a filter, we track for each right-side row
+  /// of a set of rows with matching keys whether any of its output rows passed
+  /// the filter. The output rows of a match may span several batches of
+  /// output, so we can tell which right-side rows failed the filter on all
+  /// their matches only once the last batch with rows of the match has been
+  /// filtered. These rows are then added to the next batch of output with
+  /// nulls for the left-side columns.
+  class RightJoinTracker {
+   public:
+    explicit RightJoinTracker(vector_size_t numRows)
+        : matchingRows_{numRows, false},
+          matchIndices_(numRows),
+          rowNumbers_(numRows) {}
+
+    /// Starts tracking the right-side rows of 'match'. Must be called before
+    /// the first row of output for 'match' is added.
+    void startMatch(const Match& match);
+
+    /// Records a row of output that corresponds to a match between a left-side
+    /// row and the 'index' row of the 'batchIndex' batch of the current
+    /// match.
+    void addMatch(
+        size_t batchIndex,
+        vector_size_t index,
+        vector_size_t outputIndex);
+
+    /// Records a row of output that is not a match between a left-side and a
+    /// right-side row.
+    void addMiss(vector_size_t outputIndex) {
+      matchingRows_.setValid(outputIndex, false);
+    }
+
+    /// Called after all rows of output for the current match have been added.
+    void finishMatch() {
+      VELOX_CHECK(!matches_.empty());
+      matches_.back().finished = true;
+    }
+
+    /// Returns a subset of "match" rows in [0, numRows) range that were
+    /// recorded by addMatch.
+    const SelectivityVector& matchingRows(vector_size_t numRows) {
+      matchingRows_.setValidRange(numRows, matchingRows_.size(), false);
+      matchingRows_.updateBounds();
+      return matchingRows_;
+    }
+
+    /// Called for each row that the filter was evaluated on.
+    void processFilterResult(vector_size_t outputIndex, bool passed);
+
+    /// Called when all rows of the current output batch are processed. Adds
+    /// the right-side rows of the finished matches that failed the filter on
+    /// all their output rows to the misses.
+    void noMoreFilterResults();
+
+    /// Returns true if there are right-side rows to add to the output with
+    /// nulls for the left-side columns.
+    bool hasMisses() const {
+      return !misses_.empty();
+    }
+
+    /// Returns the next right-side row to add to the output with nulls for
+    /// the left-side columns and removes it from the misses.
+    std::pair<RowVectorPtr, vector_size_t> nextMiss() {
+      auto miss = std::move(misses_.front());
+      misses_.pop_front();
+      return miss;
+    }
+
+   private:
+    /// The right-side rows of a set of rows with matching keys.
+    struct MatchRows {
+      std::vector<RowVectorPtr> inputs;
+      vector_size_t startIndex;
+      vector_size_t endIndex;
+
+      /// Added to a row index in the corresponding batch of 'inputs' to get the
+      /// row number within the match.
+      std::vector<vector_size_t> batchOffsets;
+
+      /// True for the rows that passed the filter for at least one left-side
+      /// row.
+      std::vector<bool> passed;
+
+      /// True if all output rows for the match have been added.
+      bool finished{false};
+    };
+
+    /// A subset of output rows where left side matched right side on the join
+    /// keys. Used in filter evaluation.
+    SelectivityVector matchingRows_;
+
+    /// The matches whose output rows have not all been filtered yet. Only the
+    /// last match may be unfinished.
+    std::deque<MatchRows> matches_;
+
+    /// For each "match" row of output, the index in 'matches_' and the row
+    /// number within that match of the right-side row.
+    std::vector<vector_size_t> matchIndices_;
+    std::vector<vector_size_t> rowNumbers_;
+
+    /// Right-side rows that failed the filter on all their output rows.
+    std::deque<std::pair<RowVectorPtr, vector_size_t>> misses_;
+  };
+
+  std::optional<RightJoinTracker> rightJoinTracker_{std::nullopt};
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Returns the conjuncts of 'expr'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+// Returns the channel of 'expr' in 'type' if 'expr' is a column of 'type'.
+std::optional<column_index_t> fieldChannel(
+    const core::TypedExprPtr& expr,
+    const RowType& type) {
+  auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn()) {
+    return std::nullopt;
+  }
+  return type.getChildIdxIfExists(field->name());
+}
+
+bool isRangeJoinKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::DATE:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+std::optional<RangeJoinKeys> findRangeJoinKeys(
+    const core::NestedLoopJoinNode& joinNode) {
+  if (joinNode.joinCondition() == nullptr) {
+    return std::nullopt;
+  }
+  const auto& probeType = *joinNode.sources()[0]->outputType();
+  const auto& buildType = *joinNode.sources()[1]->outputType();
+
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  flattenConjuncts(joinNode.joinCondition(), conjuncts);
+
+  // The probe channel with a lower bound and the probe channel with an upper
+  // bound.
+  std::optional<std::pair<column_index_t, column_index_t>> lower;
+  std::optional<std::pair<column_index_t, column_index_t>> upper;
+  for (const auto* call : conjuncts) {
+    const auto& inputs = call->inputs();
+    if (call->name() == "between" && inputs.size() == 3) {
+      auto probe = fieldChannel(inputs[0], probeType);
+      auto low = fieldChannel(inputs[1], buildType);
+      auto high = fieldChannel(inputs[2], buildType);
+      if (probe.has_value() && low.has_value() && high.has_value()) {
+        lower = {probe.value(), low.value()};
+        upper = {probe.value(), high.value()};
+      }
+      continue;
+    }
+    if (inputs.size() != 2) {
+      continue;
+    }
+    const bool greater = call->name() == "gt" || call->name() == "gte";
+    const bool less = call->name() == "lt" || call->name() == "lte";
+    if (!greater && !less) {
+      continue;
+    }
+    // Normalizes 'build <op> probe' to 'probe <reversed op> build'.
+    auto probe = fieldChannel(inputs[0], probeType);
+    auto build = fieldChannel(inputs[1], buildType);
+    bool probeGreater = greater;
+    if (!probe.has_value() || !build.has_value()) {
+      probe = fieldChannel(inputs[1], probeType);
+      build = fieldChannel(inputs[0], buildType);
+      probeGreater = less;
+    }
+    if (!probe.has_value() || !build.has_value()) {
+      continue;
+    }
+    if (probeGreater) {
+      lower = {probe.value(), build.value()};
+    } else {
+      upper = {probe.value(), build.value()};
+    }
+  }
+
+  if (!lower.has_value() || !upper.has_value() ||
+      lower->first != upper->first) {
+    return std::nullopt;
+  }
+  const auto& probeKeyType = probeType.childAt(lower->first);
+  if (!isRangeJoinKeyType(probeKeyType) ||
+      !probeKeyType->equivalent(*buildType.childAt(lower->second)) ||
+      !probeKeyType->equivalent(*buildType.childAt(upper->second))) {
+    return std::nullopt;
+  }
+  return RangeJoinKeys{lower->first, lower->second, upper->second};
+}
+
+void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!buildVectors_.has_value(), "setData may be called only once");
+    buildVectors_ = std::move(buildVectors);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting data after the build side is aborted");
+  if (buildVectors_.has_value()) {
+    return buildVectors_;
+  }
+  promises_.emplace_back("NestedLoopJoinBridge::dataOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+NestedLoopJoinBuild::NestedLoopJoinBuild(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    std::shared_ptr<const core::NestedLoopJoinNode> joinNode)
+    : Operator(
+          driverCtx,
+          nullptr,
+          operatorId,
+          joinNode->id(),
+          "NestedLoopJoinBuild"),
+      rangeJoinKeys_(findRangeJoinKeys(*joinNode)) {}
+
+void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
+  if (input->size() > 0) {
+    // Load lazy vectors before storing.
+    for (auto& child : input->children()) {
+      child->loadedVector();
+    }
+    dataVectors_.emplace_back(std::move(input));
+  }
+}
+
+BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return BlockingReason::kWaitForJoinBuild;
+}
+
+void NestedLoopJoinBuild::noMoreInput() {
+  Operator::noMoreInput();
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last Driver to hit NestedLoopJoinBuild::finish gathers the data from
+  // all build Drivers and hands it over to the probe side. At this point all
+  // build Drivers are continued and will free their state. allPeersFinished
+  // is true only for the last Driver of the build pipeline.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  for (auto& peer : peers) {
+    auto op = peer->findOperator(planNodeId());
+    auto* build = dynamic_cast<NestedLoopJoinBuild*>(op);
+    VELOX_CHECK_NOT_NULL(build);
+    dataVectors_.insert(
+        dataVectors_.begin(),
+        build->dataVectors_.begin(),
+        build->dataVectors_.end());
+  }
+
+  // Realize the promises so that the other Drivers (which were not
+  // the last to finish) can continue from the barrier and finish.
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+
+  if (rangeJoinKeys_.has_value()) {
+    sortByLowerBound();
+  }
+
+  operatorCtx_->task()
+      ->getNestedLoopJoinBridge(
+          operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+      ->setData(std::move(dataVectors_));
+}
+
+void NestedLoopJoinBuild::sortByLowerBound() {
+  vector_size_t numRows = 0;
+  for (const auto& vector : dataVectors_) {
+    numRows += vector->size();
+  }
+  if (numRows == 0) {
+    return;
+  }
+
+  const auto& type = dataVectors_[0]->type();
+  auto data = BaseVector::create(type, numRows, pool());
+  vector_size_t offset = 0;
+  for (const auto& vector : dataVectors_) {
+    data->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+  }
+
+  const auto& rowData = data->asUnchecked<RowVector>();
+  const auto& lower = rowData->childAt(rangeJoinKeys_->lowerChannel);
+  const auto& upper = rowData->childAt(rangeJoinKeys_->upperChannel);
+  std::vector<vector_size_t> rows(numRows);
+  std::iota(rows.begin(), rows.end(), 0);
+  // A row with a null bound matches no probe row.
+  auto nonNullEnd =
+      std::stable_partition(rows.begin(), rows.end(), [&](auto row) {
+        return !lower->isNullAt(row) && !upper->isNullAt(row);
+      });
+  std::sort(rows.begin(), nonNullEnd, [&](auto left, auto right) {
+    return lower->compare(lower.get(), left, right) < 0;
+  });
+
+  auto sorted = BaseVector::create(type, numRows, pool());
+  sorted->copy(data.get(), SelectivityVector(numRows), rows.data());
+  dataVectors_.clear();
+  dataVectors_.push_back(std::static_pointer_cast<RowVector>(sorted));
+}
+
+bool NestedLoopJoinBuild::isFinished() {
+  return !future_.valid() && noMoreInput_;
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/NestedLoopJoinProbe.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+NestedLoopJoinProbe::NestedLoopJoinProbe(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::NestedLoopJoinNode>& joinNode)
+    : Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "NestedLoopJoinProbe"),
+      outputBatchSize_{driverCtx->queryConfig().preferredOutputBatchSize()},
+      joinType_(joinNode->joinType()),
+      rangeJoinKeys_(findRangeJoinKeys(*joinNode)) {
+  auto probeType = joinNode->sources()[0]->outputType();
+  for (auto i = 0; i < probeType->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(probeType->nameOf(i));
+    if (outIndex.has_value()) {
+      identityProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+
+  auto buildType = joinNode->sources()[1]->outputType();
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto buildChannel = buildType->getChildIdxIfExists(outputType_->nameOf(i));
+    if (buildChannel.has_value()) {
+      buildProjections_.emplace_back(buildChannel.value(), i);
+    }
+  }
+
+  if (joinNode->joinCondition() != nullptr) {
+    initializeFilter(joinNode->joinCondition(), probeType, buildType);
+  }
+}
+
+void NestedLoopJoinProbe::initializeFilter(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<core::TypedExprPtr> filters = {filter};
+  joinCondition_ =
+      std::make_unique<ExprSet>(std::move(filters), operatorCtx_->execCtx());
+
+  column_index_t filterChannel = 0;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto& field : joinCondition_->expr(0)->distinctFields()) {
+    const auto& name = field->field();
+    auto channel = probeType->getChildIdxIfExists(name);
+    if (channel.has_value()) {
+      filterProbeProjections_.emplace_back(channel.value(), filterChannel++);
+      names.emplace_back(name);
+      types.emplace_back(probeType->childAt(channel.value()));
+      continue;
+    }
+    channel = buildType->getChildIdxIfExists(name);
+    if (channel.has_value()) {
+      filterBuildProjections_.emplace_back(channel.value(), filterChannel++);
+      names.emplace_back(name);
+      types.emplace_back(buildType->childAt(channel.value()));
+      continue;
+    }
+    VELOX_FAIL(
+        "Join condition field {} not in probe or build input",
+        field->toString());
+  }
+
+  filterInputType_ = ROW(std::move(names), std::move(types));
+}
+
+BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    // Waiting for the last probe Driver to collect 'buildMatched_'.
+    *future = std::move(future_);
+    return BlockingReason::kWaitForJoinProbe;
+  }
+
+  if (buildVectors_.has_value()) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  auto buildVectors =
+      operatorCtx_->task()
+          ->getNestedLoopJoinBridge(
+              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+          ->dataOrFuture(future);
+  if (!buildVectors.has_value()) {
+    return BlockingReason::kWaitForJoinBuild;
+  }
+
+  buildVectors_ = std::move(buildVectors);
+
+  if (buildVectors_->empty() && !needsProbeMismatch()) {
+    // Build side is empty. Inner and right joins return no rows. Terminate
+    // the pipeline early.
+    buildSideEmpty_ = true;
+  }
+
+  if (rangeJoinKeys_.has_value() && !buildVectors_->empty()) {
+    initializeRangeJoin();
+  }
+
+  if (needsBuildMismatch()) {
+    buildMatched_.resize(buildVectors_->size());
+    for (auto i = 0; i < buildVectors_->size(); ++i) {
+      buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
+    }
+  }
+
+  return BlockingReason::kNotBlocked;
+}
+
+void NestedLoopJoinProbe::initializeRangeJoin() {
+  // NestedLoopJoinBuild sorts the build rows into a single vector.
+  VELOX_CHECK_EQ(buildVectors_->size(), 1);
+  const auto& buildVector = buildVectors_.value()[0];
+  const auto& lower = buildVector->childAt(rangeJoinKeys_->lowerChannel);
+  const auto& upper = buildVector->childAt(rangeJoinKeys_->upperChannel);
+
+  numRangeRows_ = buildVector->size();
+  while (numRangeRows_ > 0 &&
+         (lower->isNullAt(numRangeRows_ - 1) ||
+          upper->isNullAt(numRangeRows_ - 1))) {
+    --numRangeRows_;
+  }
+
+  maxUpperRows_.resize(numRangeRows_);
+  for (auto row = 0; row < numRangeRows_; ++row) {
+    maxUpperRows_[row] = row == 0 ||
+            upper->compare(upper.get(), row, maxUpperRows_[row - 1]) > 0
+        ? row
+        : maxUpperRows_[row - 1];
+  }
+}
+
+void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
+  // In getOutput(), we are going to wrap input in dictionaries a few rows at a
+  // time. Since lazy vectors cannot be wrapped in different dictionaries, we
+  // are going to load them here.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  input_ = std::move(input);
+  if (needsProbeMismatch()) {
+    probeMatched_.resizeFill(input_->size(), false);
+    probeMismatchRow_ = 0;
+  }
+}
+
+RowVectorPtr NestedLoopJoinProbe::getOutput() {
+  if (!buildVectors_.has_value()) {
+    return nullptr;
+  }
+
+  while (input_ != nullptr) {
+    if (buildIndex_ < buildVectors_->size()) {
+      auto output = rangeJoinKeys_.has_value() ? getRangeJoinOutput()
+                                               : getCrossProductOutput();
+      if (output != nullptr) {
+        return output;
+      }
+      continue;
+    }
+    if (needsProbeMismatch()) {
+      if (auto output = getProbeMismatchOutput()) {
+        return output;
+      }
+    }
+    buildIndex_ = 0;
+    input_ = nullptr;
+  }
+
+  if (!noMoreInput_ || !needsBuildMismatch()) {
+    return nullptr;
+  }
+  if (!probeInputFinished_) {
+    finishProbeInput();
+  }
+  if (!lastProbe_) {
+    return nullptr;
+  }
+  return getBuildMismatchOutput();
+}
+
+RowVectorPtr NestedLoopJoinProbe::getCrossProductOutput() {
+  const auto buildVector = buildVectors_.value()[buildIndex_];
+  const vector_size_t buildSize = buildVector->size();
+  const vector_size_t inputSize = input_->size();
+
+  // Pairs one probe row with a range of a large build vector or a range of
+  // probe rows with a whole small build vector.
+  vector_size_t numProbeRows;
+  vector_size_t numBuildRows;
+  if (buildSize > outputBatchSize_) {
+    numProbeRows = 1;
+    numBuildRows =
+        std::min<vector_size_t>(outputBatchSize_, buildSize - buildRow_);
+  } else {
+    numProbeRows = std::min<vector_size_t>(
+        outputBatchSize_ / buildSize, inputSize - probeRow_);
+    numBuildRows = buildSize;
+  }
+
+  const vector_size_t numCombinations = numProbeRows * numBuildRows;
+  probeIndices_ = allocateIndices(numCombinations, pool());
+  buildIndices_ = allocateIndices(numCombinations, pool());
+  auto* rawProbeIndices = probeIndices_->asMutable<vector_size_t>();
+  auto* rawBuildIndices = buildIndices_->asMutable<vector_size_t>();
+  for (auto i = 0; i < numProbeRows; ++i) {
+    std::fill(
+        rawProbeIndices + i * numBuildRows,
+        rawProbeIndices + (i + 1) * numBuildRows,
+        probeRow_ + i);
+    std::iota(
+        rawBuildIndices + i * numBuildRows,
+        rawBuildIndices + (i + 1) * numBuildRows,
+        buildRow_);
+  }
+
+  auto output = makeJoinOutput(numCombinations, buildVector);
+
+  buildRow_ += numBuildRows;
+  if (buildRow_ == buildSize) {
+    buildRow_ = 0;
+    probeRow_ += numProbeRows;
+    if (probeRow_ == inputSize) {
+      probeRow_ = 0;
+      ++buildIndex_;
+    }
+  }
+  return output;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getRangeJoinOutput() {
+  const auto& buildVector = buildVectors_.value()[0];
+  const vector_size_t inputSize = input_->size();
+
+  probeIndices_ = allocateIndices(outputBatchSize_, pool());
+  buildIndices_ = allocateIndices(outputBatchSize_, pool());
+  auto* rawProbeIndices = probeIndices_->asMutable<vector_size_t>();
+  auto* rawBuildIndices = buildIndices_->asMutable<vector_size_t>();
+  vector_size_t numCombinations = 0;
+  while (probeRow_ < inputSize && numCombinations < outputBatchSize_) {
+    if (!probeRange_.has_value()) {
+      probeRange_ = findBuildRange(probeRow_);
+    }
+    auto& [begin, end] = probeRange_.value();
+    const auto numBuildRows = std::min<vector_size_t>(
+        end - begin, outputBatchSize_ - numCombinations);
+    std::fill(
+        rawProbeIndices + numCombinations,
+        rawProbeIndices + numCombinations + numBuildRows,
+        probeRow_);
+    std::iota(
+        rawBuildIndices + numCombinations,
+        rawBuildIndices + numCombinations + numBuildRows,
+        begin);
+    numCombinations += numBuildRows;
+    begin += numBuildRows;
+    if (begin == end) {
+      probeRange_.reset();
+      ++probeRow_;
+    }
+  }
+
+  auto output = makeJoinOutput(numCombinations, buildVector);
+
+  if (probeRow_ == inputSize) {
+    probeRow_ = 0;
+    buildIndex_ = buildVectors_->size();
+  }
+  return output;
+}
+
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinProbe::findBuildRange(
+    vector_size_t probeRow) const {
+  const auto& key = input_->childAt(rangeJoinKeys_->probeChannel);
+  if (key->isNullAt(probeRow)) {
+    return {0, 0};
+  }
+  const auto& buildVector = buildVectors_.value()[0];
+  const auto& lower = buildVector->childAt(rangeJoinKeys_->lowerChannel);
+  const auto& upper = buildVector->childAt(rangeJoinKeys_->upperChannel);
+
+  // Returns the first row in [begin, end) for which 'isAfter' is true.
+  // 'isAfter' must be false for all rows before it and true for the rest.
+  auto firstRow = [](vector_size_t begin, vector_size_t end, auto isAfter) {
+    while (begin < end) {
+      const auto middle = begin + (end - begin) / 2;
+      if (isAfter(middle)) {
+        end = middle;
+      } else {
+        begin = middle + 1;
+      }
+    }
+    return begin;
+  };
+
+  // The rows from 'end' on have a lower bound above the key.
+  const auto end = firstRow(0, numRangeRows_, [&](auto row) {
+    return lower->compare(key.get(), row, probeRow) > 0;
+  });
+  // The rows before 'begin' have an upper bound below the key.
+  const auto begin = firstRow(0, end, [&](auto row) {
+    return upper->compare(key.get(), maxUpperRows_[row], probeRow) >= 0;
+  });
+  return {begin, end};
+}
+
+RowVectorPtr NestedLoopJoinProbe::makeJoinOutput(
+    vector_size_t numCombinations,
+    const RowVectorPtr& buildVector) {
+  auto* rawProbeIndices = probeIndices_->asMutable<vector_size_t>();
+  auto* rawBuildIndices = buildIndices_->asMutable<vector_size_t>();
+  const auto numMatches = joinCondition_ != nullptr && numCombinations > 0
+      ? evalJoinCondition(numCombinations, buildVector)
+      : numCombinations;
+  if (needsProbeMismatch()) {
+    for (auto i = 0; i < numMatches; ++i) {
+      probeMatched_.setValid(rawProbeIndices[i], true);
+    }
+  }
+  if (needsBuildMismatch()) {
+    auto& buildMatched = buildMatched_[buildIndex_];
+    for (auto i = 0; i < numMatches; ++i) {
+      buildMatched.setValid(rawBuildIndices[i], true);
+    }
+  }
+
+  RowVectorPtr output;
+  if (numMatches > 0) {
+    output = fillOutput(numMatches, probeIndices_);
+    for (const auto& projection : buildProjections_) {
+      output->childAt(projection.outputChannel) = BaseVector::wrapInDictionary(
+          BufferPtr(nullptr),
+          buildIndices_,
+          numMatches,
+          buildVector->childAt(projection.inputChannel));
+    }
+  }
+  // The output holds on to the indices.
+  probeIndices_ = nullptr;
+  buildIndices_ = nullptr;
+  return output;
+}
+
+vector_size_t NestedLoopJoinProbe::evalJoinCondition(
+    vector_size_t numCombinations,
+    const RowVectorPtr& buildVector) {
+  std::vector<VectorPtr> filterColumns(filterInputType_->size());
+  for (const auto& projection : filterProbeProjections_) {
+    filterColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        BufferPtr(nullptr),
+        probeIndices_,
+        numCombinations,
+        input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : filterBuildProjections_) {
+    filterColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        BufferPtr(nullptr),
+        buildIndices_,
+        numCombinations,
+        buildVector->childAt(projection.inputChannel));
+  }
+  auto filterInput = std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      BufferPtr(nullptr),
+      numCombinations,
+      std::move(filterColumns));
+
+  filterRows_.resizeFill(numCombinations, true);
+  EvalCtx evalCtx(
+      operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
+  joinCondition_->eval(filterRows_, evalCtx, filterResult_);
+  decodedFilterResult_.decode(*filterResult_[0], filterRows_);
+
+  // Moves the matching combinations to the front of the indices.
+  auto* rawProbeIndices = probeIndices_->asMutable<vector_size_t>();
+  auto* rawBuildIndices = buildIndices_->asMutable<vector_size_t>();
+  vector_size_t numMatches = 0;
+  for (auto i = 0; i < numCombinations; ++i) {
+    if (!decodedFilterResult_.isNullAt(i) &&
+        decodedFilterResult_.valueAt<bool>(i)) {
+      rawProbeIndices[numMatches] = rawProbeIndices[i];
+      rawBuildIndices[numMatches] = rawBuildIndices[i];
+      ++numMatches;
+    }
+  }
+  return numMatches;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getProbeMismatchOutput() {
+  const vector_size_t inputSize = input_->size();
+  auto indices = allocateIndices(
+      std::min<vector_size_t>(outputBatchSize_, inputSize - probeMismatchRow_),
+      pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numMismatches = 0;
+  for (; probeMismatchRow_ < inputSize && numMismatches < outputBatchSize_;
+       ++probeMismatchRow_) {
+    if (!probeMatched_.isValid(probeMismatchRow_)) {
+      rawIndices[numMismatches++] = probeMismatchRow_;
+    }
+  }
+  if (numMismatches == 0) {
+    return nullptr;
+  }
+  return makeMismatchOutput(
+      numMismatches, indices, input_, identityProjections_, buildProjections_);
+}
+
+void NestedLoopJoinProbe::finishProbeInput() {
+  probeInputFinished_ = true;
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last Driver to finish its probe input returns the build rows without
+  // a match in any Driver. The other Drivers wait until it has collected
+  // their 'buildMatched_'.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  for (auto& peer : peers) {
+    auto op = peer->findOperator(planNodeId());
+    auto* probe = dynamic_cast<NestedLoopJoinProbe*>(op);
+    VELOX_CHECK_NOT_NULL(probe);
+    VELOX_CHECK_EQ(probe->buildMatched_.size(), buildMatched_.size());
+    for (auto i = 0; i < buildMatched_.size(); ++i) {
+      buildMatched_[i].select(probe->buildMatched_[i]);
+    }
+  }
+
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  lastProbe_ = true;
+  buildIndex_ = 0;
+  buildRow_ = 0;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getBuildMismatchOutput() {
+  while (buildIndex_ < buildVectors_->size()) {
+    const auto buildVector = buildVectors_.value()[buildIndex_];
+    const auto& buildMatched = buildMatched_[buildIndex_];
+    const vector_size_t buildSize = buildVector->size();
+    auto indices = allocateIndices(
+        std::min<vector_size_t>(outputBatchSize_, buildSize - buildRow_),
+        pool());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    vector_size_t numMismatches = 0;
+    for (; buildRow_ < buildSize && numMismatches < outputBatchSize_;
+         ++buildRow_) {
+      if (!buildMatched.isValid(buildRow_)) {
+        rawIndices[numMismatches++] = buildRow_;
+      }
+    }
+    if (buildRow_ == buildSize) {
+      buildRow_ = 0;
+      ++buildIndex_;
+    }
+    if (numMismatches > 0) {
+      return makeMismatchOutput(
+          numMismatches,
+          indices,
+          buildVector,
+          buildProjections_,
+          identityProjections_);
+    }
+  }
+  return nullptr;
+}
+
+RowVectorPtr NestedLoopJoinProbe::makeMismatchOutput(
+    vector_size_t size,
+    const BufferPtr& indices,
+    const RowVectorPtr& source,
+    const std::vector<IdentityProjection>& sourceProjections,
+    const std::vector<IdentityProjection>& nullProjections) {
+  std::vector<VectorPtr> columns(outputType_->size());
+  for (const auto& projection : sourceProjections) {
+    columns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        BufferPtr(nullptr),
+        indices,
+        size,
+        source->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : nullProjections) {
+    columns[projection.outputChannel] = BaseVector::createNullConstant(
+        outputType_->childAt(projection.outputChannel), size, pool());
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, BufferPtr(nullptr), size, std::move(columns));
+}
+
+bool NestedLoopJoinProbe::isFinished() {
+  if (buildSideEmpty_) {
+    return true;
+  }
+  if (!noMoreInput_ || input_ != nullptr) {
+    return false;
+  }
+  if (!needsBuildMismatch()) {
+    return true;
+  }
+  if (!probeInputFinished_ || future_.valid()) {
+    return false;
+  }
+  return !lastProbe_ || buildIndex_ == buildVectors_->size();
+}
+
+void NestedLoopJoinProbe::close() {
+  buildVectors_.reset();
+  buildMatched_.clear();
+  Operator::close();
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/Operator.h"
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// Joins each probe input batch with all the build vectors. The join
+/// condition is evaluated on batches of up to 'outputBatchSize_' combinations
+/// of probe and build rows and only the matching combinations are returned.
+/// Left and full joins return the probe rows without a match after the probe
+/// batch is joined with all build vectors. Right and full joins return the
+/// build rows without a match in any probe batch of any Driver after all
+/// probe Drivers have received all input. The last probe Driver to finish
+/// collects the build row matches of its peers and returns these rows.
+class NestedLoopJoinProbe : public Operator {
+ public:
+  NestedLoopJoinProbe(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::NestedLoopJoinNode>& joinNode);
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_ && !buildSideEmpty_;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override;
+
+  void close() override;
+
+ private:
+  bool needsProbeMismatch() const {
+    return core::isLeftJoin(joinType_) || core::isFullJoin(joinType_);
+  }
+
+  bool needsBuildMismatch() const {
+    return core::isRightJoin(joinType_) || core::isFullJoin(joinType_);
+  }
+
+  void initializeFilter(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Returns the matching combinations of the next up to 'outputBatchSize_'
+  // probe and build rows or nullptr if none of them matches. Advances
+  // 'buildIndex_', 'buildRow_' and 'probeRow_'.
+  RowVectorPtr getCrossProductOutput();
+
+  // Computes 'numRangeRows_' and 'maxUpperRows_' for the sorted build rows.
+  void initializeRangeJoin();
+
+  // Returns the matching combinations of the next up to 'outputBatchSize_'
+  // probe rows and the build rows in their range or nullptr if none of them
+  // matches. Advances 'probeRow_' and 'probeRange_'. Sets 'buildIndex_' past
+  // the build vectors once all probe rows are done.
+  RowVectorPtr getRangeJoinOutput();
+
+  // Returns the range of build rows that may match 'probeRow'. The rows
+  // before the range have an upper bound below the probe key and the rows
+  // after it have a lower bound above it. The join condition is still
+  // evaluated on the rows in the range.
+  std::pair<vector_size_t, vector_size_t> findBuildRange(
+      vector_size_t probeRow) const;
+
+  // Evaluates the join condition on the first 'numCombinations' entries of
+  // 'probeIndices_' and 'buildIndices_', records the matches for outer joins
+  // and returns the matching combinations or nullptr if there are none.
+  RowVectorPtr makeJoinOutput(
+      vector_size_t numCombinations,
+      const RowVectorPtr& buildVector);
+
+  // Evaluates the join condition on the combinations in 'probeIndices_' and
+  // 'buildIndices_' and moves the matching ones to the front. Returns the
+  // number of matches.
+  vector_size_t evalJoinCondition(
+      vector_size_t numCombinations,
+      const RowVectorPtr& buildVector);
+
+  // Returns the next batch of the rows of 'input_' without a match with nulls
+  // for the build side columns or nullptr if there are no more such rows.
+  RowVectorPtr getProbeMismatchOutput();
+
+  // Called once all probe input is processed. For right and full joins, waits
+  // for the peer probe Drivers and sets 'lastProbe_' for the last of them.
+  void finishProbeInput();
+
+  // Returns the next batch of build rows without a match in any probe Driver
+  // with nulls for the probe side columns or nullptr if there are no more
+  // such rows.
+  RowVectorPtr getBuildMismatchOutput();
+
+  // Returns a vector of 'size' rows with nulls for the columns in
+  // 'projections' and the rows of 'source' at 'indices' for the other
+  // columns in 'sourceProjections'.
+  RowVectorPtr makeMismatchOutput(
+      vector_size_t size,
+      const BufferPtr& indices,
+      const RowVectorPtr& source,
+      const std::vector<IdentityProjection>& sourceProjections,
+      const std::vector<IdentityProjection>& nullProjections);
+
+  // Maximum number of rows in the output batch.
+  const uint32_t outputBatchSize_;
+
+  const core::JoinType joinType_;
+
+  std::vector<IdentityProjection> buildProjections_;
+
+  // Set if the join condition bounds a probe column by two build columns. The
+  // build side is then a single vector sorted on the lower bound and each
+  // probe row is joined only with the build rows in its range.
+  const std::optional<RangeJoinKeys> rangeJoinKeys_;
+
+  // The number of build rows with non-null bounds. These are the first rows
+  // of the build vector. The rest match no probe row.
+  vector_size_t numRangeRows_{0};
+
+  // For each of the first 'numRangeRows_' build rows, the row with the
+  // largest upper bound up to and including it.
+  std::vector<vector_size_t> maxUpperRows_;
+
+  // The build rows in the range of 'probeRow_' that are not joined yet.
+  std::optional<std::pair<vector_size_t, vector_size_t>> probeRange_;
+
+  // Join condition, null if the join matches all combinations.
+  std::unique_ptr<ExprSet> joinCondition_;
+
+  // Type of the input of 'joinCondition_'.
+  RowTypePtr filterInputType_;
+
+  // Maps probe and build channels to the channels of the input of
+  // 'joinCondition_'.
+  std::vector<IdentityProjection> filterProbeProjections_;
+  std::vector<IdentityProjection> filterBuildProjections_;
+
+  std::optional<std::vector<RowVectorPtr>> buildVectors_;
+
+  // Index into 'buildVectors_' for the build side vector to process on next
+  // call to getOutput().
+  size_t buildIndex_{0};
+
+  // Build row in 'buildVectors_[buildIndex_]' to process on next call to
+  // getOutput().
+  vector_size_t buildRow_{0};
+
+  // Input row to process on next call to getOutput().
+  vector_size_t probeRow_{0};
+
+  // The probe and build rows of the combinations in the current batch. The
+  // output takes over these.
+  BufferPtr probeIndices_;
+  BufferPtr buildIndices_;
+
+  SelectivityVector filterRows_;
+  std::vector<VectorPtr> filterResult_;
+  DecodedVector decodedFilterResult_;
+
+  // The rows of 'input_' with at least one match. Used by left and full
+  // joins.
+  SelectivityVector probeMatched_;
+
+  // Input row to continue looking for probe rows without a match from.
+  vector_size_t probeMismatchRow_{0};
+
+  // The rows of each build vector with at least one match in this Driver.
+  // Used by right and full joins.
+  std::vector<SelectivityVector> buildMatched_;
+
+  // True once all probe input is processed and the peers are waited for.
+  bool probeInputFinished_{false};
+
+  // True if this is the last probe Driver to finish and returns the build
+  // rows without a match.
+  bool lastProbe_{false};
+
+  // Future for waiting for the last probe Driver to read 'buildMatched_'.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  bool buildSideEmpty_{false};
+};
+} // namespace facebook::velox::exec
@@ -51,6 +51,15 @@ class SimpleExpressionEvaluator : public connector::ExpressionEvaluator {
  private:
   core::ExecCtx* execCtx_;
 };
+
+// Owns the ExecCtx and the expression evaluator that a ConnectorQueryCtx
+// refers to, and the task that owns its memory pool.
+struct TaskScopedConnectorQueryCtx {
+  std::shared_ptr<Task> task;
+  std::unique_ptr<core::ExecCtx> execCtx;
+  std::unique_ptr<SimpleExpressionEvaluator> expressionEvaluator;
+  std::unique_ptr<connector::ConnectorQueryCtx> connectorQueryCtx;
+};
 } // namespace
 
 OperatorCtx::OperatorCtx(
@@ -90,6 +99,31 @@ OperatorCtx::createConnectorQueryCtx(
       driverCtx_->driverId);
 }
 
+std::shared_ptr<connector::ConnectorQueryCtx>
+OperatorCtx::createTaskScopedConnectorQueryCtx(
+    const std::string& connectorId,
+    const std::string& planNodeId) const {
+  auto owner = std::make_shared<TaskScopedConnectorQueryCtx>();
+  owner->task = driverCtx_->task;
+  owner->execCtx =
+      std::make_unique<core::ExecCtx>(pool_, owner->task->queryCtx().get());
+  owner->expressionEvaluator =
+      std::make_unique<SimpleExpressionEvaluator>(owner->execCtx.get());
+  owner->connectorQueryCtx = std::make_unique<connector::ConnectorQueryCtx>(
+      pool_,
+      owner->task->queryCtx()->getConnectorConfig(connectorId),
+      owner->expressionEvaluator.get(),
+      owner->task->queryCtx()->allocator(),
+      taskId(),
+      planNodeId,
+      driverCtx_->driverId);
+  // Aliases 'owner' so that the ExecCtx, the evaluator and the task live as
+  // long as the ConnectorQueryCtx.
+  auto* connectorQueryCtx = owner->connectorQueryCtx.get();
+  return std::shared_ptr<connector::ConnectorQueryCtx>(
+      std::move(owner), connectorQueryCtx);
+}
+
 std::optional<Spiller::Config> OperatorCtx::makeSpillConfig(
     Spiller::Type type) const {
   const auto& queryConfig = driverCtx_->task->queryCtx()->queryConfig();
@@ -99,6 +133,11 @@ std::optional<Spiller::Config> OperatorCtx::makeSpillConfig(
   if (driverCtx_->task->spillDirectory().empty()) {
     return std::nullopt;
   }
+  const auto compressionKind =
+      common::stringToCompressionKind(queryConfig.spillCompressionKind());
+  // Spill files are compressed with a folly codec. Fails before anything is
+  // spilled if there is none for 'compressionKind', e.g. for lzo.
+  common::compressionKindToCodec(compressionKind);
   return Spiller::Config(
       makeOperatorSpillPath(
           driverCtx_->task->spillDirectory(),
@@ -114,7 +153,8 @@ std::optional<Spiller::Config> OperatorCtx::makeSpillConfig(
           queryConfig.spillStartPartitionBit() +
               queryConfig.spillPartitionBits()),
       queryConfig.maxSpillLevel(),
-      queryConfig.testingSpillPct());
+      queryConfig.testingSpillPct(),
+      compressionKind);
 }
 
 Operator::Operator(
@@ -381,6 +421,7 @@ void OperatorStats::add(const OperatorStats& other) {
 
   numDrivers += other.numDrivers;
   spilledBytes += other.spilledBytes;
+  spilledUncompressedBytes += other.spilledUncompressedBytes;
   spilledRows += other.spilledRows;
   spilledPartitions += other.spilledPartitions;
   spilledFiles += other.spilledFiles;
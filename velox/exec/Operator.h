@@ -131,6 +131,9 @@ struct OperatorStats {
   // Total bytes written for spilling.
   uint64_t spilledBytes{0};
 
+  // Total serialized bytes of the spilled data before compression.
+  uint64_t spilledUncompressedBytes{0};
+
   // Total rows written for spilling.
   uint64_t spilledRows{0};
 
@@ -206,6 +209,15 @@ class OperatorCtx {
       const std::string& connectorId,
       const std::string& planNodeId) const;
 
+  /// Like createConnectorQueryCtx() but with its own ExecCtx and expression
+  /// evaluator instead of those of the operator. The result keeps these and
+  /// the task, which owns the memory pool, alive, so that it may be used by
+  /// connector objects that outlive the operator, e.g. preloaded DataSources.
+  std::shared_ptr<connector::ConnectorQueryCtx>
+  createTaskScopedConnectorQueryCtx(
+      const std::string& connectorId,
+      const std::string& planNodeId) const;
+
   /// Generates the spiller config for a given spiller 'type' if the disk
   /// spilling is enabled, otherwise returns null.
   std::optional<Spiller::Config> makeSpillConfig(Spiller::Type type) const;
@@ -345,6 +357,18 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  // Returns true if 'this' can free memory on request of a memory arbitrator,
+  // e.g. by spilling. The result must not change over the lifetime of 'this'.
+  virtual bool canReclaim() const {
+    return false;
+  }
+
+  // Frees at least 'targetBytes' of memory if possible. Called only if
+  // canReclaim() returns true and while the Task is paused, i.e. not on the
+  // Driver thread of 'this'. May free nothing if 'this' is in a state that
+  // can not be spilled.
+  virtual void reclaim(uint64_t /*targetBytes*/) {}
+
   // Returns a list of identify projections, e.g. columns that are projected
   // as-is possibly after applying a filter.
   const std::vector<IdentityProjection>& identityProjections() const {
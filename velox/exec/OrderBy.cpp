@@ -15,6 +15,7 @@
  */
 #include "velox/exec/OrderBy.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 #include "velox/vector/FlatVector.h"
 
@@ -37,6 +38,7 @@ OrderBy::OrderBy(
           orderByNode->id(),
           "OrderBy"),
       numSortKeys_(orderByNode->sortingKeys().size()),
+      parallel_(orderByNode->isParallel()),
       spillMemoryThreshold_(operatorCtx_->driverCtx()
                                 ->queryConfig()
                                 .orderBySpillMemoryThreshold()),
@@ -116,94 +118,52 @@ void OrderBy::addInput(RowVectorPtr input) {
   }
 
   numRows_ += allRows.size();
-  if (spiller_ != nullptr) {
-    const auto spillStats = spiller_->stats();
-    auto lockedStats = stats_.wlock();
-    lockedStats->spilledBytes = spillStats.spilledBytes;
-    lockedStats->spilledRows = spillStats.spilledRows;
-    lockedStats->spilledPartitions = spillStats.spilledPartitions;
-    lockedStats->spilledFiles = spillStats.spilledFiles;
-    VELOX_DCHECK_LE(lockedStats->spilledPartitions, 1);
-  }
+  updateSpillStats();
 }
 
-void OrderBy::ensureInputFits(const RowVectorPtr& input) {
-  // Check if spilling is enabled or not.
-  if (!spillConfig_.has_value()) {
+void OrderBy::updateSpillStats() {
+  if (spiller_ == nullptr) {
     return;
   }
+  const auto spillStats = spiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledUncompressedBytes = spillStats.spilledUncompressedBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+  VELOX_DCHECK_LE(lockedStats->spilledPartitions, 1);
+}
 
-  const int64_t numRows = data_->numRows();
-  if (numRows == 0) {
-    // 'data_' is empty. Nothing to spill.
+void OrderBy::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+  // Once all input is received the rows are sorted in memory or being merged
+  // from spill files. Neither state can be spilled.
+  if (noMoreInput_ || data_->numRows() == 0) {
     return;
   }
-  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
-  const auto outOfLineBytes =
-      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
-  const int64_t flatInputBytes = input->estimateFlatSize();
-
-  const auto& spillConfig = spillConfig_.value();
-  // Test-only spill path.
-  if (numRows > 0 && spillConfig.testSpillPct &&
-      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
-          spillConfig.testSpillPct) {
-    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
-    spill(
-        numRows - rowsToSpill,
-        outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
+  spill(0, 0);
+  updateSpillStats();
+  pool()->getMemoryUsageTracker()->release();
+}
+
+void OrderBy::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
     return;
   }
-
   auto tracker = pool()->getMemoryUsageTracker();
   VELOX_CHECK_NOT_NULL(tracker);
-  const auto currentUsage = tracker->currentBytes();
-  if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
-    const int64_t bytesToSpill =
-        currentUsage * spillConfig.spillableReservationGrowthPct / 100;
-    auto rowsToSpill = std::max<int64_t>(
-        1, bytesToSpill / (data_->fixedRowSize() + outOfLineBytesPerRow));
-    spill(
-        std::max<int64_t>(0, numRows - rowsToSpill),
-        std::max<int64_t>(
-            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
-    return;
-  }
-
-  if (freeRows > input->size() &&
-      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
-    // Enough free rows for input rows and enough variable length free
-    // space for the flat size of the whole vector. If outOfLineBytes
-    // is 0 there is no need for variable length space.
-    return;
-  }
-
-  // If there is variable length data we take the flat size of the input as a
-  // cap on the new variable length data needed.
-  const int64_t incrementBytes =
-      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
-
-  // There must be at least 2x the increment in reservation.
-  if (tracker->availableReservation() > 2 * incrementBytes) {
-    return;
-  }
-
-  // Check if can increase reservation. The increment is the larger of twice the
-  // maximum increment from this input and 'spillableReservationGrowthPct_' of
-  // the current reservation.
-  const auto targetIncrementBytes = std::max<int64_t>(
-      incrementBytes * 2,
-      currentUsage * spillConfig.spillableReservationGrowthPct / 100);
-  if (tracker->maybeReserve(targetIncrementBytes)) {
-    return;
-  }
-  const int64_t rowsToSpill = std::max<int64_t>(
-      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
-  spill(
-      std::max<int64_t>(0, numRows - rowsToSpill),
-      std::max<int64_t>(
-          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+  Spiller::ensureInputFits(
+      *data_,
+      *input,
+      spillConfig_.value(),
+      spillMemoryThreshold_,
+      *tracker,
+      spillTestCounter_,
+      [&](int64_t targetRows, int64_t targetBytes) {
+        spill(targetRows, targetBytes);
+      });
 }
 
 void OrderBy::spill(int64_t targetRows, int64_t targetBytes) {
@@ -224,7 +184,8 @@ void OrderBy::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig.maxFileSize,
         spillConfig.minSpillRunSize,
         Spiller::spillPool(),
-        spillConfig.executor);
+        spillConfig.executor,
+        spillConfig.compressionKind);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   }
   spiller_->spill(targetRows, targetBytes);
@@ -233,6 +194,12 @@ void OrderBy::spill(int64_t targetRows, int64_t targetBytes) {
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
 
+  if (parallel_) {
+    // The drivers without data take part in the choice of key ranges.
+    startParallelSort();
+    return;
+  }
+
   // No data.
   if (numRows_ == 0) {
     finished_ = true;
@@ -246,19 +213,11 @@ void OrderBy::noMoreInput() {
     returningRows_.resize(numRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numRows_, returningRows_.data());
-    std::sort(
-        returningRows_.begin(),
-        returningRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < numSortKeys_; ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, keyCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
-
+    PrefixSort::sort(
+        *data_,
+        keyCompareFlags_,
+        folly::Range<char**>(returningRows_.data(), returningRows_.size()),
+        *pool());
   } else {
     // Finish spill, and we shouldn't get any rows from non-spilled partition as
     // there is only one hash partition for orderBy operator.
@@ -272,10 +231,187 @@ void OrderBy::noMoreInput() {
   }
 }
 
+bool OrderBy::allPeersFinished(
+    std::vector<ContinuePromise>& promises,
+    std::vector<std::shared_ptr<Driver>>& peers) {
+  return operatorCtx_->task()->allPeersFinished(
+      planNodeId(), operatorCtx_->driver(), &future_, promises, peers);
+}
+
+void OrderBy::startParallelSort() {
+  VELOX_CHECK_EQ(numRows_, data_->numRows());
+  returningRows_.resize(numRows_);
+  RowContainerIterator iter;
+  data_->listRows(&iter, numRows_, returningRows_.data());
+
+  // The rows are in arrival order, so evenly spaced rows are a sample.
+  const auto numSamples = std::min<size_t>(kNumSamplesPerDriver, numRows_);
+  samples_.reserve(numSamples);
+  for (auto i = 0; i < numSamples; ++i) {
+    samples_.push_back(returningRows_[i * numRows_ / numSamples]);
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!allPeersFinished(promises, peers)) {
+    parallelStep_ = ParallelStep::kWaitForSplitters;
+    return;
+  }
+  makeSplitters(peers);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  partitionRows();
+}
+
+void OrderBy::makeSplitters(const std::vector<std::shared_ptr<Driver>>& peers) {
+  std::vector<OrderBy*> orderBys{this};
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    orderBys.push_back(orderBy);
+  }
+  // The first driver outputs the first key range.
+  std::sort(orderBys.begin(), orderBys.end(), [](auto* left, auto* right) {
+    return left->operatorCtx_->driverCtx()->driverId <
+        right->operatorCtx_->driverCtx()->driverId;
+  });
+
+  // All drivers have the same row layout, so 'data_' compares rows of any of
+  // them.
+  std::vector<char*> samples;
+  for (auto* orderBy : orderBys) {
+    samples.insert(
+        samples.end(), orderBy->samples_.begin(), orderBy->samples_.end());
+    orderBy->samples_.clear();
+  }
+  PrefixSort::sort(
+      *data_,
+      keyCompareFlags_,
+      folly::Range<char**>(samples.data(), samples.size()),
+      *pool());
+
+  const auto numDrivers = orderBys.size();
+  auto state = std::make_shared<ParallelState>(numDrivers);
+  if (!samples.empty()) {
+    for (auto i = 1; i < numDrivers; ++i) {
+      state->splitters.push_back(samples[i * samples.size() / numDrivers]);
+    }
+  }
+  for (auto i = 0; i < numDrivers; ++i) {
+    orderBys[i]->parallelState_ = state;
+    orderBys[i]->parallelIndex_ = i;
+  }
+}
+
+void OrderBy::partitionRows() {
+  const auto& splitters = parallelState_->splitters;
+  auto& ranges = parallelState_->rows[parallelIndex_];
+  for (auto* row : returningRows_) {
+    // Rows equal to a splitter go to the range the splitter starts.
+    const auto it = std::upper_bound(
+        splitters.begin(),
+        splitters.end(),
+        row,
+        [&](const char* left, const char* right) {
+          return data_->compareRows(left, right, keyCompareFlags_) < 0;
+        });
+    ranges[it - splitters.begin()].push_back(row);
+  }
+  returningRows_.clear();
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!allPeersFinished(promises, peers)) {
+    parallelStep_ = ParallelStep::kWaitForRanges;
+    return;
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  sortRange();
+}
+
+void OrderBy::sortRange() {
+  auto& range = parallelState_->sortedRanges[parallelIndex_];
+  for (auto& driverRows : parallelState_->rows) {
+    auto& rows = driverRows[parallelIndex_];
+    range.insert(range.end(), rows.begin(), rows.end());
+    std::vector<char*>().swap(rows);
+  }
+  PrefixSort::sort(
+      *data_,
+      keyCompareFlags_,
+      folly::Range<char**>(range.data(), range.size()),
+      *pool());
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!allPeersFinished(promises, peers)) {
+    parallelStep_ = ParallelStep::kWaitForSort;
+    return;
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  finishParallelSort();
+}
+
+void OrderBy::finishParallelSort() {
+  parallelStep_ = ParallelStep::kOutput;
+  numRowsReturned_ = 0;
+  if (parallelIndex_ != 0) {
+    numRows_ = 0;
+    finished_ = true;
+    return;
+  }
+  for (auto& range : parallelState_->sortedRanges) {
+    returningRows_.insert(returningRows_.end(), range.begin(), range.end());
+    std::vector<char*>().swap(range);
+  }
+  numRows_ = returningRows_.size();
+  finished_ = numRows_ == 0;
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    switch (parallelStep_) {
+      case ParallelStep::kWaitForSplitters:
+        partitionRows();
+        break;
+      case ParallelStep::kWaitForRanges:
+        sortRange();
+        break;
+      case ParallelStep::kWaitForSort:
+        finishParallelSort();
+        break;
+      default:
+        break;
+    }
+  }
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForPeers;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void OrderBy::close() {
+  if (parallelState_ != nullptr && data_ != nullptr) {
+    // The first driver may still read the rows of 'data_'.
+    std::lock_guard<std::mutex> l(parallelState_->mutex);
+    parallelState_->containers.push_back(std::move(data_));
+  }
+  Operator::close();
+}
+
 RowVectorPtr OrderBy::getOutput() {
   if (finished_ || !noMoreInput_ || numRows_ == numRowsReturned_) {
     return nullptr;
   }
+  if (parallel_ && parallelStep_ != ParallelStep::kOutput) {
+    return nullptr;
+  }
   prepareOutput();
 
   if (spiller_ != nullptr) {
@@ -31,6 +31,12 @@ namespace facebook::velox::exec {
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
+///
+/// A parallel OrderBy runs on multiple drivers. Once all drivers have their
+/// input, they pick splitters from samples of their rows, each driver moves
+/// its rows to the key ranges between splitters and each driver sorts the
+/// rows of one key range. The first driver then outputs the sorted ranges in
+/// order and the others finish without output.
 class OrderBy : public Operator {
  public:
   OrderBy(
@@ -48,17 +54,61 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* FOLLY_NULLABLE /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* FOLLY_NULLABLE future) override;
 
   bool isFinished() override {
     return finished_;
   }
 
+  bool canReclaim() const override {
+    return spillConfig_.has_value();
+  }
+
+  void reclaim(uint64_t targetBytes) override;
+
+  void close() override;
+
  private:
   static const int32_t kBatchSizeInBytes{2 * 1024 * 1024};
 
+  // Number of rows each driver of a parallel OrderBy contributes to the
+  // choice of splitters.
+  static constexpr int32_t kNumSamplesPerDriver = 1'000;
+
+  // The steps of a parallel OrderBy after all input is received. Each
+  // kWaitFor step waits for all drivers to finish the step before.
+  enum class ParallelStep {
+    kInput,
+    kWaitForSplitters,
+    kWaitForRanges,
+    kWaitForSort,
+    kOutput,
+  };
+
+  // State shared by the drivers of a parallel OrderBy. It is made by the last
+  // driver to finish its input. The steps of the drivers are ordered by
+  // Task::allPeersFinished, so only 'containers' needs 'mutex'.
+  struct ParallelState {
+    explicit ParallelState(int32_t numDrivers)
+        : rows(numDrivers, std::vector<std::vector<char*>>(numDrivers)),
+          sortedRanges(numDrivers) {}
+
+    // The lower bounds of the key ranges after the first.
+    std::vector<char*> splitters;
+
+    // 'rows[i][j]' are the rows of driver i in key range j.
+    std::vector<std::vector<std::vector<char*>>> rows;
+
+    // 'sortedRanges[j]' are the rows of key range j in sorted order.
+    std::vector<std::vector<char*>> sortedRanges;
+
+    std::mutex mutex;
+
+    // The RowContainers of the drivers that have closed. The rows are read by
+    // the first driver until it is done with the output.
+    std::vector<std::unique_ptr<RowContainer>> containers;
+  };
+
   // Checks if input will fit in the existing memory and increases
   // reservation if not. If reservation cannot be increased, spills enough to
   // make 'input' fit.
@@ -78,8 +128,43 @@ class OrderBy : public Operator {
   // in a paused state and off thread.
   void spill(int64_t targetRows, int64_t targetBytes);
 
+  // Copies the spill stats from 'spiller_' to the operator stats.
+  void updateSpillStats();
+
+  // Calls Task::allPeersFinished for the drivers of a parallel OrderBy.
+  // Returns false and sets 'future_' if other drivers have not reached this
+  // point. Otherwise returns true and sets 'promises' and 'peers'. The caller
+  // must realize 'promises' to continue the peers.
+  bool allPeersFinished(
+      std::vector<ContinuePromise>& promises,
+      std::vector<std::shared_ptr<Driver>>& peers);
+
+  // Samples the input rows, picks splitters once all drivers have their input
+  // and continues with partitionRows().
+  void startParallelSort();
+
+  // Called on the last driver to finish input. Picks the splitters from the
+  // samples of all drivers and sets 'parallelState_' and 'parallelIndex_' of
+  // all OrderBys in 'this' and 'peers'.
+  void makeSplitters(const std::vector<std::shared_ptr<Driver>>& peers);
+
+  // Moves the rows of 'this' to the key ranges between the splitters. Once all
+  // drivers are done, continues with sortRange().
+  void partitionRows();
+
+  // Sorts the rows of all drivers in the key range of 'this'. Once all ranges
+  // are sorted, continues with finishParallelSort().
+  void sortRange();
+
+  // Sets up the first driver to return the sorted ranges in order and
+  // finishes the others.
+  void finishParallelSort();
+
   const int32_t numSortKeys_;
 
+  // True if this is one of the drivers of a parallel OrderBy.
+  const bool parallel_;
+
   // The maximum memory usage that an order by can hold before spilling.
   // If it is zero, then there is no such limit.
   const uint64_t spillMemoryThreshold_;
@@ -129,6 +214,19 @@ class OrderBy : public Operator {
   std::vector<const RowVector*> spillSources_;
   std::vector<vector_size_t> spillSourceRows_;
 
+  ParallelStep parallelStep_{ParallelStep::kInput};
+
+  // Set while a parallel OrderBy waits for its peers.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // Rows of 'data_' to choose the splitters of a parallel OrderBy from.
+  std::vector<char*> samples_;
+
+  std::shared_ptr<ParallelState> parallelState_;
+
+  // The key range of this driver of a parallel OrderBy.
+  int32_t parallelIndex_{0};
+
   bool finished_ = false;
 };
 } // namespace facebook::velox::exec
@@ -69,7 +69,7 @@ void Destination::serialize(
     for (vector_size_t i = begin; i < end; i++) {
       numRows += rows_[i].size;
     }
-    current_->createStreamTree(rowType, numRows);
+    current_->createStreamTree(rowType, numRows, serdeOptions_);
   }
   current_->append(output, folly::Range(&rows_[begin], end - begin));
 }
@@ -123,7 +123,8 @@ PartitionedOutput::PartitionedOutput(
       bufferManager_(PartitionedOutputBufferManager::getInstance()),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      serdeOptions_(getVectorSerdeOptions(ctx->queryConfig())) {
   if (numDestinations_ == 1 || planNode->isBroadcast()) {
     VELOX_CHECK(keyChannels_.empty());
     VELOX_CHECK_NULL(partitionFunction_);
@@ -155,7 +156,8 @@ void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
-      destinations_.push_back(std::make_unique<Destination>(taskId, i, pool()));
+      destinations_.push_back(std::make_unique<Destination>(
+          taskId, i, pool(), serdeOptions_.get()));
     }
   }
 }
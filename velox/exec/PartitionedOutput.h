@@ -27,8 +27,12 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* FOLLY_NONNULL pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* FOLLY_NONNULL pool,
+      const VectorSerde::Options* FOLLY_NULLABLE serdeOptions = nullptr)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        serdeOptions_(serdeOptions) {
     setTargetSizePct();
   }
 
@@ -90,6 +94,8 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* FOLLY_NONNULL const pool_;
+  // Options for serializing the pages. Owned by the PartitionedOutput.
+  const VectorSerde::Options* FOLLY_NULLABLE const serdeOptions_;
   uint64_t bytesInCurrent_{0};
   std::vector<IndexRange> rows_;
 
@@ -190,6 +196,8 @@ class PartitionedOutput : public Operator {
   bool replicatedAny_{false};
   std::weak_ptr<exec::PartitionedOutputBufferManager> bufferManager_;
   const int64_t maxBufferedBytes_;
+  // Options for serializing the pages sent to 'destinations_'.
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   RowVectorPtr output_;
 
   // Reusable memory.
@@ -72,6 +72,7 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   numSplits += stats.numSplits;
 
   spilledBytes += stats.spilledBytes;
+  spilledUncompressedBytes += stats.spilledUncompressedBytes;
   spilledRows += stats.spilledRows;
   spilledPartitions += stats.spilledPartitions;
   spilledFiles += stats.spilledFiles;
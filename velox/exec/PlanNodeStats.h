@@ -102,6 +102,9 @@ struct PlanNodeStats {
   /// Total bytes written for spilling.
   uint64_t spilledBytes{0};
 
+  /// Total serialized bytes of the spilled data before compression.
+  uint64_t spilledUncompressedBytes{0};
+
   /// Total rows written for spilling.
   uint64_t spilledRows{0};
 
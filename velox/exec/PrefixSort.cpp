@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// A key encoded in the prefix. The encoding is a null indicator byte followed
+// by 'size' value bytes at 'offset' in the prefix.
+struct PrefixKey {
+  TypeKind kind;
+  RowColumn column;
+  CompareFlags flags;
+  int32_t offset;
+  int32_t size;
+};
+
+// Returns the number of value bytes of a fixed width key of 'kind' or 0 if
+// 'kind' has no fixed width encoding.
+int32_t fixedWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DATE:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    case TypeKind::TIMESTAMP:
+      // Seconds and nanos.
+      return 12;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+T valueAt(const char* row, const RowColumn& column) {
+  return *reinterpret_cast<const T*>(row + column.offset());
+}
+
+template <typename U>
+void storeBigEndian(U value, char* out) {
+  value = folly::Endian::big(value);
+  memcpy(out, &value, sizeof(U));
+}
+
+// Stores 'value' so that the byte order of the result is the numeric order of
+// 'value'.
+template <typename T>
+void encodeSigned(T value, char* out) {
+  using U = std::make_unsigned_t<T>;
+  storeBigEndian<U>(
+      static_cast<U>(value) ^ (U(1) << (sizeof(U) * 8 - 1)), out);
+}
+
+// Stores 'value' so that the byte order of the result is the order of
+// RowContainer::comparePrimitiveAsc, i.e. NaN is greater than any other
+// value and -0.0 is equal to 0.0.
+template <typename T, typename U>
+void encodeFloatingPoint(T value, char* out) {
+  constexpr U kSignBit = U(1) << (sizeof(U) * 8 - 1);
+  U bits;
+  if (std::isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  } else if (value == 0) {
+    value = 0;
+  }
+  memcpy(&bits, &value, sizeof(U));
+  bits = (bits & kSignBit) ? ~bits : bits | kSignBit;
+  storeBigEndian<U>(bits, out);
+}
+
+void encodeKey(const PrefixKey& key, const char* row, char* prefix) {
+  char* out = prefix + key.offset;
+  const bool isNull = RowContainer::isNullAt(
+      row, key.column.nullByte(), key.column.nullMask());
+  out[0] = isNull == key.flags.nullsFirst ? 0 : 1;
+  ++out;
+  if (isNull) {
+    // The value bytes are zero-initialized.
+    return;
+  }
+  switch (key.kind) {
+    case TypeKind::BOOLEAN:
+      out[0] = valueAt<bool>(row, key.column) ? 1 : 0;
+      break;
+    case TypeKind::TINYINT:
+      encodeSigned(valueAt<int8_t>(row, key.column), out);
+      break;
+    case TypeKind::SMALLINT:
+      encodeSigned(valueAt<int16_t>(row, key.column), out);
+      break;
+    case TypeKind::INTEGER:
+      encodeSigned(valueAt<int32_t>(row, key.column), out);
+      break;
+    case TypeKind::BIGINT:
+      encodeSigned(valueAt<int64_t>(row, key.column), out);
+      break;
+    case TypeKind::REAL:
+      encodeFloatingPoint<float, uint32_t>(
+          valueAt<float>(row, key.column), out);
+      break;
+    case TypeKind::DOUBLE:
+      encodeFloatingPoint<double, uint64_t>(
+          valueAt<double>(row, key.column), out);
+      break;
+    case TypeKind::DATE:
+      encodeSigned(valueAt<Date>(row, key.column).days(), out);
+      break;
+    case TypeKind::TIMESTAMP: {
+      auto timestamp = valueAt<Timestamp>(row, key.column);
+      encodeSigned(timestamp.getSeconds(), out);
+      storeBigEndian<uint32_t>(timestamp.getNanos(), out + 8);
+      break;
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      // Bytes past the end of a shorter string are zero, so a string that is
+      // a prefix of another ties with it and is resolved by the fallback.
+      std::string storage;
+      auto value = HashStringAllocator::contiguousString(
+          valueAt<StringView>(row, key.column), storage);
+      memcpy(out, value.data(), std::min<int32_t>(value.size(), key.size));
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE("No prefix encoding for {}", key.kind);
+  }
+  if (!key.flags.ascending) {
+    for (auto i = 0; i < key.size; ++i) {
+      out[i] = ~out[i];
+    }
+  }
+}
+
+template <int32_t kNumWords>
+struct PrefixEntry {
+  uint64_t words[kNumWords];
+  char* row;
+};
+
+template <int32_t kNumWords>
+void sortWithPrefix(
+    RowContainer& container,
+    const std::vector<CompareFlags>& compareFlags,
+    const std::vector<PrefixKey>& prefixKeys,
+    int32_t numCoveredKeys,
+    folly::Range<char**> rows,
+    memory::MemoryPool& pool) {
+  using Entry = PrefixEntry<kNumWords>;
+  const int32_t numKeys = container.keyTypes().size();
+  std::vector<Entry, memory::StlAllocator<Entry>> entries(
+      rows.size(), memory::StlAllocator<Entry>(pool));
+  char prefix[kNumWords * sizeof(uint64_t)];
+  for (auto i = 0; i < rows.size(); ++i) {
+    memset(prefix, 0, sizeof(prefix));
+    for (const auto& key : prefixKeys) {
+      encodeKey(key, rows[i], prefix);
+    }
+    for (auto word = 0; word < kNumWords; ++word) {
+      uint64_t value;
+      memcpy(&value, prefix + word * sizeof(uint64_t), sizeof(uint64_t));
+      entries[i].words[word] = folly::Endian::big(value);
+    }
+    entries[i].row = rows[i];
+  }
+
+  std::sort(
+      entries.begin(),
+      entries.end(),
+      [&](const PrefixEntry<kNumWords>& left,
+          const PrefixEntry<kNumWords>& right) {
+        for (auto word = 0; word < kNumWords; ++word) {
+          if (left.words[word] != right.words[word]) {
+            return left.words[word] < right.words[word];
+          }
+        }
+        for (auto index = numCoveredKeys; index < numKeys; ++index) {
+          if (auto result = container.compare(
+                  left.row,
+                  right.row,
+                  index,
+                  compareFlags.empty() ? CompareFlags()
+                                       : compareFlags[index])) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+} // namespace
+
+// static
+void PrefixSort::sort(
+    RowContainer& container,
+    const std::vector<CompareFlags>& compareFlags,
+    folly::Range<char**> rows,
+    memory::MemoryPool& pool) {
+  if (rows.size() < 2) {
+    return;
+  }
+  const auto& keyTypes = container.keyTypes();
+  VELOX_CHECK(compareFlags.empty() || compareFlags.size() == keyTypes.size());
+
+  // Lays out the leading keys that have an encoding and fit the prefix.
+  // 'numCoveredKeys' counts the keys whose encoding is complete.
+  std::vector<PrefixKey> prefixKeys;
+  int32_t numCoveredKeys = 0;
+  int32_t prefixBytes = 0;
+  for (auto i = 0; i < keyTypes.size(); ++i) {
+    const auto kind = keyTypes[i]->kind();
+    const auto flags = compareFlags.empty() ? CompareFlags() : compareFlags[i];
+    const auto width = fixedWidth(kind);
+    if (width > 0) {
+      if (prefixBytes + 1 + width > kMaxPrefixBytes) {
+        break;
+      }
+      prefixKeys.push_back(
+          {kind, container.columnAt(i), flags, prefixBytes, width});
+      prefixBytes += 1 + width;
+      ++numCoveredKeys;
+      continue;
+    }
+    if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      const auto size = kMaxPrefixBytes - prefixBytes - 1;
+      if (size > 0) {
+        prefixKeys.push_back(
+            {kind, container.columnAt(i), flags, prefixBytes, size});
+        prefixBytes = kMaxPrefixBytes;
+      }
+    }
+    break;
+  }
+
+  switch (bits::roundUp(prefixBytes, sizeof(uint64_t)) / sizeof(uint64_t)) {
+    case 1:
+      return sortWithPrefix<1>(
+          container, compareFlags, prefixKeys, numCoveredKeys, rows, pool);
+    case 2:
+      return sortWithPrefix<2>(
+          container, compareFlags, prefixKeys, numCoveredKeys, rows, pool);
+    case 3:
+      return sortWithPrefix<3>(
+          container, compareFlags, prefixKeys, numCoveredKeys, rows, pool);
+    case 4:
+      return sortWithPrefix<4>(
+          container, compareFlags, prefixKeys, numCoveredKeys, rows, pool);
+    default:
+      VELOX_CHECK_EQ(prefixBytes, 0);
+      std::sort(
+          rows.begin(), rows.end(), [&](const char* left, const char* right) {
+            return container.compareRows(left, right, compareFlags) < 0;
+          });
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts rows of a RowContainer on its keys using normalized key prefixes.
+///
+/// The leading keys are encoded into a fixed width prefix of at most
+/// kMaxPrefixBytes next to each row pointer. The encoding applies the null
+/// ordering and direction of the key's CompareFlags, so that comparing two
+/// prefixes as unsigned big endian words gives the order of the rows. The
+/// rows are compared with RowContainer::compare only on ties, starting at the
+/// first key that is not fully contained in the prefix. If all keys fit, ties
+/// are equal rows and need no further comparison.
+///
+/// Fixed width scalar keys are encoded in full. A VARCHAR or VARBINARY key
+/// takes the remaining bytes of the prefix and ends it. If the first key has
+/// no encoding, e.g. a complex type, the rows are sorted by comparing them
+/// key by key.
+class PrefixSort {
+ public:
+  static constexpr int32_t kMaxPrefixBytes = 32;
+
+  /// Sorts 'rows' of 'container' on the keys of 'container'. 'compareFlags'
+  /// has one element per key or is empty for the default flags. The prefixes
+  /// take up to kMaxPrefixBytes plus a pointer per row and are allocated from
+  /// 'pool'.
+  static void sort(
+      RowContainer& container,
+      const std::vector<CompareFlags>& compareFlags,
+      folly::Range<char**> rows,
+      memory::MemoryPool& pool);
+};
+
+} // namespace facebook::velox::exec
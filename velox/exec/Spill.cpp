@@ -15,19 +15,36 @@
  */
 
 #include "velox/exec/Spill.h"
+#include <folly/io/Cursor.h>
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
+namespace {
 // Spilling currently uses the default PrestoSerializer which by default
 // serializes timestamp with millisecond precision to maintain compatibility
 // with presto. Since velox's native timestamp implementation supports
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
-static const serializer::presto::PrestoVectorSerde::PrestoOptions
-    kDefaultSerdeOptions(/*useLosslessTimestamp*/ true);
+serializer::presto::PrestoVectorSerde::PrestoOptions makeSerdeOptions(
+    common::CompressionKind compressionKind) {
+  return serializer::presto::PrestoVectorSerde::PrestoOptions(
+      /*useLosslessTimestamp*/ true, compressionKind);
+}
+
+// Returns the size of the serialized presto page at the start of 'page' before
+// compression. The page header is the row count (4 bytes) and codec marker
+// (1 byte) followed by the uncompressed body size (4 bytes), the on-wire body
+// size (4 bytes) and the checksum (8 bytes).
+uint64_t uncompressedPageSize(const folly::IOBuf& page) {
+  constexpr int32_t kHeaderSize = 4 + 1 + 4 + 4 + 8;
+  folly::io::Cursor cursor(&page);
+  cursor.skip(4 + 1);
+  return kHeaderSize + cursor.read<int32_t>();
+}
+} // namespace
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
@@ -78,8 +95,9 @@ bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     return false;
   }
+  const auto serdeOptions = makeSerdeOptions(compressionKind_);
   VectorStreamGroup::read(
-      input_.get(), &pool_, type_, &rowVector, &kDefaultSerdeOptions);
+      input_.get(), &pool_, type_, &rowVector, &serdeOptions);
   return true;
 }
 
@@ -94,7 +112,8 @@ WriteFile& SpillFileList::currentOutput() {
         numSortingKeys_,
         sortCompareFlags_,
         fmt::format("{}-{}", path_, files_.size()),
-        pool_));
+        pool_,
+        compressionKind_));
   }
   return files_.back()->output();
 }
@@ -106,6 +125,7 @@ void SpillFileList::flush() {
     batch_->flush(&out);
     batch_.reset();
     auto iobuf = out.getIOBuf();
+    uncompressedBytes_ += uncompressedPageSize(*iobuf);
     auto& file = currentOutput();
     for (auto& range : *iobuf) {
       file.append(std::string_view(
@@ -119,10 +139,11 @@ void SpillFileList::write(
     const folly::Range<IndexRange*>& indices) {
   if (!batch_) {
     batch_ = std::make_unique<VectorStreamGroup>(&pool_);
+    const auto serdeOptions = makeSerdeOptions(compressionKind_);
     batch_->createStreamTree(
         std::static_pointer_cast<const RowType>(rows->type()),
         1000,
-        &kDefaultSerdeOptions);
+        &serdeOptions);
   }
   batch_->append(rows, indices);
 
@@ -182,7 +203,8 @@ void SpillState::appendToPartition(
         sortCompareFlags_,
         fmt::format("{}-spill-{}", path_, partition),
         targetFileSize_,
-        pool_);
+        pool_,
+        compressionKind_);
   }
 
   IndexRange range{0, rows->size()};
@@ -230,6 +252,16 @@ uint64_t SpillState::spilledBytes() const {
   return bytes;
 }
 
+uint64_t SpillState::spilledUncompressedBytes() const {
+  uint64_t bytes = 0;
+  for (auto& list : files_) {
+    if (list) {
+      bytes += list->spilledUncompressedBytes();
+    }
+  }
+  return bytes;
+}
+
 uint32_t SpillState::spilledPartitions() const {
   return spilledPartitionSet_.size();
 }
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
@@ -63,10 +64,12 @@ class SpillFile {
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE)
       : type_(std::move(type)),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
+        compressionKind_(compressionKind),
         pool_(pool),
         ordinal_(ordinalCounter_++),
         path_(fmt::format("{}-{}", path, ordinal_)) {
@@ -87,6 +90,10 @@ class SpillFile {
     return sortCompareFlags_;
   }
 
+  common::CompressionKind compressionKind() const {
+    return compressionKind_;
+  }
+
   /// Returns a file for writing spilled data. The caller constructs
   /// this, then calls output() and writes serialized data to the file
   /// and calls finishWrite when the file has reached its final
@@ -136,6 +143,9 @@ class SpillFile {
   const RowTypePtr type_;
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
+  // Codec used to compress the serialized pages in the file. The same codec
+  // is used to decompress them on read.
+  const common::CompressionKind compressionKind_;
   memory::MemoryPool& pool_;
 
   // Ordinal number used for making a label for debugging.
@@ -160,6 +170,7 @@ class SpillFileList {
   /// data is sorted. 'path' is a file path prefix. ' 'targetFileSize' is the
   /// target byte size of a single file in the file set. 'pool' is used for
   /// buffering and constructing the result data read from 'this'.
+  /// 'compressionKind' is the codec for compressing the serialized data.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -169,12 +180,14 @@ class SpillFileList {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE)
       : type_(type),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         path_(path),
         targetFileSize_(targetFileSize),
+        compressionKind_(compressionKind),
         pool_(pool) {
     // NOTE: if the associated spilling operator has specified the sort
     // comparison flags, then it must match the number of sorting keys.
@@ -204,6 +217,12 @@ class SpillFileList {
 
   uint64_t spilledBytes() const;
 
+  /// Returns the serialized byte size of the data written to 'this' before
+  /// compression. This equals spilledBytes() if compression is off.
+  uint64_t spilledUncompressedBytes() const {
+    return uncompressedBytes_;
+  }
+
   uint64_t spilledFiles() const {
     return files_.size();
   }
@@ -226,9 +245,12 @@ class SpillFileList {
   const std::vector<CompareFlags> sortCompareFlags_;
   const std::string path_;
   const uint64_t targetFileSize_;
+  const common::CompressionKind compressionKind_;
   memory::MemoryPool& pool_;
   std::unique_ptr<VectorStreamGroup> batch_;
   SpillFiles files_;
+  // Serialized bytes written to 'files_' before compression.
+  uint64_t uncompressedBytes_{0};
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -546,19 +568,21 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. 'compressionKind' is the codec for compressing spill files.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE)
       : path_(path),
         maxPartitions_(maxPartitions),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         targetFileSize_(targetFileSize),
+        compressionKind_(compressionKind),
         pool_(pool),
         files_(maxPartitions_) {}
 
@@ -588,6 +612,10 @@ class SpillState {
     return sortCompareFlags_;
   }
 
+  common::CompressionKind compressionKind() const {
+    return compressionKind_;
+  }
+
   bool isAllPartitionSpilled() const {
     VELOX_CHECK_LE(spilledPartitionSet_.size(), maxPartitions_);
     return spilledPartitionSet_.size() == maxPartitions_;
@@ -625,6 +653,9 @@ class SpillState {
 
   uint64_t spilledBytes() const;
 
+  /// Returns the serialized byte size of the spilled data before compression.
+  uint64_t spilledUncompressedBytes() const;
+
   /// Return the number of spilled partitions.
   uint32_t spilledPartitions() const;
 
@@ -643,6 +674,7 @@ class SpillState {
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const uint64_t targetFileSize_;
+  const common::CompressionKind compressionKind_;
 
   memory::MemoryPool& pool_;
 
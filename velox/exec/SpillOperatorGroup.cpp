@@ -83,6 +83,15 @@ void SpillOperatorGroup::operatorStopped(const Operator& op) {
   runSpill(promises);
 }
 
+bool SpillOperatorGroup::reclaim(const SpillRunner& reclaimRunner) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (state_ != State::kRunning || needSpill_ || !stoppedOperators_.empty()) {
+    return false;
+  }
+  reclaimRunner(operators_);
+  return true;
+}
+
 void SpillOperatorGroup::start() {
   std::lock_guard<std::mutex> l(mutex_);
   VELOX_CHECK_EQ(
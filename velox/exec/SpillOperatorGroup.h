@@ -110,6 +110,13 @@ class SpillOperatorGroup {
   /// spill for the group.
   bool waitSpill(Operator& op, ContinueFuture& future);
 
+  /// Invoked by external memory management to run 'reclaimRunner' on all the
+  /// operators of the group while their drivers are paused. The function
+  /// returns false without running it if the group is not running, has a
+  /// pending spill or any operator has stopped, as the operators can't then
+  /// change their spill state consistently.
+  bool reclaim(const SpillRunner& reclaimRunner);
+
  private:
   void checkStoppedStateLocked() const;
 
@@ -18,6 +18,7 @@
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PrefixSort.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -37,7 +38,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::CompressionKind compressionKind)
     : Spiller(
           type,
           container,
@@ -50,7 +52,8 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
+          executor,
+          compressionKind) {
   VELOX_CHECK_EQ(type_, Type::kOrderBy);
 }
 
@@ -62,7 +65,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* FOLLY_NULLABLE executor)
+    folly::Executor* FOLLY_NULLABLE executor,
+    common::CompressionKind compressionKind)
     : Spiller(
           type,
           nullptr,
@@ -75,7 +79,8 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
+          executor,
+          compressionKind) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
 }
 
@@ -91,7 +96,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::CompressionKind compressionKind)
     : type_(type),
       container_(container),
       eraser_(eraser),
@@ -104,7 +110,8 @@ Spiller::Spiller(
           numSortingKeys,
           sortCompareFlags,
           targetFileSize,
-          pool),
+          pool,
+          compressionKind),
       pool_(pool),
       executor_(executor) {
   TestValue::adjust(
@@ -242,13 +249,11 @@ std::unique_ptr<SpillMergeStream> Spiller::spillMergeStreamOverRows(
 void Spiller::ensureSorted(SpillRun& run) {
   // The spill data of a hash join doesn't need to be sorted.
   if (!run.sorted && needSort()) {
-    std::sort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    PrefixSort::sort(
+        *container_,
+        state_.sortCompareFlags(),
+        folly::Range<char**>(run.rows.data(), run.rows.size()),
+        pool_);
     run.sorted = true;
   }
 }
@@ -655,4 +660,91 @@ memory::MemoryPool& Spiller::spillPool() {
   return *pool;
 }
 
+// static
+void Spiller::ensureInputFits(
+    const RowContainer& container,
+    const RowVector& input,
+    const Config& config,
+    uint64_t spillMemoryThreshold,
+    memory::MemoryUsageTracker& tracker,
+    uint64_t& spillTestCounter,
+    const std::function<void(int64_t targetRows, int64_t targetBytes)>&
+        spill,
+    std::optional<int64_t> numNewRows) {
+  const int64_t numRows = container.numRows();
+  if (numRows == 0) {
+    // 'container' is empty. Nothing to spill.
+    return;
+  }
+  auto [freeRows, outOfLineFreeBytes] = container.freeSpace();
+  const auto outOfLineBytes =
+      container.stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input.estimateFlatSize();
+
+  // Test-only spill path.
+  if (config.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter)) % 100 <=
+          config.testSpillPct) {
+    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
+    spill(
+        numRows - rowsToSpill,
+        outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
+    return;
+  }
+
+  const auto currentUsage = tracker.currentBytes();
+  if (spillMemoryThreshold != 0 && currentUsage > spillMemoryThreshold) {
+    const int64_t bytesToSpill =
+        currentUsage * config.spillableReservationGrowthPct / 100;
+    auto rowsToSpill = std::max<int64_t>(
+        1, bytesToSpill / (container.fixedRowSize() + outOfLineBytesPerRow));
+    spill(
+        std::max<int64_t>(0, numRows - rowsToSpill),
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  if (freeRows > input.size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    // Enough free rows for input rows and enough variable length free
+    // space for the flat size of the whole vector. If outOfLineBytes
+    // is 0 there is no need for variable length space.
+    return;
+  }
+
+  const int64_t numInputRows = numNewRows.value_or(input.size());
+  if (numInputRows == 0 && outOfLineBytes == 0) {
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes = container.sizeIncrement(
+      numInputRows, outOfLineBytes ? flatInputBytes : 0);
+
+  // There must be at least 2x the increment in reservation.
+  if (tracker.availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+
+  // Check if can increase reservation. The increment is the larger of twice the
+  // maximum increment from this input and 'spillableReservationGrowthPct' of
+  // the current reservation.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * config.spillableReservationGrowthPct / 100);
+  if (tracker.maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1,
+      targetIncrementBytes / (container.fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/compression/Compression.h"
 #include "velox/exec/HashBitRange.h"
 #include "velox/exec/RowContainer.h"
 
@@ -47,7 +48,8 @@ class Spiller {
         int32_t _spillableReservationGrowthPct,
         const HashBitRange& _hashBitRange,
         int32_t _maxSpillLevel,
-        int32_t _testSpillPct)
+        int32_t _testSpillPct,
+        common::CompressionKind _compressionKind = common::CompressionKind_NONE)
         : filePath(_filePath),
           maxFileSize(
               _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -57,7 +59,8 @@ class Spiller {
           spillableReservationGrowthPct(_spillableReservationGrowthPct),
           hashBitRange(_hashBitRange),
           maxSpillLevel(_maxSpillLevel),
-          testSpillPct(_testSpillPct) {}
+          testSpillPct(_testSpillPct),
+          compressionKind(_compressionKind) {}
 
     /// Returns the spilling level with given 'startBitOffset'.
     ///
@@ -104,6 +107,10 @@ class Spiller {
     // Percentage of input batches to be spilled for testing. 0 means no
     // spilling for test.
     int32_t testSpillPct;
+
+    // Codec for compressing spill files. Spilling is usually bound by disk
+    // bandwidth, so a fast codec such as LZ4 trades a little CPU for less IO.
+    common::CompressionKind compressionKind;
   };
 
   using SpillRows = std::vector<char*, memory::StlAllocator<char*>>;
@@ -121,7 +128,8 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE);
 
   Spiller(
       Type type,
@@ -131,7 +139,8 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE);
 
   Spiller(
       Type type,
@@ -145,7 +154,8 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE);
 
   /// Spills rows from 'this' until there are under 'targetRows' rows
   /// and 'targetBytes' of allocated variable length space in use. spill()
@@ -255,22 +265,29 @@ class Spiller {
 
   /// Define the spiller stats.
   struct Stats {
+    /// The bytes written to spill files. This is after compression if the
+    /// spill files are compressed.
     uint64_t spilledBytes{0};
     uint64_t spilledRows{0};
     /// NOTE: when we sum up the stats from a group of spill operators, it is
     /// the total number of spilled partitions X number of operators.
     uint32_t spilledPartitions{0};
     uint64_t spilledFiles{0};
+    /// The serialized bytes of the spilled data before compression. Equals
+    /// 'spilledBytes' if the spill files are not compressed.
+    uint64_t spilledUncompressedBytes{0};
 
     Stats(
         uint64_t _spilledBytes,
         uint64_t _spilledRows,
         uint32_t _spilledPartitions,
-        uint64_t _spilledFiles)
+        uint64_t _spilledFiles,
+        uint64_t _spilledUncompressedBytes = 0)
         : spilledBytes(_spilledBytes),
           spilledRows(_spilledRows),
           spilledPartitions(_spilledPartitions),
-          spilledFiles(_spilledFiles) {}
+          spilledFiles(_spilledFiles),
+          spilledUncompressedBytes(_spilledUncompressedBytes) {}
 
     Stats() = default;
 
@@ -279,6 +296,7 @@ class Spiller {
       spilledRows += other.spilledRows;
       spilledPartitions += other.spilledPartitions;
       spilledFiles += other.spilledFiles;
+      spilledUncompressedBytes += other.spilledUncompressedBytes;
       return *this;
     }
   };
@@ -288,7 +306,8 @@ class Spiller {
         state_.spilledBytes(),
         spilledRows_,
         state_.spilledPartitions(),
-        spilledFiles()};
+        spilledFiles(),
+        state_.spilledUncompressedBytes()};
   }
 
   /// Return the number of spilled files we have.
@@ -305,6 +324,25 @@ class Spiller {
   // is the expected peak utilization.
   static memory::MemoryPool& spillPool();
 
+  /// Spills rows of 'container' if 'input' may not fit in the memory
+  /// reservation of 'tracker'. Shared by the operators that spill a whole
+  /// RowContainer as sorted runs, like OrderBy and Window. 'spill' is called
+  /// with the number of rows and of out of line bytes to keep in
+  /// 'container'. 'spillTestCounter' drives the test-only spill path of
+  /// 'config'. 'numNewRows' is the number of rows 'input' may add to
+  /// 'container' if not all of 'input', e.g. for TopN that reuses the rows it
+  /// replaces.
+  static void ensureInputFits(
+      const RowContainer& container,
+      const RowVector& input,
+      const Config& config,
+      uint64_t spillMemoryThreshold,
+      memory::MemoryUsageTracker& tracker,
+      uint64_t& spillTestCounter,
+      const std::function<void(int64_t targetRows, int64_t targetBytes)>&
+          spill,
+      std::optional<int64_t> numNewRows = std::nullopt);
+
   std::string toString() const;
 
  private:
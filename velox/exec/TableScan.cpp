@@ -34,6 +34,20 @@ TableScan::TableScan(
       columnHandles_(tableScanNode->assignments()),
       driverCtx_(driverCtx) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+
+  const auto maxSplitPreloadPerDriver =
+      driverCtx_->queryConfig().maxSplitPreloadPerDriver();
+  if (maxSplitPreloadPerDriver > 0 && connector_->supportsSplitPreload() &&
+      connector_->executor() != nullptr) {
+    // All drivers of the pipeline take splits from the same queue. Look past
+    // the splits the other drivers are about to take.
+    maxPreloadedSplits_ = maxSplitPreloadPerDriver *
+        driverCtx_->task->numDrivers(driverCtx_->pipelineId);
+    splitPreloader_ =
+        [this](const std::shared_ptr<connector::ConnectorSplit>& split) {
+          preload(split);
+        };
+  }
 }
 
 RowVectorPtr TableScan::getOutput() {
@@ -45,7 +59,13 @@ RowVectorPtr TableScan::getOutput() {
     if (needNewSplit_) {
       exec::Split split;
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId, planNodeId(), split, blockingFuture_);
+          driverCtx_->splitGroupId,
+          planNodeId(),
+          split,
+          blockingFuture_,
+          maxPreloadedSplits_,
+          splitPreloader_);
+      schedulePreloads();
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
       }
@@ -67,6 +87,13 @@ RowVectorPtr TableScan::getOutput() {
             lockedStats->runtimeStats.at(name).addValue(counter.value);
           }
         }
+        if (numPreloadedSplits_ > 0) {
+          auto lockedStats = stats_.wlock();
+          lockedStats->addRuntimeStat(
+              "preloadedSplits", RuntimeCounter(numPreloadedSplits_));
+          lockedStats->addRuntimeStat(
+              "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
+        }
         return nullptr;
       }
 
@@ -96,7 +123,7 @@ RowVectorPtr TableScan::getOutput() {
           "Split {} Task {}",
           connectorSplit->toString(),
           operatorCtx_->task()->taskId());
-      dataSource_->addSplit(connectorSplit);
+      addSplit(connectorSplit);
       ++stats_.wlock()->numSplits;
       setBatchSize();
     }
@@ -139,6 +166,76 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+void TableScan::addSplit(
+    const std::shared_ptr<connector::ConnectorSplit>& split) {
+  if (split->dataSource) {
+    ++numPreloadedSplits_;
+    numReadyPreloadedSplits_ += split->dataSource->hasValue();
+    // Waits if the preload is in progress and opens the split on this thread
+    // if the preload has not started yet. Returns nullptr if the preload was
+    // skipped because the task stopped.
+    auto preparedDataSource = split->dataSource->move();
+    if (preparedDataSource != nullptr && *preparedDataSource != nullptr) {
+      dataSource_->setFromDataSource(std::move(*preparedDataSource));
+      return;
+    }
+  }
+  dataSource_->addSplit(split);
+}
+
+namespace {
+// A preloaded DataSource together with the ConnectorQueryCtx it refers to.
+struct PreloadedDataSource {
+  std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx;
+  std::shared_ptr<connector::DataSource> dataSource;
+};
+} // namespace
+
+void TableScan::preload(
+    const std::shared_ptr<connector::ConnectorSplit>& split) {
+  using DataSourcePtr = std::shared_ptr<connector::DataSource>;
+  // This runs under the task's mutex, so the DataSource is created by the
+  // AsyncSource on the executor or on the consuming driver. The AsyncSource
+  // may outlive this operator and may be consumed by another driver, so it
+  // does not refer to this operator. The ConnectorQueryCtx has its own
+  // evaluator and holds the task, which owns the memory pools. The AsyncSource
+  // refers to 'split' weakly since 'split' owns it.
+  split->dataSource = std::make_shared<AsyncSource<DataSourcePtr>>(
+      [connector = connector_,
+       outputType = outputType_,
+       tableHandle = tableHandle_,
+       columnHandles = columnHandles_,
+       connectorQueryCtx = operatorCtx_->createTaskScopedConnectorQueryCtx(
+           split->connectorId, planNodeId()),
+       task = operatorCtx_->task(),
+       weakSplit = std::weak_ptr<connector::ConnectorSplit>(split)]()
+          -> std::unique_ptr<DataSourcePtr> {
+        auto split = weakSplit.lock();
+        if (split == nullptr || split->cancelled || !task->isRunning()) {
+          return nullptr;
+        }
+        auto preloaded = std::make_shared<PreloadedDataSource>();
+        preloaded->connectorQueryCtx = connectorQueryCtx;
+        preloaded->dataSource = connector->createDataSource(
+            outputType, tableHandle, columnHandles, connectorQueryCtx.get());
+        preloaded->dataSource->addSplit(split);
+        // Aliases 'preloaded' so that the ConnectorQueryCtx lives as long as
+        // the DataSource.
+        auto* dataSource = preloaded->dataSource.get();
+        return std::make_unique<DataSourcePtr>(
+            std::move(preloaded), dataSource);
+      });
+  pendingPreloads_.push_back(split->dataSource);
+}
+
+void TableScan::schedulePreloads() {
+  for (auto& source : pendingPreloads_) {
+    connector_->executor()->add(
+        [source = std::move(source)]() { source->prepare(); });
+  }
+  pendingPreloads_.clear();
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
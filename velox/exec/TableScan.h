@@ -53,6 +53,20 @@ class TableScan : public SourceOperator {
   // Adjust batch size according to split information.
   void setBatchSize();
 
+  // Sets the 'dataSource' of 'split' to an AsyncSource that creates a new
+  // DataSource and adds 'split' to it. Called by Task::getSplitOrFuture()
+  // under the task's mutex for queued splits. The AsyncSource is scheduled on
+  // the connector's executor by schedulePreloads() after the mutex is
+  // released.
+  void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
+
+  // Schedules the AsyncSources made by preload() on the connector's executor.
+  void schedulePreloads();
+
+  // Adds 'split' to 'dataSource_', taking over the preloaded DataSource of
+  // 'split' if there is one.
+  void addSplit(const std::shared_ptr<connector::ConnectorSplit>& split);
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -70,6 +84,20 @@ class TableScan : public SourceOperator {
       pendingDynamicFilters_;
   int32_t readBatchSize_{kDefaultBatchSize};
 
+  // Number of queued splits to preload when taking a split. Zero if the
+  // connector does not support preloading.
+  int32_t maxPreloadedSplits_{0};
+  std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
+      splitPreloader_{nullptr};
+  // AsyncSources made by preload() that are not scheduled yet.
+  std::vector<
+      std::shared_ptr<AsyncSource<std::shared_ptr<connector::DataSource>>>>
+      pendingPreloads_;
+  // Number of splits that came with a preloaded DataSource and how many of
+  // these were ready by the time they were needed.
+  int32_t numPreloadedSplits_{0};
+  int32_t numReadyPreloadedSplits_{0};
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 };
@@ -16,6 +16,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/QueuedImmediateExecutor.h>
 #include <string>
 
 #include "velox/codegen/Codegen.h"
@@ -26,6 +28,7 @@
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/LocalPlanner.h"
 #include "velox/exec/Merge.h"
+#include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/Task.h"
 #if CODEGEN_ENABLED == 1
@@ -57,6 +60,38 @@ std::string errorMessageImpl(const std::exception_ptr& exception) {
   return message;
 }
 
+// Lets the memory arbitrator free memory of a Task by spilling.
+class TaskMemoryReclaimer : public memory::MemoryReclaimer {
+ public:
+  explicit TaskMemoryReclaimer(std::weak_ptr<Task> task)
+      : task_(std::move(task)) {}
+
+  void enterArbitration() override {
+    if (auto task = task_.lock()) {
+      task->enterArbitration();
+    }
+  }
+
+  void leaveArbitration() override {
+    if (auto task = task_.lock()) {
+      task->leaveArbitration();
+    }
+  }
+
+  int64_t reclaimableBytes() const override {
+    auto task = task_.lock();
+    return task != nullptr ? task->reclaimableBytes() : 0;
+  }
+
+  int64_t reclaim(int64_t targetBytes) override {
+    auto task = task_.lock();
+    return task != nullptr ? task->reclaim(targetBytes) : 0;
+  }
+
+ private:
+  const std::weak_ptr<Task> task_;
+};
+
 } // namespace
 
 std::atomic<uint64_t> Task::numCreatedTasks_ = 0;
@@ -390,6 +425,13 @@ void Task::start(
   // Drivers. 'drivers_' can be read by memory recovery or
   // cancellation while Drivers are being made, so the array should
   // have final size from the start.
+  self->memoryReclaimer_ = std::make_shared<TaskMemoryReclaimer>(self);
+  if (auto* arbitrator =
+          memory::getProcessDefaultMemoryManager().arbitrator()) {
+    arbitrator->addReclaimer(
+        self->queryCtx()->pool()->getMemoryUsageTracker().get(),
+        self->memoryReclaimer_);
+  }
 
   auto bufferManager = self->bufferManager_.lock();
   VELOX_CHECK_NOT_NULL(
@@ -517,6 +559,8 @@ void Task::createSplitGroupStateLocked(
         splitGroupId, factory->needsHashJoinBridges());
     self->addCrossJoinBridgesLocked(
         splitGroupId, factory->needsCrossJoinBridges());
+    self->addNestedLoopJoinBridgesLocked(
+        splitGroupId, factory->needsNestedLoopJoinBridges());
     self->addCustomJoinBridgesLocked(splitGroupId, factory->planNodes);
   }
 }
@@ -911,24 +955,38 @@ BlockingReason Task::getSplitOrFuture(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
     exec::Split& split,
-    ContinueFuture& future) {
+    ContinueFuture& future,
+    int32_t maxPreloadSplits,
+    const std::function<void(
+        const std::shared_ptr<connector::ConnectorSplit>&)>& preload) {
   std::lock_guard<std::mutex> l(mutex_);
 
   auto& splitsState = splitsStates_[planNodeId];
 
   if (isUngroupedExecution()) {
     return getSplitOrFutureLocked(
-        splitsState.groupSplitsStores[0], split, future);
+        splitsState.groupSplitsStores[0],
+        split,
+        future,
+        maxPreloadSplits,
+        preload);
   } else {
     return getSplitOrFutureLocked(
-        splitsState.groupSplitsStores[splitGroupId], split, future);
+        splitsState.groupSplitsStores[splitGroupId],
+        split,
+        future,
+        maxPreloadSplits,
+        preload);
   }
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
     SplitsStore& splitsStore,
     exec::Split& split,
-    ContinueFuture& future) {
+    ContinueFuture& future,
+    int32_t maxPreloadSplits,
+    const std::function<void(
+        const std::shared_ptr<connector::ConnectorSplit>&)>& preload) {
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -941,6 +999,18 @@ BlockingReason Task::getSplitOrFutureLocked(
   }
 
   split = getSplitLocked(splitsStore);
+
+  if (preload) {
+    // 'dataSource' is set under 'mutex_', so each split is preloaded once.
+    const auto numSplits = std::min<int32_t>(
+        splitsStore.splits.size(), std::max(maxPreloadSplits, 0));
+    for (auto i = 0; i < numSplits; ++i) {
+      const auto& connectorSplit = splitsStore.splits[i].connectorSplit;
+      if (connectorSplit && !connectorSplit->dataSource) {
+        preload(connectorSplit);
+      }
+    }
+  }
   return BlockingReason::kNotBlocked;
 }
 
@@ -1169,6 +1239,16 @@ void Task::addCrossJoinBridgesLocked(
   }
 }
 
+void Task::addNestedLoopJoinBridgesLocked(
+    uint32_t splitGroupId,
+    const std::vector<core::PlanNodeId>& planNodeIds) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  for (const auto& planNodeId : planNodeIds) {
+    splitGroupState.bridges.emplace(
+        planNodeId, std::make_shared<NestedLoopJoinBridge>());
+  }
+}
+
 std::shared_ptr<HashJoinBridge> Task::getHashJoinBridge(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
@@ -1187,6 +1267,12 @@ std::shared_ptr<CrossJoinBridge> Task::getCrossJoinBridge(
   return getJoinBridgeInternal<CrossJoinBridge>(splitGroupId, planNodeId);
 }
 
+std::shared_ptr<NestedLoopJoinBridge> Task::getNestedLoopJoinBridge(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  return getJoinBridgeInternal<NestedLoopJoinBridge>(splitGroupId, planNodeId);
+}
+
 template <class TBridgeType>
 std::shared_ptr<TBridgeType> Task::getJoinBridgeInternal(
     uint32_t splitGroupId,
@@ -1329,6 +1415,13 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       auto& splitState = pair.second;
       for (auto& it : pair.second.groupSplitsStores) {
         movePromisesOut(it.second.splitPromises, splitPromises);
+        // Preloaded DataSources hold the task. Drop these of the queued
+        // splits to not keep the task alive.
+        for (auto& split : it.second.splits) {
+          if (split.connectorSplit) {
+            split.connectorSplit->dataSource.reset();
+          }
+        }
       }
 
       // Process remaining remote splits.
@@ -1762,6 +1855,107 @@ StopReason Task::leaveSuspended(ThreadState& state) {
   }
 }
 
+int64_t Task::reclaimableBytes() {
+  int64_t reclaimableBytes = 0;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& driver : drivers_) {
+    if (driver == nullptr) {
+      continue;
+    }
+    for (auto* op : driver->operators()) {
+      if (op->canReclaim()) {
+        reclaimableBytes += op->pool()->getMemoryUsageTracker()->currentBytes();
+      }
+    }
+  }
+  return reclaimableBytes;
+}
+
+int64_t Task::reclaim(int64_t targetBytes) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!isRunningLocked() || pauseRequested_) {
+      return 0;
+    }
+  }
+  auto& executor = folly::QueuedImmediateExecutor::instance();
+  requestPause(true).via(&executor).wait();
+  auto self = shared_from_this();
+  SCOPE_EXIT {
+    if (self->isRunning()) {
+      Task::resume(self);
+    }
+  };
+
+  std::vector<std::shared_ptr<Driver>> drivers;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& driver : drivers_) {
+      if (driver == nullptr) {
+        continue;
+      }
+      if (driver->state().isSuspended) {
+        return 0;
+      }
+      drivers.push_back(driver);
+    }
+  }
+
+  const auto& tracker = pool_->getMemoryUsageTracker();
+  const int64_t reservedBytes = tracker->reservedBytes();
+  for (const auto& driver : drivers) {
+    for (auto* op : driver->operators()) {
+      const int64_t reclaimedBytes = reservedBytes - tracker->reservedBytes();
+      if (reclaimedBytes >= targetBytes) {
+        return reclaimedBytes;
+      }
+      if (op->canReclaim()) {
+        op->reclaim(targetBytes - reclaimedBytes);
+      }
+    }
+  }
+  return reservedBytes - tracker->reservedBytes();
+}
+
+void Task::enterArbitration() {
+  std::shared_ptr<Driver> driver;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& candidate : drivers_) {
+      if (candidate != nullptr &&
+          candidate->state().thread == std::this_thread::get_id() &&
+          !candidate->state().isSuspended) {
+        driver = candidate;
+        break;
+      }
+    }
+  }
+  if (driver == nullptr) {
+    return;
+  }
+  enterSuspended(driver->state());
+  std::lock_guard<std::mutex> l(mutex_);
+  if (driver->state().isSuspended) {
+    arbitrationDrivers_[std::this_thread::get_id()] = driver.get();
+  }
+}
+
+void Task::leaveArbitration() {
+  Driver* driver;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = arbitrationDrivers_.find(std::this_thread::get_id());
+    if (it == arbitrationDrivers_.end()) {
+      return;
+    }
+    driver = it->second;
+    arbitrationDrivers_.erase(it);
+  }
+  // A terminate is detected by the Driver when it returns from the operator
+  // that made the memory reservation.
+  leaveSuspended(driver->state());
+}
+
 StopReason Task::shouldStop() {
   if (terminateRequested_) {
     return StopReason::kTerminate;
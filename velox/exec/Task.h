@@ -30,6 +30,7 @@ class PartitionedOutputBufferManager;
 
 class HashJoinBridge;
 class CrossJoinBridge;
+class NestedLoopJoinBridge;
 
 class Task : public std::enable_shared_from_this<Task> {
  public:
@@ -242,6 +243,11 @@ class Task : public std::enable_shared_from_this<Task> {
     return numDrivers(getOutputPipelineId());
   }
 
+  /// Returns the number of drivers in the specified pipeline.
+  uint32_t numDrivers(int pipelineId) const {
+    return driverFactories_[pipelineId]->numDrivers;
+  }
+
   /// Returns the number of running drivers.
   uint32_t numRunningDrivers() const {
     std::lock_guard<std::mutex> taskLock(mutex_);
@@ -290,12 +296,22 @@ class Task : public std::enable_shared_from_this<Task> {
   // specified ID. If there are no splits and no-more-splits signal has been
   // received, sets split to null and returns kNotBlocked. Otherwise, returns
   // kWaitForSplit and sets a future that will complete when split becomes
-  // available or no-more-splits signal is received.
+  // available or no-more-splits signal is received. If 'maxPreloadSplits' is
+  // positive, calls 'preload' on up to that many of the splits that remain
+  // queued after 'split' and are not being preloaded yet. 'preload' is called
+  // under the task's mutex and must set the 'dataSource' of the split. It must
+  // not block, allocate from memory pools or create the DataSource: the
+  // DataSource is to be created by the AsyncSource after the mutex is
+  // released.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
-      ContinueFuture& future);
+      ContinueFuture& future,
+      int32_t maxPreloadSplits = 0,
+      const std::function<void(
+          const std::shared_ptr<connector::ConnectorSplit>&)>& preload =
+          nullptr);
 
   void splitFinished();
 
@@ -372,6 +388,11 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const std::vector<core::PlanNodeId>& planNodeIds);
 
+  // Adds NestedLoopJoinBridge's for all the specified plan node IDs.
+  void addNestedLoopJoinBridgesLocked(
+      uint32_t splitGroupId,
+      const std::vector<core::PlanNodeId>& planNodeIds);
+
   // Adds custom join bridges for all the specified plan nodes.
   void addCustomJoinBridgesLocked(
       uint32_t splitGroupId,
@@ -394,6 +415,11 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  // Returns a NestedLoopJoinBridge for 'planNodeId'.
+  std::shared_ptr<NestedLoopJoinBridge> getNestedLoopJoinBridge(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   // Returns a custom join bridge for 'planNodeId'.
   std::shared_ptr<JoinBridge> getCustomJoinBridge(
       uint32_t splitGroupId,
@@ -459,6 +485,31 @@ class Task : public std::enable_shared_from_this<Task> {
 
   ContinueFuture requestPauseLocked(bool pause);
 
+  /// Returns the memory used by the operators of 'this' that can free memory
+  /// on request of a memory arbitrator.
+  int64_t reclaimableBytes();
+
+  /// Frees memory on request of a memory arbitrator by pausing 'this' and
+  /// asking its reclaimable operators to spill. Returns the number of bytes
+  /// freed. Does nothing if 'this' is not running, is already paused or has a
+  /// Driver in a suspended section, as such a Driver may use its operators.
+  int64_t reclaim(int64_t targetBytes);
+
+  /// Returns the reclaimer that lets a memory arbitrator free memory of
+  /// 'this'. Null before start.
+  const std::shared_ptr<memory::MemoryReclaimer>& memoryReclaimer() const {
+    return memoryReclaimer_;
+  }
+
+  /// Called by the memory arbitrator on a thread of 'this' that requests more
+  /// memory. Puts the Driver running on the calling thread, if any, into a
+  /// suspended section so that 'this' can be paused while the thread waits
+  /// for other queries to free memory.
+  void enterArbitration();
+
+  /// Leaves the suspended section entered by enterArbitration().
+  void leaveArbitration();
+
   // Requests activity of 'this' to stop. The returned future will be
   // realized when the last thread stops running for 'this'. This is used to
   // mark cancellation by the user.
@@ -551,7 +602,10 @@ class Task : public std::enable_shared_from_this<Task> {
   BlockingReason getSplitOrFutureLocked(
       SplitsStore& splitsStore,
       exec::Split& split,
-      ContinueFuture& future);
+      ContinueFuture& future,
+      int32_t maxPreloadSplits,
+      const std::function<void(
+          const std::shared_ptr<connector::ConnectorSplit>&)>& preload);
 
   /// Returns next split from the store. The caller must ensure the store is not
   /// empty.
@@ -633,10 +687,6 @@ class Task : public std::enable_shared_from_this<Task> {
     return driverFactories_[pipelineId]->outputDriver;
   }
 
-  uint32_t numDrivers(int pipelineId) const {
-    return driverFactories_[pipelineId]->numDrivers;
-  }
-
   int getOutputPipelineId() const;
 
   /// Callback function added to the MemoryUsageTracker to return a descriptive
@@ -778,6 +828,14 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
   std::vector<std::shared_ptr<Driver>> drivers_;
+
+  // Frees memory of 'this' on request of a memory arbitrator. Set on start
+  // and registered with the arbitrator of the process memory manager, if any.
+  std::shared_ptr<memory::MemoryReclaimer> memoryReclaimer_;
+
+  // The Drivers put into a suspended section by enterArbitration(), keyed by
+  // the thread running them.
+  std::unordered_map<std::thread::id, Driver*> arbitrationDrivers_;
   /// The total number of running drivers in all pipelines.
   /// This number changes over time as drivers finish their work and maybe new
   /// get created.
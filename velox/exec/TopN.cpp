@@ -15,9 +15,82 @@
  */
 #include "velox/exec/TopN.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::vector<column_index_t> sortingKeyChannels(
+    const RowTypePtr& type,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys) {
+  std::vector<column_index_t> channels;
+  channels.reserve(sortingKeys.size());
+  for (const auto& key : sortingKeys) {
+    auto channel = exprToChannel(key.get(), type);
+    VELOX_CHECK(
+        channel != kConstantChannel,
+        "TopN doesn't allow constant comparison keys");
+    channels.push_back(channel);
+  }
+  return channels;
+}
+
+std::vector<CompareFlags> sortingCompareFlags(
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> flags;
+  flags.reserve(sortingOrders.size());
+  for (const auto& order : sortingOrders) {
+    flags.push_back({order.isNullsFirst(), order.isAscending(), false, false});
+  }
+  return flags;
+}
+
+// Stores the sorting keys first in the row container, followed by the other
+// columns as dependents.
+std::vector<IdentityProjection> makeColumnMap(
+    const RowTypePtr& type,
+    const std::vector<column_index_t>& keyChannels) {
+  std::vector<IdentityProjection> columnMap;
+  std::unordered_set<column_index_t> keyChannelSet;
+  for (auto i = 0; i < keyChannels.size(); ++i) {
+    columnMap.emplace_back(i, keyChannels[i]);
+    keyChannelSet.insert(keyChannels[i]);
+  }
+  for (column_index_t outputChannel = 0, nextInputChannel = keyChannels.size();
+       outputChannel < type->size();
+       ++outputChannel) {
+    if (keyChannelSet.count(outputChannel) == 0) {
+      columnMap.emplace_back(nextInputChannel++, outputChannel);
+    }
+  }
+  return columnMap;
+}
+
+RowTypePtr makeStoreType(
+    const RowTypePtr& type,
+    const std::vector<IdentityProjection>& columnMap) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& projection : columnMap) {
+    names.push_back(type->nameOf(projection.outputChannel));
+    types.push_back(type->childAt(projection.outputChannel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+std::unique_ptr<RowContainer> makeRowContainer(
+    const RowTypePtr& storeType,
+    int32_t numKeys,
+    memory::MemoryPool* pool) {
+  const auto& types = storeType->children();
+  return std::make_unique<RowContainer>(
+      std::vector<TypePtr>(types.begin(), types.begin() + numKeys),
+      std::vector<TypePtr>(types.begin() + numKeys, types.end()),
+      pool);
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,33 +102,22 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
-      comparator_(
-          outputType_,
-          topNNode->sortingKeys(),
-          topNNode->sortingOrders(),
-          data_.get()),
+      spillConfig_(
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? operatorCtx_->makeSpillConfig(Spiller::Type::kOrderBy)
+              : std::nullopt),
+      keyChannels_(sortingKeyChannels(outputType_, topNNode->sortingKeys())),
+      keyCompareFlags_(sortingCompareFlags(topNNode->sortingOrders())),
+      columnMap_(makeColumnMap(outputType_, keyChannels_)),
+      internalStoreType_(makeStoreType(outputType_, columnMap_)),
+      data_(makeRowContainer(internalStoreType_, keyChannels_.size(), pool())),
+      comparator_(keyChannels_, keyCompareFlags_, data_.get()),
       topRows_(comparator_),
       decodedVectors_(outputType_->children().size()) {}
 
-TopN::Comparator::Comparator(
-    const RowTypePtr& type,
-    const std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>&
-        sortingKeys,
-    const std::vector<core::SortOrder>& sortingOrders,
-    RowContainer* rowContainer)
-    : rowContainer_(rowContainer) {
-  auto numKeys = sortingKeys.size();
-  for (int i = 0; i < numKeys; ++i) {
-    auto channel = exprToChannel(sortingKeys[i].get(), type);
-    VELOX_CHECK(
-        channel != kConstantChannel,
-        "TopN doesn't allow constant comparison keys");
-    keyInfo_.push_back(std::make_pair(channel, sortingOrders[i]));
-  }
-}
-
 void TopN::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
   SelectivityVector allRows(input->size());
 
   // TODO Decode keys first, then decode the rest only for passing positions
@@ -64,6 +126,10 @@ void TopN::addInput(RowVectorPtr input) {
   }
 
   for (int row = 0; row < input->size(); ++row) {
+    if (!spillCutoff_.empty() && compareKeys(spillCutoff_, *input, row) < 0) {
+      // At least 'count_' spilled rows sort before this row.
+      continue;
+    }
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -78,12 +144,233 @@ void TopN::addInput(RowVectorPtr input) {
       newRow = data_->initializeRow(topRow, true /* reuse */);
     }
 
-    for (int col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedVectors_[col], row, newRow, col);
+    for (const auto& projection : columnMap_) {
+      data_->store(
+          decodedVectors_[projection.outputChannel],
+          row,
+          newRow,
+          projection.inputChannel);
     }
 
     topRows_.push(newRow);
   }
+
+  pushdownCutoff();
+}
+
+int32_t TopN::compareKeys(
+    const std::vector<VectorPtr>& keys,
+    const RowVector& input,
+    vector_size_t index) const {
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto result = keys[i]->compare(
+        input.childAt(keyChannels_[i]).get(), 0, index, keyCompareFlags_[i]);
+    if (result.value() != 0) {
+      return result.value();
+    }
+  }
+  return 0;
+}
+
+int32_t TopN::compareKeys(
+    const std::vector<VectorPtr>& left,
+    const std::vector<VectorPtr>& right) const {
+  for (auto i = 0; i < left.size(); ++i) {
+    const auto result =
+        left[i]->compare(right[i].get(), 0, 0, keyCompareFlags_[i]);
+    if (result.value() != 0) {
+      return result.value();
+    }
+  }
+  return 0;
+}
+
+void TopN::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+  // Once all input is received the rows are returned from memory or merged
+  // from spill files. Neither state can be spilled.
+  if (noMoreInput_ || data_->numRows() == 0) {
+    return;
+  }
+  spill();
+  updateSpillStats();
+  pool()->getMemoryUsageTracker()->release();
+}
+
+void TopN::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+  auto tracker = pool()->getMemoryUsageTracker();
+  VELOX_CHECK_NOT_NULL(tracker);
+  // A full 'topRows_' reuses the memory of the rows it replaces, so at most
+  // the rows to fill it are new. TopN spills all its rows, so the targets
+  // are not used.
+  Spiller::ensureInputFits(
+      *data_,
+      *input,
+      spillConfig_.value(),
+      0 /*spillMemoryThreshold*/,
+      *tracker,
+      spillTestCounter_,
+      [&](int64_t /*targetRows*/, int64_t /*targetBytes*/) {
+        spill();
+        updateSpillStats();
+      },
+      std::min<int64_t>(
+          input->size(), count_ - static_cast<int64_t>(topRows_.size())));
+}
+
+void TopN::spill() {
+  if (topRows_.empty()) {
+    return;
+  }
+  VELOX_CHECK_EQ(topRows_.size(), data_->numRows());
+
+  // The top of 'topRows_' is the last row of the sorted run.
+  SpillRun run;
+  run.numRows = topRows_.size();
+  char* lastRow = topRows_.top();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    auto key = BaseVector::create(data_->keyTypes()[i], 1, pool());
+    data_->extractColumn(&lastRow, 1, i, key);
+    run.maxKeys.push_back(std::move(key));
+  }
+
+  if (spiller_ == nullptr) {
+    VELOX_DCHECK_NOT_NULL(pool()->getMemoryUsageTracker());
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        internalStoreType_,
+        keyChannels_.size(),
+        keyCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.compressionKind);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(0, 0);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  topRows_ = std::priority_queue<char*, std::vector<char*>, Comparator>(
+      comparator_);
+
+  numSpilledRows_ += run.numRows;
+  addSpillRun(std::move(run));
+}
+
+void TopN::addSpillRun(SpillRun run) {
+  auto it = std::upper_bound(
+      spillRuns_.begin(),
+      spillRuns_.end(),
+      run,
+      [&](const SpillRun& left, const SpillRun& right) {
+        return compareKeys(left.maxKeys, right.maxKeys) < 0;
+      });
+  spillRuns_.insert(it, std::move(run));
+
+  // The last row of the first runs that hold 'count_' rows has at least
+  // 'count_' rows at or before it.
+  int64_t numRows = 0;
+  for (auto i = 0; i < spillRuns_.size(); ++i) {
+    numRows += spillRuns_[i].numRows;
+    if (numRows >= count_) {
+      spillCutoff_ = spillRuns_[i].maxKeys;
+      spillRuns_.resize(i + 1);
+      return;
+    }
+  }
+}
+
+void TopN::updateSpillStats() {
+  if (spiller_ == nullptr) {
+    return;
+  }
+  const auto spillStats = spiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledUncompressedBytes = spillStats.spilledUncompressedBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+  VELOX_DCHECK_LE(lockedStats->spilledPartitions, 1);
+}
+
+std::optional<int64_t> TopN::integerKey(const BaseVector& key) const {
+  if (key.isNullAt(0)) {
+    return std::nullopt;
+  }
+  switch (key.typeKind()) {
+    case TypeKind::TINYINT:
+      return key.as<SimpleVector<int8_t>>()->valueAt(0);
+    case TypeKind::SMALLINT:
+      return key.as<SimpleVector<int16_t>>()->valueAt(0);
+    case TypeKind::INTEGER:
+      return key.as<SimpleVector<int32_t>>()->valueAt(0);
+    case TypeKind::BIGINT:
+      return key.as<SimpleVector<int64_t>>()->valueAt(0);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void TopN::pushdownCutoff() {
+  if (!canPushdownCutoff_.has_value()) {
+    const auto kind = outputType_->childAt(keyChannels_[0])->kind();
+    canPushdownCutoff_ =
+        (kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+         kind == TypeKind::INTEGER || kind == TypeKind::BIGINT) &&
+        operatorCtx_->driverCtx()
+                ->driver->canPushdownFilters(this, {keyChannels_[0]})
+                .count(keyChannels_[0]) != 0;
+  }
+  if (!canPushdownCutoff_.value()) {
+    return;
+  }
+
+  // Rows after the top of a full 'topRows_' or after 'spillCutoff_' are not
+  // in the result. The filter on the first key keeps the rows that tie with
+  // the cutoff on the first key. A null cutoff gives no bound.
+  const bool ascending = keyCompareFlags_[0].ascending;
+  const auto tighter = [&](std::optional<int64_t> left,
+                           std::optional<int64_t> right) {
+    if (!left.has_value() || !right.has_value()) {
+      return left.has_value() ? left : right;
+    }
+    return std::optional<int64_t>(
+        ascending ? std::min(left.value(), right.value())
+                  : std::max(left.value(), right.value()));
+  };
+  std::optional<int64_t> cutoff;
+  if (topRows_.size() == count_) {
+    char* topRow = topRows_.top();
+    if (topKey_ == nullptr) {
+      topKey_ = BaseVector::create(data_->keyTypes()[0], 1, pool());
+    }
+    data_->extractColumn(&topRow, 1, 0, topKey_);
+    cutoff = integerKey(*topKey_);
+  }
+  if (!spillCutoff_.empty()) {
+    cutoff = tighter(cutoff, integerKey(*spillCutoff_[0]));
+  }
+  if (!cutoff.has_value() || cutoff == pushedCutoff_ ||
+      tighter(cutoff, pushedCutoff_) != cutoff) {
+    return;
+  }
+  pushedCutoff_ = cutoff;
+  // Nulls first sort before any cutoff and nulls last after it.
+  const bool nullAllowed = keyCompareFlags_[0].nullsFirst;
+  dynamicFilters_[keyChannels_[0]] = ascending
+      ? std::make_shared<common::BigintRange>(
+            std::numeric_limits<int64_t>::min(), cutoff.value(), nullAllowed)
+      : std::make_shared<common::BigintRange>(
+            cutoff.value(), std::numeric_limits<int64_t>::max(), nullAllowed);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -91,6 +378,10 @@ RowVectorPtr TopN::getOutput() {
     return nullptr;
   }
 
+  if (spillMerge_ != nullptr) {
+    return getOutputWithSpill();
+  }
+
   uint32_t numRowsToReturn =
       std::min(kMaxNumRowsToReturn, rows_.size() - numRowsReturned_);
   VELOX_CHECK(numRowsToReturn > 0);
@@ -98,20 +389,87 @@ RowVectorPtr TopN::getOutput() {
   auto result = std::dynamic_pointer_cast<RowVector>(
       BaseVector::create(outputType_, numRowsToReturn, operatorCtx_->pool()));
 
-  for (int i = 0; i < outputType_->size(); ++i) {
+  for (const auto& projection : columnMap_) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
-        i,
-        result->childAt(i));
+        projection.inputChannel,
+        result->childAt(projection.outputChannel));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputWithSpill() {
+  const vector_size_t numRowsToReturn =
+      std::min<int64_t>(kMaxNumRowsToReturn, numRows_ - numRowsReturned_);
+  VELOX_CHECK_GT(numRowsToReturn, 0);
+
+  auto result = std::dynamic_pointer_cast<RowVector>(
+      BaseVector::create(outputType_, numRowsToReturn, operatorCtx_->pool()));
+
+  int32_t outputRow = 0;
+  int32_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < numRowsToReturn) {
+    SpillMergeStream* stream = spillMerge_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+
+    spillSources_[outputSize] = &stream->current();
+    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
+    ++outputSize;
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          result.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          columnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+
+    // Advance the stream.
+    stream->pop();
+  }
+
+  if (FOLLY_LIKELY(outputSize != 0)) {
+    gatherCopy(
+        result.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        columnMap_);
+  }
+
+  numRowsReturned_ += numRowsToReturn;
+  if (numRowsReturned_ == numRows_) {
+    finished_ = true;
+    // The rest of the sorted runs is not needed.
+    spillMerge_.reset();
+  }
+  return result;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+  if (spiller_ != nullptr) {
+    // There is only one partition, so all rows left in 'data_' are merged
+    // with the spilled runs.
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+    spillMerge_ = spiller_->startMerge(0);
+    numRows_ = std::min<int64_t>(count_, numSpilledRows_ + topRows_.size());
+    spillSources_.resize(kMaxNumRowsToReturn);
+    spillSourceRows_.resize(kMaxNumRowsToReturn);
+    updateSpillStats();
+    return;
+  }
   if (topRows_.empty()) {
     finished_ = true;
     return;
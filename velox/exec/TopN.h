@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -43,28 +44,32 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  bool canReclaim() const override {
+    return spillConfig_.has_value();
+  }
+
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   static constexpr size_t kMaxNumRowsToReturn = 1024;
   class Comparator {
    public:
     Comparator(
-        const RowTypePtr& outputType,
-        const std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>&
-            sortingKeys,
-        const std::vector<core::SortOrder>& sortingOrders,
-        RowContainer* rowContainer);
+        const std::vector<column_index_t>& keyChannels,
+        const std::vector<CompareFlags>& keyCompareFlags,
+        RowContainer* rowContainer)
+        : keyChannels_(keyChannels),
+          keyCompareFlags_(keyCompareFlags),
+          rowContainer_(rowContainer) {}
 
     // Returns true if lhs < rhs, false otherwise.
     bool operator()(const char* lhs, const char* rhs) {
       if (lhs == rhs) {
         return false;
       }
-      for (auto& key : keyInfo_) {
-        if (auto result = rowContainer_->compare(
-                lhs,
-                rhs,
-                key.first,
-                {key.second.isNullsFirst(), key.second.isAscending(), false})) {
+      for (auto i = 0; i < keyCompareFlags_.size(); ++i) {
+        if (auto result =
+                rowContainer_->compare(lhs, rhs, i, keyCompareFlags_[i])) {
           return result < 0;
         }
       }
@@ -76,13 +81,13 @@ class TopN : public Operator {
         const char* lhs,
         const std::vector<DecodedVector>& decodedVectors,
         vector_size_t index) {
-      for (auto& key : keyInfo_) {
+      for (auto i = 0; i < keyCompareFlags_.size(); ++i) {
         if (auto result = rowContainer_->compare(
                 lhs,
-                rowContainer_->columnAt(key.first),
-                decodedVectors[key.first],
+                rowContainer_->columnAt(i),
+                decodedVectors[keyChannels_[i]],
                 index,
-                {key.second.isNullsFirst(), key.second.isAscending(), false})) {
+                keyCompareFlags_[i])) {
           return result < 0;
         }
       }
@@ -90,12 +95,81 @@ class TopN : public Operator {
     }
 
    private:
-    std::vector<std::pair<column_index_t, core::SortOrder>> keyInfo_;
+    // The input channels of the sorting keys. The i-th sorting key is the
+    // i-th column of 'rowContainer_'.
+    std::vector<column_index_t> keyChannels_;
+    std::vector<CompareFlags> keyCompareFlags_;
     RowContainer* rowContainer_;
   };
 
+  // A sorted run written by 'spiller_'. 'maxKeys' are the sorting keys of
+  // the last row of the run as single row vectors.
+  struct SpillRun {
+    std::vector<VectorPtr> maxKeys;
+    int64_t numRows;
+  };
+
+  // Returns the result of comparing the keys of row 'index' of 'input' with
+  // 'keys'. 'keys' has one single row vector per sorting key.
+  int32_t compareKeys(
+      const std::vector<VectorPtr>& keys,
+      const RowVector& input,
+      vector_size_t index) const;
+
+  // Returns the result of comparing the single row sorting keys 'left' and
+  // 'right'.
+  int32_t compareKeys(
+      const std::vector<VectorPtr>& left,
+      const std::vector<VectorPtr>& right) const;
+
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills the rows
+  // in 'data_'.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the rows of 'topRows_' as a sorted run and lowers 'spillCutoff_'
+  // if the spilled runs hold more than 'count_' rows below the last row of
+  // the run. This is called by ensureInputFits or by external memory
+  // management. In the latter case, the Driver of this will be in a paused
+  // state and off thread.
+  void spill();
+
+  // Adds 'run' to 'spillRuns_' and recomputes 'spillCutoff_'.
+  void addSpillRun(SpillRun run);
+
+  // Copies the spill stats from 'spiller_' to the operator stats.
+  void updateSpillStats();
+
+  // Sets 'dynamicFilters_' to a range filter on the first sorting key if the
+  // cutoff of the input has moved since the last filter. Only integer keys
+  // that an upstream operator can filter on get a filter.
+  void pushdownCutoff();
+
+  // Returns the value of the first sorting key in the single row vector
+  // 'key' or std::nullopt if it is null.
+  std::optional<int64_t> integerKey(const BaseVector& key) const;
+
+  RowVectorPtr getOutputWithSpill();
+
   const int32_t count_;
 
+  // The disk spilling related configs if spilling is enabled, otherwise null.
+  const std::optional<Spiller::Config> spillConfig_;
+
+  // The input channels of the sorting keys.
+  const std::vector<column_index_t> keyChannels_;
+
+  const std::vector<CompareFlags> keyCompareFlags_;
+
+  // The map from column channel in the output to the corresponding one stored
+  // in 'data_'. The sorting keys are stored first in 'data_' as required by
+  // the sorted runs of 'spiller_'.
+  const std::vector<IdentityProjection> columnMap_;
+
+  // The row type used to store input data in row container and for spilling
+  // internally.
+  const RowTypePtr internalStoreType_;
+
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
@@ -114,5 +188,46 @@ class TopN : public Operator {
   std::vector<char*> rows_;
 
   std::vector<DecodedVector> decodedVectors_;
+
+  // Spiller for the rows of 'topRows_'. Each spill writes all of them as one
+  // sorted run and empties 'data_'.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // The spilled runs in order of their last row. Runs that sort after
+  // 'spillCutoff_' can not lower it any further and are not kept.
+  std::vector<SpillRun> spillRuns_;
+
+  // The last row of the first spilled runs that together have at least
+  // 'count_' rows. Input rows that sort after this are not in the result.
+  // Empty if there is no such row.
+  std::vector<VectorPtr> spillCutoff_;
+
+  // The number of rows in all spilled runs.
+  int64_t numSpilledRows_{0};
+
+  // The number of rows to return after all input is received.
+  int64_t numRows_{0};
+
+  // True if the first sorting key is an integer that an upstream operator
+  // can filter on. Set on first input.
+  std::optional<bool> canPushdownCutoff_;
+
+  // The bound of the last filter on the first sorting key.
+  std::optional<int64_t> pushedCutoff_;
+
+  // Reusable single row vector for the first sorting key of the top of
+  // 'topRows_'.
+  VectorPtr topKey_;
+
+  // Used to merge the sorted runs from 'spiller_'.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // The row sources and row indices of the output from 'spillMerge_'.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
 };
 } // namespace facebook::velox::exec
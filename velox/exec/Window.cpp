@@ -56,9 +56,13 @@ Window::Window(
       outputBatchSizeInBytes_(
           driverCtx->queryConfig().preferredOutputBatchSize()),
       numInputColumns_(windowNode->sources()[0]->outputType()->size()),
-      data_(std::make_unique<RowContainer>(
-          windowNode->sources()[0]->outputType()->children(),
-          pool())),
+      inputsSorted_(windowNode->inputsSorted()),
+      spillMemoryThreshold_(
+          driverCtx->queryConfig().windowSpillMemoryThreshold()),
+      spillConfig_(
+          windowNode->canSpill(driverCtx->queryConfig())
+              ? operatorCtx_->makeSpillConfig(Spiller::Type::kOrderBy)
+              : std::nullopt),
       decodedInputVectors_(numInputColumns_),
       stringAllocator_(pool()) {
   auto inputType = windowNode->sources()[0]->outputType();
@@ -68,15 +72,48 @@ Window::Window(
       windowNode->sortingKeys(),
       windowNode->sortingOrders(),
       sortKeyInfo_);
+
+  // Store the partition and sort keys first in 'data_', followed by the
+  // remaining input columns. The key infos are changed to refer to the
+  // columns in 'data_'.
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  std::vector<TypePtr> types;
+  std::vector<std::string> names;
+  inputChannelToColumn_.resize(numInputColumns_, kConstantChannel);
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
+  for (auto* keyInfo : {&partitionKeyInfo_, &sortKeyInfo_}) {
+    for (auto& key : *keyInfo) {
+      const column_index_t column = keyTypes.size();
+      if (inputChannelToColumn_[key.first] == kConstantChannel) {
+        inputChannelToColumn_[key.first] = column;
+      }
+      columnInputChannels_.push_back(key.first);
+      keyTypes.push_back(inputType->childAt(key.first));
+      types.push_back(keyTypes.back());
+      names.push_back(inputType->nameOf(key.first));
+      keyCompareFlags_.push_back(
+          {key.second.isNullsFirst(), key.second.isAscending(), false, false});
+      key.first = column;
+      allKeyInfo_.push_back(key);
+    }
+  }
+  for (auto i = 0; i < numInputColumns_; ++i) {
+    if (inputChannelToColumn_[i] != kConstantChannel) {
+      continue;
+    }
+    inputChannelToColumn_[i] = keyTypes.size() + dependentTypes.size();
+    columnInputChannels_.push_back(i);
+    dependentTypes.push_back(inputType->childAt(i));
+    types.push_back(dependentTypes.back());
+    names.push_back(inputType->nameOf(i));
+  }
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool());
+  spillType_ = ROW(std::move(names), std::move(types));
 
   std::vector<exec::RowColumn> inputColumns;
   for (int i = 0; i < inputType->children().size(); i++) {
-    inputColumns.push_back(data_->columnAt(i));
+    inputColumns.push_back(data_->columnAt(inputChannelToColumn_[i]));
   }
   // The WindowPartition is structured over all the input columns data.
   // Individual functions access its input argument column values from it.
@@ -86,6 +123,10 @@ Window::Window(
       std::make_unique<WindowPartition>(inputColumns, inputType->children());
 
   createWindowFunctions(windowNode, inputType);
+
+  if (inputsSorted_) {
+    partitionStartRows_.push_back(0);
+  }
 }
 
 void Window::createWindowFunctions(
@@ -147,6 +188,8 @@ void Window::createWindowFunctions(
 }
 
 void Window::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
   inputRows_.resize(input->size());
 
   for (auto col = 0; col < input->childrenSize(); ++col) {
@@ -157,11 +200,103 @@ void Window::addInput(RowVectorPtr input) {
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
 
-    for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
+    for (auto column = 0; column < columnInputChannels_.size(); ++column) {
+      data_->store(
+          decodedInputVectors_[columnInputChannels_[column]],
+          row,
+          newRow,
+          column);
+    }
+    if (inputsSorted_) {
+      if (!sortedRows_.empty() && isNewPartition(sortedRows_.back(), newRow)) {
+        partitionStartRows_.push_back(sortedRows_.size());
+      }
+      sortedRows_.push_back(newRow);
     }
   }
   numRows_ += inputRows_.size();
+
+  if (inputsSorted_ && peerStartBuffer_ == nullptr) {
+    createPeerAndFrameBuffers();
+  }
+
+  if (spiller_ != nullptr) {
+    const auto spillStats = spiller_->stats();
+    auto lockedStats = stats_.wlock();
+    lockedStats->spilledBytes = spillStats.spilledBytes;
+    lockedStats->spilledUncompressedBytes = spillStats.spilledUncompressedBytes;
+    lockedStats->spilledRows = spillStats.spilledRows;
+    lockedStats->spilledPartitions = spillStats.spilledPartitions;
+    lockedStats->spilledFiles = spillStats.spilledFiles;
+  }
+}
+
+void Window::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+  auto tracker = pool()->getMemoryUsageTracker();
+  VELOX_CHECK_NOT_NULL(tracker);
+  Spiller::ensureInputFits(
+      *data_,
+      *input,
+      spillConfig_.value(),
+      spillMemoryThreshold_,
+      *tracker,
+      spillTestCounter_,
+      [&](int64_t targetRows, int64_t targetBytes) {
+        spill(targetRows, targetBytes);
+      });
+}
+
+void Window::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillType_,
+        data_->keyTypes().size(),
+        keyCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.compressionKind);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+}
+
+bool Window::isNewPartition(const char* lhs, const char* rhs) {
+  for (auto& key : partitionKeyInfo_) {
+    if (data_->compare(
+            lhs,
+            rhs,
+            key.first,
+            {key.second.isNullsFirst(), key.second.isAscending(), false})) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Window::eraseProcessedPartitions() {
+  VELOX_CHECK_EQ(numProcessedRows_, partitionStartRows_.back());
+  data_->eraseRows(folly::Range<char**>(sortedRows_.data(), numProcessedRows_));
+  sortedRows_.erase(
+      sortedRows_.begin(), sortedRows_.begin() + numProcessedRows_);
+  partitionStartRows_ = {0};
+  currentPartition_ = 0;
+  numProcessedRows_ = 0;
+  peerStartRow_ = 0;
+  peerEndRow_ = 0;
 }
 
 inline bool Window::compareRowsWithKeys(
@@ -262,13 +397,126 @@ void Window::noMoreInput() {
     return;
   }
 
+  if (inputsSorted_) {
+    // The last partition is complete.
+    partitionStartRows_.push_back(sortedRows_.size());
+    return;
+  }
+
   // At this point we have seen all the input rows. We can start
   // outputting rows now.
   // However, some preparation is needed. The rows should be
   // separated into partitions and sort by ORDER BY keys within
   // the partition. This will order the rows for getOutput().
-  sortPartitions();
+  if (spiller_ == nullptr) {
+    sortPartitions();
+  } else {
+    // All rows are spilled as there is only one spill partition. The spilled
+    // partitions are read back one at a time in getOutput().
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+    VELOX_CHECK_NULL(spillMerge_);
+    spillMerge_ = spiller_->startMerge(0);
+  }
   createPeerAndFrameBuffers();
+  if (spillMerge_ != nullptr) {
+    spillSources_.resize(numRowsPerOutput_);
+    spillSourceRows_.resize(numRowsPerOutput_);
+    decodedSpillBatch_.resize(spillType_->size());
+    // 'data_' is reused to hold one spilled partition at a time.
+    data_->clear();
+  }
+}
+
+void Window::loadNextSpilledPartition() {
+  data_->clear();
+  sortedRows_.clear();
+  partitionKeyRow_ = nullptr;
+
+  vector_size_t numSourceRows = 0;
+  bool isEndOfBatch = false;
+  for (;;) {
+    SpillMergeStream* stream = spillMerge_->next();
+    if (stream == nullptr) {
+      break;
+    }
+    const auto& current = stream->current();
+    const auto index = stream->currentIndex(&isEndOfBatch);
+    if (!isSameSpilledPartition(current, index)) {
+      // The row is left in the stream for the next partition.
+      break;
+    }
+    spillSources_[numSourceRows] = &current;
+    spillSourceRows_[numSourceRows] = index;
+    ++numSourceRows;
+    // The rows must be copied out before the stream fetches its next batch
+    // in 'pop'.
+    if (isEndOfBatch || numSourceRows == spillSources_.size()) {
+      addSpilledRows(numSourceRows);
+      numSourceRows = 0;
+    }
+    stream->pop();
+  }
+  addSpilledRows(numSourceRows);
+
+  const auto numRows = data_->numRows();
+  sortedRows_.resize(numRows);
+  if (numRows > 0) {
+    // The rows are listed in insertion order, which is the merged order.
+    RowContainerIterator iter;
+    data_->listRows(&iter, numRows, sortedRows_.data());
+  }
+  partitionStartRows_ = {0, static_cast<vector_size_t>(numRows)};
+  currentPartition_ = 0;
+  numProcessedRows_ = 0;
+}
+
+bool Window::isSameSpilledPartition(
+    const RowVector& input,
+    vector_size_t index) {
+  if (partitionKeyRow_ == nullptr) {
+    partitionKeyRow_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(spillType_, 1, pool()));
+    partitionKeyRow_->copy(&input, 0, index, 1);
+    return true;
+  }
+  // The partition keys are the first columns of the spilled rows.
+  for (auto i = 0; i < partitionKeyInfo_.size(); ++i) {
+    if (!input.childAt(i)->equalValueAt(
+            partitionKeyRow_->childAt(i).get(), index, 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Window::addSpilledRows(vector_size_t numRows) {
+  if (numRows == 0) {
+    return;
+  }
+  if (spillBatch_ == nullptr) {
+    spillBatch_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(spillType_, numRows, pool()));
+  } else {
+    VectorPtr batch = std::move(spillBatch_);
+    BaseVector::prepareForReuse(batch, numRows);
+    spillBatch_ = std::static_pointer_cast<RowVector>(batch);
+  }
+  for (auto& child : spillBatch_->children()) {
+    child->resize(numRows);
+  }
+  gatherCopy(spillBatch_.get(), 0, numRows, spillSources_, spillSourceRows_);
+
+  SelectivityVector rows(numRows);
+  for (auto column = 0; column < spillBatch_->childrenSize(); ++column) {
+    decodedSpillBatch_[column].decode(*spillBatch_->childAt(column), rows);
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    char* newRow = data_->newRow();
+    for (auto column = 0; column < spillBatch_->childrenSize(); ++column) {
+      data_->store(decodedSpillBatch_[column], row, newRow, column);
+    }
+  }
 }
 
 void Window::callResetPartition(vector_size_t partitionNumber) {
@@ -454,11 +702,24 @@ void Window::callApplyLoop(
 }
 
 RowVectorPtr Window::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || (!noMoreInput_ && !inputsSorted_)) {
     return nullptr;
   }
 
-  auto numRowsLeft = numRows_ - numProcessedRows_;
+  if (inputsSorted_ && numProcessedRows_ == partitionStartRows_.back()) {
+    // No completed partition to output.
+    return nullptr;
+  }
+
+  if (spillMerge_ != nullptr && numProcessedRows_ == sortedRows_.size()) {
+    loadNextSpilledPartition();
+    if (sortedRows_.empty()) {
+      finished_ = true;
+      return nullptr;
+    }
+  }
+
+  vector_size_t numRowsLeft = partitionStartRows_.back() - numProcessedRows_;
   auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = std::dynamic_pointer_cast<RowVector>(
       BaseVector::create(outputType_, numOutputRows, operatorCtx_->pool()));
@@ -468,7 +729,7 @@ RowVectorPtr Window::getOutput() {
     data_->extractColumn(
         sortedRows_.data() + numProcessedRows_,
         numOutputRows,
-        i,
+        inputChannelToColumn_[i],
         result->childAt(i));
   }
 
@@ -488,7 +749,20 @@ RowVectorPtr Window::getOutput() {
     result->childAt(j) = windowOutputs[j - numInputColumns_];
   }
 
-  finished_ = (numProcessedRows_ == sortedRows_.size());
+  if (inputsSorted_) {
+    if (numProcessedRows_ == partitionStartRows_.back()) {
+      if (noMoreInput_) {
+        finished_ = true;
+      } else {
+        eraseProcessedPartitions();
+      }
+    }
+    return result;
+  }
+
+  // With spilling, the operator finishes once no spilled partition is left.
+  finished_ =
+      spillMerge_ == nullptr && numProcessedRows_ == sortedRows_.size();
   return result;
 }
 
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/WindowPartition.h"
 
@@ -34,6 +35,17 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// If spilling is enabled and the input does not fit in memory, the input
+/// rows are spilled as sorted runs by (partition keys + order by keys). After
+/// all input is received, the runs are merged and read back one partition at
+/// a time into the RowContainer.
+///
+/// If the input is already ordered by (partition_by keys + order_by keys),
+/// see core::WindowNode::inputsSorted(), the sort is skipped. The partition
+/// boundaries are found as the input arrives and each partition is output
+/// as soon as its last row has been received. Only the rows of the partitions
+/// being processed are kept in memory.
 class Window : public Operator {
  public:
   Window(
@@ -46,7 +58,10 @@ class Window : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_;
+    // With sorted input, the completed partitions are output before more
+    // input is accepted.
+    return !noMoreInput_ &&
+        (!inputsSorted_ || numProcessedRows_ == partitionStartRows_.back());
   }
 
   void noMoreInput() override;
@@ -75,6 +90,37 @@ class Window : public Operator {
       const std::shared_ptr<const core::WindowNode>& windowNode,
       const RowTypePtr& inputType);
 
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills enough to
+  // make 'input' fit.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills content until under 'targetRows' and under 'targetBytes' of out of
+  // line data are left.
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  // Reads the next partition from 'spillMerge_' into 'data_' and sets up
+  // 'sortedRows_' and 'partitionStartRows_' for it. Leaves 'sortedRows_'
+  // empty if all spilled rows have been read.
+  void loadNextSpilledPartition();
+
+  // Returns true if row 'index' of 'input' has the same partition keys as
+  // 'partitionKeyRow_'. Sets 'partitionKeyRow_' to the row if it is not set.
+  bool isSameSpilledPartition(const RowVector& input, vector_size_t index);
+
+  // Stores the first 'numRows' rows collected in 'spillSources_' and
+  // 'spillSourceRows_' into 'data_'.
+  void addSpilledRows(vector_size_t numRows);
+
+  // Returns true if the rows at lhs and rhs have different partition keys.
+  bool isNewPartition(const char* lhs, const char* rhs);
+
+  // Used with sorted input. Erases the rows of the partitions that have been
+  // output from 'data_' and 'sortedRows_' after all the completed partitions
+  // have been output. The partition that is still receiving input becomes the
+  // first partition.
+  void eraseProcessedPartitions();
+
   // Helper function to create the buffers for peer and frame
   // row indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
@@ -128,11 +174,36 @@ class Window : public Operator {
   const vector_size_t outputBatchSizeInBytes_;
   const vector_size_t numInputColumns_;
 
+  // True if the input is ordered by (partition keys + order by keys).
+  const bool inputsSorted_;
+
+  // The maximum memory usage that a window operator can hold before
+  // spilling. If it is zero, then there is no such limit.
+  const uint64_t spillMemoryThreshold_;
+
+  // The disk spilling related configs if spilling is enabled, otherwise null.
+  const std::optional<Spiller::Config> spillConfig_;
+
   // The Window operator needs to see all the input rows before starting
   // any function computation. As the Window operators gets input rows
-  // we store the rows in the RowContainer (data_).
+  // we store the rows in the RowContainer (data_). The partition and sort
+  // keys are stored first as keys of the RowContainer, followed by the other
+  // input columns. This lets the Spiller sort and merge the rows by the keys.
   std::unique_ptr<RowContainer> data_;
 
+  // The column in 'data_' of each input column. A key column that is both a
+  // partition and a sort key is stored twice, and this refers to the first.
+  std::vector<column_index_t> inputChannelToColumn_;
+
+  // The input column stored in each column of 'data_'.
+  std::vector<column_index_t> columnInputChannels_;
+
+  // The type of the rows stored in 'data_'. Used for spilling.
+  RowTypePtr spillType_;
+
+  // Compare flags of the keys in 'data_' for spilling.
+  std::vector<CompareFlags> keyCompareFlags_;
+
   // The decodedInputVectors_ are reused across addInput() calls to decode
   // the partition and sort keys for the above RowContainer.
   std::vector<DecodedVector> decodedInputVectors_;
@@ -141,8 +212,8 @@ class Window : public Operator {
   // buffers.
   HashStringAllocator stringAllocator_;
 
-  // The below 3 vectors represent the ChannelIndex of the partition keys,
-  // the order by keys and the concatenation of the 2. These keyInfo are
+  // The below 3 vectors represent the columns in 'data_' of the partition
+  // keys, the order by keys and the concatenation of the 2. These keyInfo are
   // used for sorting by those key combinations during the processing.
   // partitionKeyInfo_ is used to separate partitions in the rows.
   // sortKeyInfo_ is used to identify peer rows in a partition.
@@ -170,7 +241,8 @@ class Window : public Operator {
   // Vector of pointers to each input row in the data_ RowContainer.
   // The rows are sorted by partitionKeys + sortKeys. This total
   // ordering can be used to split partitions (with the correct
-  // order by) for the processing.
+  // order by) for the processing. With sorted input, the rows are added in
+  // the order they arrive.
   std::vector<char*> sortedRows_;
 
   // Window partition object used to provide per-partition
@@ -183,7 +255,9 @@ class Window : public Operator {
   // This is a vector that gives the index of the start row
   // (in sortedRows_) of each partition in the RowContainer data_.
   // This auxiliary structure helps demarcate partitions in
-  // getOutput calls.
+  // getOutput calls. The last entry is the number of rows that can be
+  // output. With sorted input, this is the start of the last partition, which
+  // may receive more rows, until noMoreInput() is called.
   std::vector<vector_size_t> partitionStartRows_;
 
   // The following 4 Buffers are used to pass peer and frame start and
@@ -208,7 +282,7 @@ class Window : public Operator {
   // Current partition being output. The partition might be
   // output across multiple getOutput() calls so this needs to
   // be tracked in the operator.
-  vector_size_t currentPartition_;
+  vector_size_t currentPartition_ = 0;
 
   // When traversing input partition rows, the peers are the rows
   // with the same values for the ORDER BY clause. These rows
@@ -219,6 +293,28 @@ class Window : public Operator {
   // cross getOutput boundaries they are saved in the operator.
   vector_size_t peerStartRow_ = 0;
   vector_size_t peerEndRow_ = 0;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // Set to read back spilled data if disk spilling has been triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // The source rows of the next batch of spilled rows to store in 'data_'.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
+
+  // Batch of spilled rows gathered from 'spillSources_' before they are
+  // stored in 'data_', and the decoded vectors of its columns.
+  RowVectorPtr spillBatch_;
+  std::vector<DecodedVector> decodedSpillBatch_;
+
+  // A copy of the first row of the spilled partition being read. Null before
+  // the first row of a partition is read.
+  RowVectorPtr partitionKeyRow_;
 };
 
 } // namespace facebook::velox::exec
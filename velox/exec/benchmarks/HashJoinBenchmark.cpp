@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include "velox/exec/HashTable.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+// Probes a kHash mode join table with batches of random keys. Measures
+// HashTable::joinProbe with and without partitioning the probe rows by table
+// region and prefetching.
+class JoinTableProbe {
+ public:
+  // Makes a table of 'numBuildRows' keys. 'hitPct' percent of the probe keys
+  // have a match.
+  JoinTableProbe(int32_t numBuildRows, int32_t hitPct) {
+    // A struct key keeps the table in kHash mode.
+    auto keyType = ROW({"k"}, {BIGINT()});
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(std::make_unique<VectorHasher>(keyType, 0));
+    table_ = HashTable<true>::createForJoin(
+        std::move(hashers), {}, true, false, pool_.get());
+
+    auto buildKeys = makeKeys(numBuildRows, [](auto row) { return row * 2; });
+    SelectivityVector allRows(numBuildRows);
+    DecodedVector decoded(*buildKeys, allRows);
+    auto* rows = table_->rows();
+    const auto nextOffset = rows->nextOffset();
+    for (auto i = 0; i < numBuildRows; ++i) {
+      auto* newRow = rows->newRow();
+      if (nextOffset) {
+        *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+      }
+      rows->store(decoded, i, newRow, 0);
+    }
+    table_->prepareJoinTable({});
+    VELOX_CHECK(table_->hashMode() == BaseHashTable::HashMode::kHash);
+
+    // Even keys hit and odd keys miss.
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    for (auto i = 0; i < kNumBatches; ++i) {
+      auto probeKeys = makeKeys(kBatchSize, [&](auto /*row*/) {
+        const int64_t key = folly::Random::rand32(numBuildRows, rng);
+        return folly::Random::rand32(100, rng) < hitPct ? key * 2 : key * 2 + 1;
+      });
+      auto lookup = std::make_unique<HashLookup>(table_->hashers());
+      lookup->reset(kBatchSize);
+      SelectivityVector probeRows(kBatchSize);
+      auto& hasher = table_->hashers()[0];
+      hasher->decode(*probeKeys, probeRows);
+      hasher->hash(probeRows, false, lookup->hashes);
+      std::iota(lookup->rows.begin(), lookup->rows.end(), 0);
+      probeKeys_.push_back(std::move(probeKeys));
+      lookups_.push_back(std::move(lookup));
+    }
+  }
+
+  // Probes all batches and returns the number of hits.
+  int64_t run(bool partitioned) {
+    table_->setPartitionedProbe(partitioned);
+    int64_t numHits = 0;
+    for (auto i = 0; i < lookups_.size(); ++i) {
+      // The hashers compare the keys of the batch being probed.
+      table_->hashers()[0]->decode(
+          *probeKeys_[i], SelectivityVector(kBatchSize));
+      table_->joinProbe(*lookups_[i]);
+      for (auto* hit : lookups_[i]->hits) {
+        numHits += hit != nullptr;
+      }
+    }
+    return numHits;
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 1'024;
+  static constexpr int32_t kNumBatches = 100;
+
+  VectorPtr makeKeys(
+      vector_size_t size,
+      std::function<int64_t(vector_size_t)> valueAt) {
+    return vectorMaker_.rowVector({vectorMaker_.flatVector<int64_t>(
+        size, [&](auto row) { return valueAt(row); })});
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{memory::getDefaultMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  std::unique_ptr<HashTable<true>> table_;
+  std::vector<VectorPtr> probeKeys_;
+  std::vector<std::unique_ptr<HashLookup>> lookups_;
+};
+
+std::unique_ptr<JoinTableProbe> smallTable;
+std::unique_ptr<JoinTableProbe> largeTable;
+std::unique_ptr<JoinTableProbe> largeTableFewHits;
+} // namespace
+
+// 64K rows. The table stays in cache.
+BENCHMARK(smallTable) {
+  folly::doNotOptimizeAway(smallTable->run(false));
+}
+
+BENCHMARK_RELATIVE(smallTablePartitioned) {
+  folly::doNotOptimizeAway(smallTable->run(true));
+}
+
+// 16M rows. The table takes about 300MB.
+BENCHMARK(largeTable) {
+  folly::doNotOptimizeAway(largeTable->run(false));
+}
+
+BENCHMARK_RELATIVE(largeTablePartitioned) {
+  folly::doNotOptimizeAway(largeTable->run(true));
+}
+
+BENCHMARK(largeTableFewHits) {
+  folly::doNotOptimizeAway(largeTableFewHits->run(false));
+}
+
+BENCHMARK_RELATIVE(largeTableFewHitsPartitioned) {
+  folly::doNotOptimizeAway(largeTableFewHits->run(true));
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  smallTable = std::make_unique<JoinTableProbe>(64 << 10, 100);
+  largeTable = std::make_unique<JoinTableProbe>(16 << 20, 100);
+  largeTableFewHits = std::make_unique<JoinTableProbe>(16 << 20, 10);
+  folly::runBenchmarks();
+  smallTable.reset();
+  largeTable.reset();
+  largeTableFewHits.reset();
+  return 0;
+}
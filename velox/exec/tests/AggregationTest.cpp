@@ -773,6 +773,62 @@ TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   }
 }
 
+TEST_F(AggregationTest, abandonPartialAggregation) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    // Few duplicate keys in c0 and many in c2.
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [&](auto row) { return i * 1'000 + row / 2; },
+            nullEvery(7)),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row; }, nullEvery(11)),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 10; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto test = [&](const std::vector<std::string>& keys,
+                        const std::vector<std::string>& aggregates,
+                        const std::string& duckDbSql,
+                        bool expectAbandon) {
+    SCOPED_TRACE(duckDbSql);
+    core::PlanNodeId aggNodeId;
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .config(
+                        QueryConfig::kAbandonPartialAggregationMinRows, "100")
+                    .config(
+                        QueryConfig::kAbandonPartialAggregationMinPct, "40")
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .partialAggregation(keys, aggregates)
+                              .capturePlanNodeId(aggNodeId)
+                              .finalAggregation()
+                              .planNode())
+                    .assertResults(duckDbSql);
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    EXPECT_EQ(
+        expectAbandon, runtimeStats.count("abandonedPartialAggregation") > 0);
+    if (expectAbandon) {
+      EXPECT_GT(runtimeStats.at("abandonedPartialAggregationRows").sum, 0);
+    }
+  };
+
+  test(
+      {"c0"},
+      {"sum(c1)", "count(1)", "avg(c1)", "max(c1)"},
+      "SELECT c0, sum(c1), count(1), avg(c1), max(c1) FROM tmp GROUP BY 1",
+      true);
+  test({"c0"}, {}, "SELECT distinct c0 FROM tmp", true);
+  test(
+      {"c2"},
+      {"sum(c1)", "count(1)"},
+      "SELECT c2, sum(c1), count(1) FROM tmp GROUP BY 1",
+      false);
+}
+
 TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -1360,8 +1416,22 @@ TEST_F(AggregationTest, distinctWithSpilling) {
                             .capturePlanNodeId(aggrNodeId)
                             .planNode())
                   .assertResults("SELECT distinct c0 FROM tmp");
-  // Verify that spilling is not triggered.
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+
+  // Multiple keys and a final aggregation over partial distinct results.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .spillDirectory(spillDirectory->path)
+             .config(QueryConfig::kSpillEnabled, "true")
+             .config(QueryConfig::kAggregationSpillEnabled, "true")
+             .config(QueryConfig::kTestingSpillPct, "100")
+             .plan(PlanBuilder()
+                       .values(vectors)
+                       .partialAggregation({"c0", "c1"}, {})
+                       .finalAggregation()
+                       .capturePlanNodeId(aggrNodeId)
+                       .planNode())
+             .assertResults("SELECT distinct c0, c1 FROM tmp");
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
 }
 
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
@@ -1370,7 +1440,7 @@ TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   for (int32_t i = 0; i < 4; ++i) {
     vectors.push_back(makeRowVector(
         {// Pre-grouped key.
-         makeFlatVector<int64_t>(10, [&](auto /*row*/) { return val++ / 5; }),
+         makeFlatVector<int64_t>(10, [&](auto /*row*/) { return val++ / 7; }),
          // Payload.
          makeFlatVector<int64_t>(10, [](auto row) { return row; }),
          makeFlatVector<int64_t>(10, [](auto row) { return row; })}));
@@ -1396,9 +1466,9 @@ TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
                     .capturePlanNodeId(aggrNodeId)
                     .planNode())
           .assertResults("SELECT c0, c1, sum(c2) FROM tmp GROUP BY c0, c1");
-  auto stats = task->taskStats().pipelineStats;
-  // Verify that spilling is not triggered.
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  // The groups of the pre-grouped key span input batches and are spilled
+  // before their output.
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
 }
 
 } // namespace
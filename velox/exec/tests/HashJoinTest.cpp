@@ -4054,6 +4054,167 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  // The build side has more distinct string keys than a value set can hold,
+  // so the hash table is in kHash mode and the dynamic filter is a Bloom
+  // filter.
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 3'000;
+  const int32_t numRowsBuild = 120'000;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  std::vector<exec::Split> probeSplits;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<std::string>(
+            numRowsProbe,
+            [&](auto row) {
+              return fmt::format("k{}", i * numRowsProbe + row);
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+    probeSplits.push_back(
+        exec::Split(makeHiveConnectorSplit(tempFiles.back()->path)));
+  }
+
+  // One in three probe keys has a match.
+  std::vector<RowVectorPtr> buildVectors;
+  for (int i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector({makeFlatVector<std::string>(
+        numRowsBuild / 4, [i](auto row) {
+          return fmt::format("k{}", 3 * (row + i * numRowsBuild / 4));
+        })}));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator)
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0"})
+                       .planNode();
+
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator)
+                .tableScan(probeType)
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  SplitInput splits;
+  splits.emplace(probeScanId, probeSplits);
+  for (bool bloomFilterEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("bloomFilterEnabled:{}", bloomFilterEnabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .inputSplits(splits)
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterEnabled,
+            bloomFilterEnabled ? "true" : "false")
+        .referenceQuery("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill || !bloomFilterEnabled) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // The Bloom filter has false positives, so the join is not
+            // replaced with the filter.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(
+                getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+          }
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, bloomFilterProbe) {
+  // The build side has enough distinct string keys for a kHash mode table with
+  // a Bloom filter. One in ten probe keys has a match.
+  const int32_t numRowsProbe = 10'000;
+  const int32_t numRowsBuild = 200'000;
+
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            numRowsProbe,
+            [&](auto row) {
+              const auto key = i * numRowsProbe + row;
+              return fmt::format("{}{}", key % 10 == 0 ? "k" : "p", key);
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    }));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector({makeFlatVector<std::string>(
+        numRowsBuild / 4, [i](auto row) {
+          return fmt::format("k{}", row + i * numRowsBuild / 4);
+        })}));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator)
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0"})
+                       .planNode();
+  auto op = PlanBuilder(planNodeIdGenerator)
+                .values(probeVectors)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  for (bool bloomFilterEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("bloomFilterEnabled:{}", bloomFilterEnabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .injectSpill(false)
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterEnabled,
+            bloomFilterEnabled ? "true" : "false")
+        .referenceQuery("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          auto inputRows =
+              getOperatorRuntimeStats(task, 1, "bloomFilterProbeInputRows");
+          auto passedRows =
+              getOperatorRuntimeStats(task, 1, "bloomFilterProbePassedRows");
+          if (!bloomFilterEnabled) {
+            ASSERT_EQ(0, inputRows.count);
+            return;
+          }
+          const int64_t numProbeInput = numRowsProbe * probeVectors.size();
+          ASSERT_EQ(numProbeInput, inputRows.sum);
+          ASSERT_GE(passedRows.sum, numProbeInput / 10);
+          ASSERT_LT(passedRows.sum, numProbeInput / 5);
+        })
+        .run();
+  }
+}
+
 // Verify the size of the join output vectors when projecting build-side
 // variable-width column.
 TEST_F(HashJoinTest, memoryUsage) {
@@ -682,6 +682,134 @@ TEST_P(HashTableTest, regularHashingTableSize) {
   }
 }
 
+TEST_P(HashTableTest, joinBloomFilter) {
+  constexpr int32_t kNumWays = 4;
+  constexpr int32_t kSize = 64 << 10;
+  // A struct key makes a kHash table.
+  auto type = ROW({"key"}, {ROW({"k1"}, {BIGINT()})});
+  std::vector<std::vector<RowVectorPtr>> batches(kNumWays);
+  for (auto way = 0; way < kNumWays; ++way) {
+    makeRows(kSize, 1, way * kSize, type, batches[way]);
+  }
+  auto makeTable = [&](bool buildBloomFilter) {
+    std::unique_ptr<HashTable<true>> topTable;
+    std::vector<std::unique_ptr<BaseHashTable>> otherTables;
+    for (auto way = 0; way < kNumWays; ++way) {
+      std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+      keyHashers.emplace_back(
+          std::make_unique<VectorHasher>(type->childAt(0), 0));
+      auto table = HashTable<true>::createForJoin(
+          std::move(keyHashers), {}, true, false, pool_.get());
+      copyVectorsToTable(batches[way], way * kSize, table.get());
+      if (topTable == nullptr) {
+        topTable = std::move(table);
+      } else {
+        otherTables.push_back(std::move(table));
+      }
+    }
+    topTable->prepareJoinTable(
+        std::move(otherTables), executor_.get(), buildBloomFilter);
+    EXPECT_EQ(topTable->hashMode(), BaseHashTable::HashMode::kHash);
+    return topTable;
+  };
+  auto table = makeTable(true);
+  auto tableWithoutFilter = makeTable(false);
+  ASSERT_TRUE(table->hasJoinBloomFilter());
+  ASSERT_FALSE(tableWithoutFilter->hasJoinBloomFilter());
+  // 2 bytes per row for 256K rows.
+  ASSERT_EQ(
+      table->allocatedBytes() - tableWithoutFilter->allocatedBytes(),
+      512 << 10);
+
+  // All keys of the table pass the filter.
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  auto& hasher = table->hashers()[0];
+  for (const auto& wayBatches : batches) {
+    for (const auto& batch : wayBatches) {
+      SelectivityVector rows(batch->size());
+      lookup->reset(batch->size());
+      hasher->decode(*batch->childAt(0), rows);
+      hasher->hash(rows, false, lookup->hashes);
+      lookup->rows.resize(batch->size());
+      std::iota(lookup->rows.begin(), lookup->rows.end(), 0);
+      table->joinBloomFilterProbe(*lookup);
+      ASSERT_EQ(lookup->rows.size(), batch->size());
+    }
+  }
+}
+
+TEST_P(HashTableTest, partitionedProbe) {
+  // 1M keys make a table of 2M slots. This is large enough for partitioning
+  // the probe rows by region and for prefetching the table entries.
+  constexpr int32_t kSize = 1 << 20;
+  constexpr int32_t kProbeBatchSize = 10'000;
+  keySpacing_ = 1000;
+  auto checkHits = [&](BaseHashTable::HashMode mode, const RowTypePtr& type) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    for (auto channel = 0; channel < type->size(); ++channel) {
+      keyHashers.emplace_back(
+          std::make_unique<VectorHasher>(type->childAt(channel), channel));
+    }
+    auto table = HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, pool_.get());
+    std::vector<RowVectorPtr> batches;
+    makeRows(kSize, 1, 0, type, batches);
+    copyVectorsToTable(batches, 0, table.get());
+    table->prepareJoinTable({}, executor_.get());
+    ASSERT_EQ(table->hashMode(), mode);
+
+    // Half of the probe keys are in the table.
+    const int32_t firstProbeKey = kSize - 5 * kProbeBatchSize;
+    std::vector<RowVectorPtr> probeBatches;
+    makeRows(kProbeBatchSize, 10, firstProbeKey, type, probeBatches);
+    auto lookup = std::make_unique<HashLookup>(table->hashers());
+    auto& hashers = table->hashers();
+    VectorHasher::ScratchMemory scratchMemory;
+    std::vector<char*> unpartitionedHits;
+    for (auto batchIndex = 0; batchIndex < probeBatches.size(); ++batchIndex) {
+      const auto& batch = probeBatches[batchIndex];
+      SelectivityVector rows(batch->size());
+      lookup->reset(batch->size());
+      for (auto i = 0; i < hashers.size(); ++i) {
+        if (mode != BaseHashTable::HashMode::kHash) {
+          hashers[i]->lookupValueIds(
+              *batch->childAt(i), rows, scratchMemory, lookup->hashes);
+        } else {
+          hashers[i]->decode(*batch->childAt(i), rows);
+          hashers[i]->hash(rows, i > 0, lookup->hashes);
+        }
+      }
+      constexpr int32_t kPadding = simd::kPadding / sizeof(int32_t);
+      lookup->rows.resize(bits::roundUp(rows.size() + kPadding, kPadding));
+      auto numRows = simd::indicesOfSetBits(
+          rows.asRange().bits(), 0, batch->size(), lookup->rows.data());
+      lookup->rows.resize(numRows);
+      if (lookup->rows.empty()) {
+        continue;
+      }
+
+      table->setPartitionedProbe(false);
+      table->joinProbe(*lookup);
+      unpartitionedHits.assign(lookup->hits.begin(), lookup->hits.end());
+      std::fill(lookup->hits.begin(), lookup->hits.end(), nullptr);
+
+      table->setPartitionedProbe(true);
+      table->joinProbe(*lookup);
+      const auto startKey = firstProbeKey + batchIndex * kProbeBatchSize;
+      for (auto row : lookup->rows) {
+        const auto key = startKey + row;
+        ASSERT_EQ(lookup->hits[row], unpartitionedHits[row]) << key;
+        ASSERT_EQ(lookup->hits[row], key < kSize ? rowOfKey_[key] : nullptr)
+            << key;
+      }
+    }
+  };
+  // A struct key makes a kHash table.
+  checkHits(
+      BaseHashTable::HashMode::kHash, ROW({"key"}, {ROW({"k1"}, {BIGINT()})}));
+  checkHits(BaseHashTable::HashMode::kNormalizedKey, ROW({"k1"}, {BIGINT()}));
+}
+
 TEST_P(HashTableTest, groupBySpill) {
   auto type = ROW({"k1"}, {BIGINT()});
   testGroupBySpill(5'000'000, type, 1, 1000, 1000);
@@ -514,8 +514,11 @@ void makeAlternativePlans(
                           joinNode->isNullAware())
                       .planNode());
 
-  // Use OrderBy + MergeJoin (if join type is inner or left).
-  if (joinNode->isInnerJoin() || joinNode->isLeftJoin()) {
+  // Use OrderBy + MergeJoin (if join type is supported by merge join).
+  if (joinNode->isInnerJoin() || joinNode->isLeftJoin() ||
+      joinNode->isRightJoin() || joinNode->isFullJoin() ||
+      joinNode->isLeftSemiFilterJoin() ||
+      (joinNode->isAntiJoin() && !joinNode->isNullAware())) {
     planNodeIdGenerator->reset();
     plans.push_back(PlanBuilder(planNodeIdGenerator)
                         .values(probeInput)
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -120,6 +121,61 @@ class MergeJoinTest : public HiveConnectorTestBase {
     createDuckDbTable("u", right);
 
     // Test INNER join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kInner,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0");
+
+    // Test LEFT join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kLeft,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
+
+    // Test RIGHT join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kRight,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t RIGHT JOIN u ON t.c0 = u.c0");
+
+    // Test FULL join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kFull,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
+
+    // Test LEFT SEMI join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kLeftSemiFilter,
+        {"c0", "c1"},
+        "SELECT t.c0, t.c1 FROM t WHERE t.c0 IN (SELECT c0 FROM u)");
+
+    // Test ANTI join.
+    testJoin(
+        left,
+        right,
+        core::JoinType::kAnti,
+        {"c0", "c1"},
+        "SELECT t.c0, t.c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.c0 = u.c0)");
+  }
+
+  void testJoin(
+      const std::vector<RowVectorPtr>& left,
+      const std::vector<RowVectorPtr>& right,
+      core::JoinType joinType,
+      const std::vector<std::string>& outputLayout,
+      const std::string& duckDbSql) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
     auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
     auto plan = PlanBuilder(planNodeIdGenerator)
                     .values(left)
@@ -131,55 +187,18 @@ class MergeJoinTest : public HiveConnectorTestBase {
                             .project({"c1 AS u_c1", "c0 AS u_c0"})
                             .planNode(),
                         "",
-                        {"c0", "c1", "u_c1"},
-                        core::JoinType::kInner)
+                        outputLayout,
+                        joinType)
                     .planNode();
 
     // Use very small output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 16),
-        "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0");
+    assertQuery(makeCursorParameters(plan, 16), duckDbSql);
 
     // Use regular output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 1024),
-        "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0");
+    assertQuery(makeCursorParameters(plan, 1024), duckDbSql);
 
     // Use very large output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 10'000),
-        "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0");
-
-    // Test LEFT join.
-    planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
-    plan = PlanBuilder(planNodeIdGenerator)
-               .values(left)
-               .mergeJoin(
-                   {"c0"},
-                   {"u_c0"},
-                   PlanBuilder(planNodeIdGenerator)
-                       .values(right)
-                       .project({"c1 as u_c1", "c0 as u_c0"})
-                       .planNode(),
-                   "",
-                   {"c0", "c1", "u_c1"},
-                   core::JoinType::kLeft)
-               .planNode();
-
-    // Use very small output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 16),
-        "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
-
-    // Use regular output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 1024),
-        "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
-
-    // Use very large output batch size.
-    assertQuery(
-        makeCursorParameters(plan, 10'000),
-        "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
+    assertQuery(makeCursorParameters(plan, 10'000), duckDbSql);
   }
 };
 
@@ -417,6 +436,112 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, joinTypesWithFilter) {
+  // Many-to-many matches, keys without a match on either side and rows with
+  // null keys on both sides. Null keys sort first on the left side and last
+  // on the right side.
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>(
+              100,
+              [](auto row) { return row / 3; },
+              [](auto row) { return row < 4; }),
+          makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+      });
+
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>(
+              80,
+              [](auto row) { return 5 + row / 2; },
+              [](auto row) { return row >= 76; }),
+          makeFlatVector<int32_t>(80, [](auto row) { return row * 7 % 11; }),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto plan = [&](core::JoinType joinType,
+                  const std::string& filter,
+                  const std::vector<std::string>& outputLayout) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            outputLayout,
+            joinType)
+        .planNode();
+  };
+
+  for (auto batchSize : {1, 3, 16, 1024}) {
+    for (auto filter :
+         {"(t_c1 + u_c1) % 2 = 0",
+          "t_c1 > u_c1",
+          "t_c1 + u_c1 > 1000",
+          "t_c1 + u_c1 >= 0"}) {
+      SCOPED_TRACE(fmt::format("{}, batchSize: {}", filter, batchSize));
+      assertQuery(
+          makeCursorParameters(
+              plan(core::JoinType::kRight, filter, {"t_c0", "t_c1", "u_c1"}),
+              batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1, u_c1 FROM t RIGHT JOIN u ON t_c0 = u_c0 AND {}",
+              filter));
+
+      assertQuery(
+          makeCursorParameters(
+              plan(core::JoinType::kFull, filter, {"t_c0", "t_c1", "u_c1"}),
+              batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1, u_c1 FROM t FULL OUTER JOIN u ON t_c0 = u_c0 AND {}",
+              filter));
+
+      assertQuery(
+          makeCursorParameters(
+              plan(core::JoinType::kLeftSemiFilter, filter, {"t_c0", "t_c1"}),
+              batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+
+      assertQuery(
+          makeCursorParameters(
+              plan(core::JoinType::kAnti, filter, {"t_c0", "t_c1"}),
+              batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+    }
+  }
+}
+
+TEST_F(MergeJoinTest, unsupportedJoinType) {
+  auto left = makeRowVector({"t0"}, {makeFlatVector<int64_t>({1, 2, 3})});
+  auto right = makeRowVector({"u0"}, {makeFlatVector<int64_t>({1, 3})});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({left})
+          .mergeJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+              "",
+              {"u0"},
+              core::JoinType::kRightSemiFilter)
+          .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool_.get()),
+      "Merge join supports only inner, left, right, full, left semi filter and anti joins: RIGHT SEMI (FILTER)");
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -540,4 +665,62 @@ TEST_F(MergeJoinTest, nullKeys) {
              .planNode();
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
+
+  // Right join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kRight)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t RIGHT JOIN u ON t.t0 = u.u0");
+
+  // Full join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kFull)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+
+  // Left semi join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0"},
+                 core::JoinType::kLeftSemiFilter)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT * FROM t WHERE EXISTS (SELECT * FROM u WHERE t.t0 = u.u0)");
+
+  // Anti join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0"},
+                 core::JoinType::kAnti)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT * FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.t0 = u.u0)");
 }
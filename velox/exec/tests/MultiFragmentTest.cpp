@@ -19,6 +19,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -213,6 +214,55 @@ TEST_F(MultiFragmentTest, aggregationMultiKey) {
   }
 }
 
+TEST_F(MultiFragmentTest, compressedExchange) {
+  setupSources(10, 1000);
+  for (const std::string codec : {"zstd", "lz4"}) {
+    SCOPED_TRACE(codec);
+    configSettings_[core::QueryConfig::kShuffleCompressionKind] = codec;
+    std::vector<std::shared_ptr<Task>> tasks;
+    auto leafTaskId = makeTaskId(fmt::format("leaf-{}", codec), 0);
+    auto partialAggPlan = PlanBuilder()
+                              .tableScan(rowType_)
+                              .project({"c0 % 10 AS c0", "c1", "c5"})
+                              .partialAggregation({"c0", "c5"}, {"sum(c1)"})
+                              .partitionedOutput({"c0"}, 3)
+                              .planNode();
+    auto leafTask = makeTask(leafTaskId, partialAggPlan, 0);
+    tasks.push_back(leafTask);
+    Task::start(leafTask, 4);
+    addHiveSplits(leafTask, filePaths_);
+
+    core::PlanNodePtr finalAggPlan;
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> finalAggSplits;
+    for (int i = 0; i < 3; i++) {
+      finalAggPlan =
+          PlanBuilder()
+              .exchange(partialAggPlan->outputType())
+              .finalAggregation({"c0", "c5"}, {"sum(a0)"}, {BIGINT()})
+              .partitionedOutput({}, 1)
+              .planNode();
+      auto taskId = makeTaskId(fmt::format("final-agg-{}", codec), i);
+      finalAggSplits.push_back(std::make_shared<RemoteConnectorSplit>(taskId));
+      auto task = makeTask(taskId, finalAggPlan, i);
+      tasks.push_back(task);
+      Task::start(task, 1);
+      addRemoteSplits(task, {leafTaskId});
+    }
+
+    // The consumer must be configured with the same codec as the producers.
+    AssertQueryBuilder(
+        PlanBuilder().exchange(finalAggPlan->outputType()).planNode(),
+        duckDbQueryRunner_)
+        .config(core::QueryConfig::kShuffleCompressionKind, codec)
+        .splits(finalAggSplits)
+        .assertResults("SELECT c0 % 10, c5, sum(c1) FROM tmp GROUP BY 1, 2");
+
+    for (auto& task : tasks) {
+      ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+    }
+  }
+}
+
 TEST_F(MultiFragmentTest, distributedTableScan) {
   setupSources(10, 1000);
   // Run the table scan several times to test the caching.
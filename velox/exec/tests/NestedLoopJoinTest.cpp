@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class NestedLoopJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+
+    // 't' has 1'117 rows with values 0 to 1'116 and a null every 100 rows.
+    probeVectors_ = {
+        makeRowVector({"t0"}, {sequence(10, 0)}),
+        makeRowVector({"t0"}, {sequence(100, 10)}),
+        makeRowVector({"t0"}, {sequence(1'000, 10 + 100)}),
+        makeRowVector({"t0"}, {sequence(7, 10 + 100 + 1'000)}),
+    };
+    // 'u' has ranges [u0, u1] of 3 values that start every 7 values. The
+    // ranges start below 't' and end above it.
+    buildVectors_ = {
+        makeRowVector(
+            {"u0", "u1"},
+            {makeFlatVector<int32_t>(
+                 100, [](auto row) { return row * 7 - 20; }, nullEvery(31)),
+             makeFlatVector<int32_t>(
+                 100, [](auto row) { return row * 7 - 18; })}),
+        makeRowVector(
+            {"u0", "u1"},
+            {makeFlatVector<int32_t>(
+                 110, [](auto row) { return 700 + row * 7; }),
+             makeFlatVector<int32_t>(
+                 110, [](auto row) { return 700 + row * 7 + 2; })}),
+    };
+    createDuckDbTable("t", probeVectors_);
+    createDuckDbTable("u", buildVectors_);
+  }
+
+  VectorPtr sequence(vector_size_t size, int32_t start) {
+    return makeFlatVector<int32_t>(
+        size, [start](auto row) { return start + row; }, nullEvery(100));
+  }
+
+  core::PlanNodePtr makePlan(
+      const std::string& joinCondition,
+      core::JoinType joinType,
+      bool parallelProbe = false) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probeVectors_, parallelProbe)
+        .nestedLoopJoin(
+            PlanBuilder(planNodeIdGenerator).values(buildVectors_).planNode(),
+            joinCondition,
+            {"t0", "u0", "u1"},
+            joinType)
+        .planNode();
+  }
+
+  std::vector<RowVectorPtr> probeVectors_;
+  std::vector<RowVectorPtr> buildVectors_;
+};
+
+TEST_F(NestedLoopJoinTest, joinTypes) {
+  struct {
+    core::JoinType joinType;
+    std::string sqlJoinType;
+  } testSettings[] = {
+      {core::JoinType::kInner, "INNER"},
+      {core::JoinType::kLeft, "LEFT"},
+      {core::JoinType::kRight, "RIGHT"},
+      {core::JoinType::kFull, "FULL"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.sqlJoinType);
+    assertQuery(
+        makePlan("t0 BETWEEN u0 AND u1", testData.joinType),
+        fmt::format(
+            "SELECT t0, u0, u1 FROM t {} JOIN u ON t0 BETWEEN u0 AND u1",
+            testData.sqlJoinType));
+
+    // A condition that no combination passes.
+    assertQuery(
+        makePlan("t0 + u0 < -1000", testData.joinType),
+        fmt::format(
+            "SELECT t0, u0, u1 FROM t {} JOIN u ON t0 + u0 < -1000",
+            testData.sqlJoinType));
+  }
+}
+
+TEST_F(NestedLoopJoinTest, noJoinCondition) {
+  assertQuery(
+      makePlan("", core::JoinType::kInner), "SELECT t0, u0, u1 FROM t, u");
+  assertQuery(
+      makePlan("", core::JoinType::kFull),
+      "SELECT t0, u0, u1 FROM t FULL JOIN u ON true");
+}
+
+TEST_F(NestedLoopJoinTest, emptyBuild) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  for (auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    planNodeIdGenerator->reset();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors_)
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors_)
+                            .filter("u0 < -1000")
+                            .planNode(),
+                        "t0 BETWEEN u0 AND u1",
+                        {"t0", "u0", "u1"},
+                        joinType)
+                    .planNode();
+    if (core::isLeftJoin(joinType) || core::isFullJoin(joinType)) {
+      assertQuery(
+          plan,
+          "SELECT t0, CAST(null AS INTEGER), CAST(null AS INTEGER) FROM t");
+    } else {
+      assertQueryReturnsEmptyResult(plan);
+    }
+  }
+}
+
+TEST_F(NestedLoopJoinTest, outputBatchSize) {
+  // Small output batches split the build vectors and hold few probe rows.
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    const int32_t outputBatchSize = 10;
+    auto task =
+        AssertQueryBuilder(makePlan("", joinType), duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kPreferredOutputBatchSize,
+                std::to_string(outputBatchSize))
+            .assertResults("SELECT t0, u0, u1 FROM t, u");
+    const auto& opStats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(
+        folly::divCeil(opStats.outputPositions, outputBatchSize),
+        opStats.outputVectors);
+  }
+}
+
+// Conditions that bound 't0' by 'u0' and 'u1' join each probe row only with
+// the build rows in its range.
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  // Overlapping ranges [u0, u1] of up to 50 values. Some have null bounds.
+  buildVectors_ = {
+      makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<int32_t>(
+               300, [](auto row) { return (row * 37) % 1'200; }, nullEvery(29)),
+           makeFlatVector<int32_t>(
+               300,
+               [](auto row) { return (row * 37) % 1'200 + row % 50; },
+               nullEvery(41))}),
+  };
+  createDuckDbTable("u", buildVectors_);
+
+  std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u1",
+      "t0 > u0 AND t0 < u1",
+      "u0 <= t0 AND u1 > t0",
+      "t0 >= u0 AND t0 <= u1 AND (t0 + u0) % 3 = 0",
+  };
+  for (const auto& condition : conditions) {
+    SCOPED_TRACE(condition);
+    for (auto joinType :
+         {core::JoinType::kInner,
+          core::JoinType::kLeft,
+          core::JoinType::kRight,
+          core::JoinType::kFull}) {
+      SCOPED_TRACE(core::joinTypeName(joinType));
+      AssertQueryBuilder(makePlan(condition, joinType), duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchSize, "17")
+          .assertResults(fmt::format(
+              "SELECT t0, u0, u1 FROM t {} JOIN u ON {}",
+              core::joinTypeName(joinType),
+              condition));
+    }
+  }
+}
+
+TEST_F(NestedLoopJoinTest, findRangeJoinKeys) {
+  auto makeNode = [&](const std::string& condition) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto buildSide =
+        PlanBuilder(planNodeIdGenerator).values(buildVectors_).planNode();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors_)
+                    .nestedLoopJoin(
+                        buildSide,
+                        condition,
+                        {"t0", "u0", "u1"},
+                        core::JoinType::kInner)
+                    .planNode();
+    return std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(plan);
+  };
+
+  auto keys = findRangeJoinKeys(*makeNode("t0 BETWEEN u1 AND u0"));
+  ASSERT_TRUE(keys.has_value());
+  ASSERT_EQ(keys->probeChannel, 0);
+  ASSERT_EQ(keys->lowerChannel, 1);
+  ASSERT_EQ(keys->upperChannel, 0);
+
+  keys = findRangeJoinKeys(*makeNode("u1 > t0 AND t0 > 5 AND u0 <= t0"));
+  ASSERT_TRUE(keys.has_value());
+  ASSERT_EQ(keys->lowerChannel, 0);
+  ASSERT_EQ(keys->upperChannel, 1);
+
+  // Only one bound, bounds combined with OR or bounds on an expression.
+  ASSERT_FALSE(findRangeJoinKeys(*makeNode("t0 >= u0")).has_value());
+  ASSERT_FALSE(
+      findRangeJoinKeys(*makeNode("t0 >= u0 OR t0 <= u1")).has_value());
+  ASSERT_FALSE(
+      findRangeJoinKeys(*makeNode("t0 + 1 BETWEEN u0 AND u1")).has_value());
+  ASSERT_FALSE(findRangeJoinKeys(*makeNode("")).has_value());
+}
+
+// Test multi-threaded probe side. Each probe Driver gets all of 't' and
+// matches a subset of the build rows. The last probe Driver to finish returns
+// the build rows without a match in any Driver.
+TEST_F(NestedLoopJoinTest, parallelism) {
+  for (auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    AssertQueryBuilder(
+        makePlan("t0 BETWEEN u0 AND u1", joinType, true), duckDbQueryRunner_)
+        .maxDrivers(4)
+        .assertResults(fmt::format(
+            "SELECT t0, u0, u1 FROM "
+            "(SELECT * FROM t UNION ALL SELECT * FROM t "
+            "UNION ALL SELECT * FROM t UNION ALL SELECT * FROM t) t "
+            "{} JOIN u ON t0 BETWEEN u0 AND u1",
+            core::joinTypeName(joinType)));
+  }
+}
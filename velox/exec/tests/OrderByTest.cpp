@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/String.h>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -305,6 +307,72 @@ TEST_F(OrderByTest, multiBatchResult) {
   testSingleKey(vectors, "c0");
 }
 
+TEST_F(OrderByTest, parallel) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (batchSize * i + row) % 97; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<std::string>(
+        batchSize,
+        [&](vector_size_t row) {
+          return fmt::format("{}", (batchSize * i + row) % 31);
+        },
+        nullEvery(7));
+    auto c2 = makeFlatVector<double>(
+        batchSize, [](vector_size_t row) { return row * 0.1; });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  // Each of the drivers reads all of 'vectors'.
+  constexpr int32_t kNumDrivers = 4;
+  const std::string allRows =
+      "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+      "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp)";
+  struct {
+    std::vector<std::string> keys;
+    std::string filter;
+    std::string duckDbOrderBy;
+    std::vector<uint32_t> keyIndices;
+  } testSettings[] = {
+      {{"c0 ASC NULLS LAST"}, "", "c0 NULLS LAST", {0}},
+      {{"c0 DESC NULLS FIRST", "c1 ASC NULLS LAST"},
+       "",
+       "c0 DESC NULLS FIRST, c1 NULLS LAST",
+       {0, 1}},
+      {{"c1 DESC NULLS LAST", "c0 ASC NULLS FIRST"},
+       "",
+       "c1 DESC NULLS LAST, c0 NULLS FIRST",
+       {1, 0}},
+      // Fewer distinct keys than drivers.
+      {{"c0 ASC NULLS LAST"}, "c0 < 2", "c0 NULLS LAST", {0}},
+      // No input.
+      {{"c0 ASC NULLS LAST"}, "c2 < 0", "c0 NULLS LAST", {0}}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(folly::join(", ", testData.keys) + " " + testData.filter);
+    PlanBuilder builder;
+    builder.values(vectors, true);
+    if (!testData.filter.empty()) {
+      builder.filter(testData.filter);
+    }
+    CursorParameters params;
+    params.planNode = builder.parallelOrderBy(testData.keys).planNode();
+    params.maxDrivers = kNumDrivers;
+    assertQueryOrdered(
+        params,
+        fmt::format(
+            "{}{} ORDER BY {}",
+            allRows,
+            testData.filter.empty() ? ""
+                                    : fmt::format(" WHERE {}", testData.filter),
+            testData.duckDbOrderBy),
+        testData.keyIndices);
+  }
+}
+
 TEST_F(OrderByTest, varfields) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
@@ -450,6 +518,23 @@ TEST_F(OrderByTest, spill) {
   EXPECT_EQ(2, stats[0].operatorStats[1].spilledFiles);
 }
 
+TEST_F(OrderByTest, spillUnsupportedCompression) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  // There is no folly codec for lzo. The query fails when the operator is
+  // made, not at the first spill.
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(
+          PlanBuilder().values({data}).orderBy({"c0"}, false).planNode())
+          .spillDirectory(spillDirectory->path)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kOrderBySpillEnabled, "true")
+          .config(core::QueryConfig::kSpillCompressionKind, "lzo")
+          .copyResults(pool()),
+      "Not support lzo in folly");
+}
+
 TEST_F(OrderByTest, spillWithMemoryLimit) {
   constexpr int32_t kNumRows = 2000;
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
@@ -365,6 +365,26 @@ TEST_F(PlanNodeToStringTest, crossJoin) {
       plan->toString(true, false));
 }
 
+TEST_F(PlanNodeToStringTest, nestedLoopJoin) {
+  auto plan = PlanBuilder()
+                  .values({data_})
+                  .project({"c0 as t_c0", "c1 as t_c1"})
+                  .nestedLoopJoin(
+                      PlanBuilder()
+                          .values({data_})
+                          .project({"c0 as u_c0", "c1 as u_c1"})
+                          .planNode(),
+                      "t_c1 > u_c1",
+                      {"t_c0", "t_c1", "u_c1"},
+                      core::JoinType::kLeft)
+                  .planNode();
+
+  ASSERT_EQ("-- NestedLoopJoin\n", plan->toString());
+  ASSERT_EQ(
+      "-- NestedLoopJoin[LEFT, joinCondition: gt(ROW[\"t_c1\"],ROW[\"u_c1\"])] -> t_c0:SMALLINT, t_c1:INTEGER, u_c1:INTEGER\n",
+      plan->toString(true, false));
+}
+
 TEST_F(PlanNodeToStringTest, orderBy) {
   auto plan = PlanBuilder()
                   .values({data_})
@@ -385,6 +405,16 @@ TEST_F(PlanNodeToStringTest, orderBy) {
   ASSERT_EQ(
       "-- OrderBy[c1 ASC NULLS FIRST, c0 DESC NULLS LAST] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
       plan->toString(true, false));
+
+  plan = PlanBuilder()
+             .values({data_})
+             .parallelOrderBy({"c1 ASC NULLS FIRST"})
+             .planNode();
+
+  ASSERT_EQ("-- OrderBy\n", plan->toString());
+  ASSERT_EQ(
+      "-- OrderBy[PARALLEL c1 ASC NULLS FIRST] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
+      plan->toString(true, false));
 }
 
 TEST_F(PlanNodeToStringTest, limit) {
@@ -625,4 +655,14 @@ TEST_F(PlanNodeToStringTest, window) {
       "w0 := window1(ROW[\"c\"]) RANGE between CURRENT ROW and b FOLLOWING] "
       "-> a:VARCHAR, b:BIGINT, c:BIGINT, w0:BIGINT\n",
       plan->toString(true, false));
+
+  plan = PlanBuilder()
+             .tableScan(ROW({"a", "b", "c"}, {VARCHAR(), BIGINT(), BIGINT()}))
+             .streamingWindow({"window1(c) over (partition by a order by b)"})
+             .planNode();
+  ASSERT_EQ(
+      "-- Window[STREAMING partition by [a] order by [b ASC NULLS LAST] "
+      "w0 := window1(ROW[\"c\"]) RANGE between UNBOUNDED PRECEDING and CURRENT ROW] "
+      "-> a:VARCHAR, b:BIGINT, c:BIGINT, w0:BIGINT\n",
+      plan->toString(true, false));
 }
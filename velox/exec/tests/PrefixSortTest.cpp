@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/RowContainerTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class PrefixSortTest : public exec::test::RowContainerTestBase {
+ protected:
+  static constexpr int32_t kNumRows = 1000;
+
+  // Stores 'keys' in a RowContainer with nullable keys, sorts the rows with
+  // PrefixSort for each combination of 'flags' and checks the result against
+  // RowContainer::compareRows.
+  void testSort(const std::vector<VectorPtr>& keys) {
+    std::vector<TypePtr> keyTypes;
+    for (const auto& key : keys) {
+      keyTypes.push_back(key->type());
+    }
+    auto data = makeRowContainer(keyTypes, {}, false);
+    std::vector<char*> rows(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows[i] = data->newRow();
+    }
+    SelectivityVector allRows(kNumRows);
+    for (auto column = 0; column < keys.size(); ++column) {
+      DecodedVector decoded(*keys[column], allRows);
+      for (auto i = 0; i < kNumRows; ++i) {
+        data->store(decoded, i, rows[i], column);
+      }
+    }
+
+    for (auto nullsFirst : {true, false}) {
+      for (auto ascending : {true, false}) {
+        SCOPED_TRACE(fmt::format(
+            "nullsFirst: {}, ascending: {}", nullsFirst, ascending));
+        // Alternates the direction of consecutive keys.
+        std::vector<CompareFlags> flags;
+        for (auto i = 0; i < keys.size(); ++i) {
+          flags.push_back(
+              {nullsFirst, i % 2 == 0 ? ascending : !ascending, false, false});
+        }
+        auto sorted = rows;
+        PrefixSort::sort(
+            *data,
+            flags,
+            folly::Range<char**>(sorted.data(), sorted.size()),
+            *pool_);
+
+        auto expected = rows;
+        std::sort(expected.begin(), expected.end());
+        auto actual = sorted;
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        for (auto i = 1; i < kNumRows; ++i) {
+          ASSERT_LE(data->compareRows(sorted[i - 1], sorted[i], flags), 0)
+              << "at " << i;
+        }
+      }
+    }
+  }
+};
+
+TEST_F(PrefixSortTest, fixedWidth) {
+  testSort(
+      {makeFlatVector<int64_t>(
+           kNumRows, [](auto row) { return row % 7 - 3; }, nullEvery(11)),
+       makeFlatVector<int16_t>(
+           kNumRows, [](auto row) { return row % 5 - 2; }, nullEvery(13)),
+       makeFlatVector<bool>(
+           kNumRows, [](auto row) { return row % 3 == 0; }, nullEvery(17)),
+       makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; })});
+}
+
+TEST_F(PrefixSortTest, floatingPoint) {
+  const std::vector<double> values = {
+      -std::numeric_limits<double>::infinity(),
+      -1.5,
+      -0.0,
+      0.0,
+      1e-300,
+      2.5,
+      std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN(),
+      -std::numeric_limits<double>::quiet_NaN()};
+  testSort(
+      {makeFlatVector<double>(
+           kNumRows,
+           [&](auto row) { return values[row % values.size()]; },
+           nullEvery(7)),
+       makeFlatVector<float>(
+           kNumRows,
+           [&](auto row) { return values[row / 3 % values.size()]; },
+           nullEvery(5)),
+       makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; })});
+}
+
+TEST_F(PrefixSortTest, timestamp) {
+  testSort(
+      {makeFlatVector<Timestamp>(
+           kNumRows,
+           [](auto row) { return Timestamp(row % 5 - 2, row % 3 * 1'000); },
+           nullEvery(7)),
+       makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; })});
+}
+
+TEST_F(PrefixSortTest, strings) {
+  // Strings that share prefixes longer than the prefix of the sort, strings
+  // that are prefixes of each other and strings with zero bytes.
+  const std::string common(40, 'x');
+  const std::vector<std::string> values = {
+      "",
+      "a",
+      std::string("a\0", 2),
+      "ab",
+      "b",
+      common,
+      common + "a",
+      common + "b",
+      "\xff"};
+  testSort(
+      {makeFlatVector<int32_t>(
+           kNumRows, [](auto row) { return row % 2; }, nullEvery(19)),
+       makeFlatVector<StringView>(
+           kNumRows,
+           [&](auto row) { return StringView(values[row % values.size()]); },
+           nullEvery(7)),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 3; })});
+}
+
+TEST_F(PrefixSortTest, noPrefix) {
+  // An array key has no prefix encoding and the rows are compared key by key.
+  testSort(
+      {makeArrayVector<int64_t>(
+           kNumRows,
+           [](vector_size_t row) { return row % 3; },
+           [](vector_size_t row, vector_size_t index) {
+             return (row + index) % 4;
+           }),
+       makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 10; })});
+}
+
+TEST_F(PrefixSortTest, prefixOverflow) {
+  // Keys past the 32 byte prefix are compared on ties of the prefix.
+  testSort(
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 2; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 3; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 5; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 7; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; })});
+}
+
+TEST_F(PrefixSortTest, allocatesFromPool) {
+  auto keys = makeFlatVector<int64_t>(
+      kNumRows, [](auto row) { return kNumRows - row; });
+  auto data = makeRowContainer({BIGINT()}, {}, false);
+  std::vector<char*> rows(kNumRows);
+  DecodedVector decoded(*keys, SelectivityVector(kNumRows));
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+    data->store(decoded, i, rows[i], 0);
+  }
+
+  auto sortPool = memory::getDefaultMemoryPool();
+  PrefixSort::sort(
+      *data, {}, folly::Range<char**>(rows.data(), rows.size()), *sortPool);
+  // A BIGINT key takes a 16 byte prefix next to the row pointer.
+  ASSERT_GE(sortPool->getMaxBytes(), kNumRows * 24);
+  ASSERT_EQ(sortPool->getCurrentBytes(), 0);
+  for (auto i = 1; i < kNumRows; ++i) {
+    ASSERT_LT(data->compareRows(rows[i - 1], rows[i]), 0) << "at " << i;
+  }
+}
@@ -89,7 +89,8 @@ class SpillTest : public testing::Test,
       int numBatches,
       int numRowsPerBatch = 1000,
       int numDuplicates = 1,
-      const std::vector<CompareFlags>& compareFlags = {}) {
+      const std::vector<CompareFlags>& compareFlags = {},
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     ASSERT_TRUE(compareFlags.empty() || compareFlags.size() == 1);
     ASSERT_EQ(numBatches % 2, 0);
 
@@ -144,8 +145,15 @@ class SpillTest : public testing::Test,
     // the batch number of the vector in the partition. When read back, both
     // partitions produce an ascending sequence of integers without gaps.
     state_ = std::make_unique<SpillState>(
-        spillPath_, numPartitions, 1, compareFlags, targetFileSize, *pool());
+        spillPath_,
+        numPartitions,
+        1,
+        compareFlags,
+        targetFileSize,
+        *pool(),
+        compressionKind);
     EXPECT_EQ(targetFileSize, state_->targetFileSize());
+    EXPECT_EQ(compressionKind, state_->compressionKind());
     EXPECT_EQ(numPartitions, state_->maxPartitions());
     EXPECT_EQ(0, state_->spilledPartitions());
     EXPECT_TRUE(state_->spilledPartitionSet().empty());
@@ -217,6 +225,11 @@ class SpillTest : public testing::Test,
     EXPECT_EQ(expectedFiles, state_->spilledFiles());
     EXPECT_LT(
         numPartitions * numBatches * sizeof(int64_t), state_->spilledBytes());
+    if (compressionKind == common::CompressionKind_NONE) {
+      EXPECT_EQ(state_->spilledBytes(), state_->spilledUncompressedBytes());
+    } else {
+      EXPECT_LT(state_->spilledBytes(), state_->spilledUncompressedBytes());
+    }
   }
 
   // 'numDuplicates' specifies the number of duplicates generated for each
@@ -227,7 +240,8 @@ class SpillTest : public testing::Test,
       int numBatches,
       int numDuplicates,
       const std::vector<CompareFlags>& compareFlags,
-      uint64_t expectedNumSpilledFiles) {
+      uint64_t expectedNumSpilledFiles,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     const int numRowsPerBatch = 20'000;
     SCOPED_TRACE(fmt::format(
         "targetFileSize: {}, numPartitions: {}, numBatches: {}, numDuplicates: {}, nullsFirst: {}, ascending: {}",
@@ -243,7 +257,8 @@ class SpillTest : public testing::Test,
         numBatches,
         numRowsPerBatch,
         numDuplicates,
-        compareFlags);
+        compareFlags,
+        compressionKind);
 
     ASSERT_EQ(expectedNumSpilledFiles, state_->spilledFiles());
     std::vector<std::string> spilledFiles = state_->testingSpilledFilePaths();
@@ -338,6 +353,18 @@ TEST_F(SpillTest, spillState) {
   spillStateTest(kGB, 2, 10, 10, {}, 10);
 }
 
+TEST_F(SpillTest, spillStateWithCompression) {
+  for (auto kind :
+       {common::CompressionKind_ZLIB,
+        common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_LZ4}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    spillStateTest(kGB, 2, 10, 1, {CompareFlags{true, true}}, 10, kind);
+    spillStateTest(1, 2, 10, 1, {CompareFlags{false, false}}, 20, kind);
+  }
+}
+
 TEST_F(SpillTest, spillTimestamp) {
   // Verify that timestamp type retains it nanosecond precision when spilled and
   // read back.
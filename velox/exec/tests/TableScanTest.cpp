@@ -21,6 +21,7 @@
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -495,6 +496,96 @@ TEST_F(TableScanTest, multipleSplits) {
   assertQuery(tableScanNode(), filePaths, "SELECT * FROM tmp");
 }
 
+TEST_F(TableScanTest, preloadSplits) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(tableScanNode())
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .maxDrivers(2)
+                  .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+                  .assertResults("SELECT * FROM tmp");
+  auto runtimeStats = getTableScanRuntimeStats(task);
+  EXPECT_GT(runtimeStats["preloadedSplits"].sum, 0);
+  EXPECT_LE(
+      runtimeStats["readyPreloadedSplits"].sum,
+      runtimeStats["preloadedSplits"].sum);
+  EXPECT_EQ(getTableScanStats(task).numSplits, 20);
+
+  // No preload if disabled.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(tableScanNode())
+             .splits(makeHiveConnectorSplits(filePaths))
+             .maxDrivers(2)
+             .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "0")
+             .assertResults("SELECT * FROM tmp");
+  EXPECT_EQ(getTableScanRuntimeStats(task).count("preloadedSplits"), 0);
+
+  // The task finishes with preloaded splits still queued. These must not keep
+  // the task alive.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .limit(0, 10, false)
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+  std::weak_ptr<Task> weakTask =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(plan)
+          .splits(makeHiveConnectorSplits(filePaths))
+          .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+          .assertResults("SELECT 10");
+  task.reset();
+  // The connector's executor may still hold an AsyncSource for a moment.
+  for (auto i = 0; i < 100 && !weakTask.expired(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(weakTask.expired());
+}
+
+TEST_F(TableScanTest, topNDynamicFilter) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto filePaths = makeFilePaths(10);
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < filePaths.size(); i++) {
+    // The first file has the smallest keys.
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }, nullEvery(7)),
+        makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; }),
+    }));
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Once the first file is read, the scan only reads keys up to the 10th.
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(PlanBuilder()
+                            .tableScan(rowType)
+                            .topN({"c0 ASC NULLS LAST"}, 10, false)
+                            .planNode())
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 ASC NULLS LAST LIMIT 10");
+  EXPECT_GT(getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum, 0);
+  EXPECT_GT(getSkippedSplitsStat(task), 0);
+
+  // Nulls first pass the filter. All rows with null keys are in the result.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(PlanBuilder()
+                       .tableScan(rowType)
+                       .topN({"c0 DESC NULLS FIRST"}, 2'000, false)
+                       .planNode())
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertResults(
+                 "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST LIMIT 2000");
+  EXPECT_GT(getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum, 0);
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
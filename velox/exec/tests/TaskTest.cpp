@@ -16,12 +16,14 @@
 #include "velox/exec/Task.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::common::testutil;
@@ -763,4 +765,81 @@ DEBUG_ONLY_TEST_F(TaskTest, liveStats) {
   EXPECT_EQ(1, operatorStats.finishTiming.count);
 }
 
+
+TEST_F(TaskTest, memoryReclaim) {
+  constexpr int64_t kMB = 1 << 20;
+  constexpr vector_size_t kNumRows = 100'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return (row * 7919) % kNumRows; }),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+  });
+  auto filePaths = makeFilePaths(2);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->path, data);
+  }
+
+  memory::MemoryArbitrator arbitrator({256 * kMB, 0, 32 * kMB});
+  auto queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+  queryCtx->setConfigOverridesUnsafe({
+      {core::QueryConfig::kSpillEnabled, "true"},
+      {core::QueryConfig::kOrderBySpillEnabled, "true"},
+  });
+  const auto& queryTracker = queryCtx->pool()->getMemoryUsageTracker();
+  arbitrator.addTracker(queryTracker);
+
+  core::PlanNodeId scanId;
+  core::PlanNodeId orderById;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(data->type()))
+                  .capturePlanNodeId(scanId)
+                  .orderBy({"c0"}, false)
+                  .capturePlanNodeId(orderById)
+                  .planNode();
+  std::atomic<int64_t> numOutputRows{0};
+  Consumer consumer = [&](RowVectorPtr output, ContinueFuture* /*future*/) {
+    if (output != nullptr) {
+      numOutputRows += output->size();
+    }
+    return BlockingReason::kNotBlocked;
+  };
+  auto task = std::make_shared<Task>(
+      "task.memoryReclaim", core::PlanFragment{plan}, 0, queryCtx, consumer);
+  auto spillDirectory = TempDirectoryPath::create();
+  task->setSpillDirectory(spillDirectory->path);
+  task->addSplit(scanId, Split(makeHiveConnectorSplit(filePaths[0]->path)));
+  Task::start(task, 1);
+  ASSERT_TRUE(
+      arbitrator.addReclaimer(queryTracker.get(), task->memoryReclaimer()));
+
+  // Wait for the OrderBy to hold the first split while the scan waits for
+  // the next one.
+  for (;;) {
+    auto planStats = toPlanStats(task->taskStats());
+    if (planStats.count(orderById) != 0 &&
+        planStats.at(orderById).inputRows == kNumRows) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+
+  // Another query asks for more than the task leaves free. The task pauses
+  // and the OrderBy spills.
+  auto requester = memory::MemoryUsageTracker::create();
+  arbitrator.addTracker(requester);
+  const int64_t requestBytes =
+      arbitrator.capacity() - queryTracker->reservedBytes() + kMB;
+  requester->update(requestBytes);
+  ASSERT_GT(arbitrator.stats().reclaimedBytes, 0);
+  ASSERT_EQ(arbitrator.stats().numFailures, 0);
+  requester->update(-requestBytes);
+
+  // The task resumes and produces all rows from the spilled and the new data.
+  task->addSplit(scanId, Split(makeHiveConnectorSplit(filePaths[1]->path)));
+  task->noMoreSplits(scanId);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(numOutputRows.load(), 2 * kNumRows);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(orderById).spilledBytes, 0);
+}
+
 } // namespace facebook::velox::exec::test
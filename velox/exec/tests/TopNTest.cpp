@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -245,3 +248,47 @@ TEST_F(TopNTest, empty) {
 
   testSingleKey(vectors, "c0", "c0 < 0");
 }
+
+TEST_F(TopNTest, spill) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    // c0 values are unique and not in order.
+    auto c0 = makeFlatVector<int64_t>(batchSize, [&](vector_size_t row) {
+      return (batchSize * i + row) * 7'919 % 10'000;
+    });
+    auto c1 = makeFlatVector<StringView>(
+        batchSize,
+        [](vector_size_t row) { return StringView(std::to_string(row)); },
+        nullEvery(31));
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& sortOrderSql : {"ASC", "DESC"}) {
+    // The limit is less than the rows of a batch, more than the rows of a
+    // batch and more than all rows.
+    for (auto limit : {10, 2'500, 20'000}) {
+      SCOPED_TRACE(fmt::format("{} {}", sortOrderSql, limit));
+      auto sql = fmt::format("c0 {}", sortOrderSql);
+      core::PlanNodeId topNId;
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .topN({sql}, limit, false)
+                      .capturePlanNodeId(topNId)
+                      .planNode();
+      auto spillDirectory = TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .assertResults(
+                  fmt::format(
+                      "SELECT * FROM tmp ORDER BY {} LIMIT {}", sql, limit),
+                  {{0}});
+      auto planStats = toPlanStats(task->taskStats());
+      EXPECT_GT(planStats.at(topNId).spilledBytes, 0);
+    }
+  }
+}
@@ -689,12 +689,18 @@ PlanBuilder& PlanBuilder::localMerge(
 
 PlanBuilder& PlanBuilder::orderBy(
     const std::vector<std::string>& keys,
-    bool isPartial) {
+    bool isPartial,
+    bool isParallel) {
   auto [sortingKeys, sortingOrders] =
       parseOrderByClauses(keys, planNode_->outputType(), pool_);
 
   planNode_ = std::make_shared<core::OrderByNode>(
-      nextPlanNodeId(), sortingKeys, sortingOrders, isPartial, planNode_);
+      nextPlanNodeId(),
+      sortingKeys,
+      sortingOrders,
+      isPartial,
+      isParallel,
+      planNode_);
 
   return *this;
 }
@@ -983,6 +989,28 @@ PlanBuilder& PlanBuilder::crossJoin(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::nestedLoopJoin(
+    const core::PlanNodePtr& right,
+    const std::string& joinCondition,
+    const std::vector<std::string>& outputLayout,
+    core::JoinType joinType) {
+  auto resultType = concat(planNode_->outputType(), right->outputType());
+  core::TypedExprPtr joinConditionExpr;
+  if (!joinCondition.empty()) {
+    joinConditionExpr = parseExpr(joinCondition, resultType, options_, pool_);
+  }
+  auto outputType = extract(resultType, outputLayout);
+
+  planNode_ = std::make_shared<core::NestedLoopJoinNode>(
+      nextPlanNodeId(),
+      joinType,
+      std::move(joinConditionExpr),
+      std::move(planNode_),
+      right,
+      outputType);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::unnest(
     const std::vector<std::string>& replicateColumns,
     const std::vector<std::string>& unnestColumns,
@@ -1228,7 +1256,8 @@ bool equalSortOrderList(
 } // namespace
 
 PlanBuilder& PlanBuilder::window(
-    const std::vector<std::string>& windowFunctions) {
+    const std::vector<std::string>& windowFunctions,
+    bool inputsSorted) {
   VELOX_CHECK_GT(
       windowFunctions.size(),
       0,
@@ -1307,6 +1336,7 @@ PlanBuilder& PlanBuilder::window(
       sortingOrders,
       windowNames,
       windowNodeFunctions,
+      inputsSorted,
       planNode_);
   return *this;
 }
@@ -464,7 +464,19 @@ class PlanBuilder {
   ///
   /// By default, uses ASC NULLS LAST sort order, e.g. column "a" above will use
   /// ASC NULLS LAST and column "b" will use DESC NULLS LAST.
-  PlanBuilder& orderBy(const std::vector<std::string>& keys, bool isPartial);
+  /// @param isParallel Specifies that a final OrderBy sorts on multiple
+  /// drivers. See parallelOrderBy().
+  PlanBuilder& orderBy(
+      const std::vector<std::string>& keys,
+      bool isPartial,
+      bool isParallel = false);
+
+  /// Adds a final OrderByNode that runs on multiple drivers. Each driver sorts
+  /// a key range of the input and the ranges are output in order without a
+  /// merge.
+  PlanBuilder& parallelOrderBy(const std::vector<std::string>& keys) {
+    return orderBy(keys, false, true);
+  }
 
   /// Add a TopNNode using specified N and ORDER BY clauses.
   ///
@@ -618,6 +630,24 @@ class PlanBuilder {
       const core::PlanNodePtr& right,
       const std::vector<std::string>& outputLayout);
 
+  /// Add a NestedLoopJoinNode to join two inputs using a join condition. First
+  /// input comes from the preceding plan node. Second input is specified in
+  /// 'right' parameter.
+  ///
+  /// @param right Right-side input. Typically, to reduce memory usage, the
+  /// smaller input is placed on the right-side.
+  /// @param joinCondition SQL expression for the join condition. Can use
+  /// columns from both sides of the join. All combinations of left and right
+  /// rows match if empty.
+  /// @param outputLayout Output layout consisting of columns from left and
+  /// right sides.
+  /// @param joinType Type of the join: inner, left, right or full.
+  PlanBuilder& nestedLoopJoin(
+      const core::PlanNodePtr& right,
+      const std::string& joinCondition,
+      const std::vector<std::string>& outputLayout,
+      core::JoinType joinType = core::JoinType::kInner);
+
   /// Add an UnnestNode to unnest one or more columns of type array or map.
   ///
   /// The output will contain 'replicatedColumns' followed by unnested columns,
@@ -661,7 +691,19 @@ class PlanBuilder {
   /// "row_number() over (order by b) as a"
   /// "row_number() over (partition by a order by b
   ///  rows between a + 10 preceding and 10 following)"
-  PlanBuilder& window(const std::vector<std::string>& windowFunctions);
+  /// @param inputsSorted Specifies that the input is already ordered by the
+  /// PARTITION BY keys followed by the ORDER BY keys. See streamingWindow().
+  PlanBuilder& window(
+      const std::vector<std::string>& windowFunctions,
+      bool inputsSorted = false);
+
+  /// Add a WindowNode for the case where the input is already ordered by the
+  /// PARTITION BY keys followed by the ORDER BY keys. The operator emits each
+  /// partition as soon as all of its rows have arrived.
+  PlanBuilder& streamingWindow(
+      const std::vector<std::string>& windowFunctions) {
+    return window(windowFunctions, true);
+  }
 
   /// Stores the latest plan node ID into the specified variable. Useful for
   /// capturing IDs of the leaf plan nodes (table scans, exchanges, etc.) to use
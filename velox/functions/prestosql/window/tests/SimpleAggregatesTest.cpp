@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/prestosql/window/tests/WindowTestBase.h"
 
 using namespace facebook::velox::exec::test;
@@ -134,6 +137,19 @@ TEST_P(MultiAggregatesTest, singlePartitionRowFrames) {
       {makeSinglePartitionVector(100)}, kFrameOverClauses, kRowsFrameClauses);
 }
 
+TEST_P(MultiAggregatesTest, segmentTreeFrames) {
+  // These frames cannot be aggregated incrementally and are large enough to
+  // be computed from a segment tree. The partition spans several levels of
+  // the tree.
+  SimpleAggregatesTest::testWindowFunction(
+      {makeSinglePartitionVector(5'000)},
+      {"partition by c0 order by c1, c2",
+       "partition by c0 order by c2 desc"},
+      {"rows between current row and unbounded following",
+       "range current row",
+       "range between current row and unbounded following"});
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     SimpleAggregatesTest,
     MultiAggregatesTest,
@@ -147,6 +163,28 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
 
 class StringAggregatesTest : public WindowTestBase {};
 
+class OrderSensitiveAggregatesTest : public WindowTestBase {};
+
+TEST_F(OrderSensitiveAggregatesTest, segmentTreeFrames) {
+  // The frames are large enough to be computed from a segment tree with 2
+  // levels. array_agg must see the rows of each frame in order.
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto /* row */) { return 1; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 50; }),
+  });
+  testWindowFunction(
+      {input},
+      "array_agg(c1)",
+      {"partition by c0 order by c1", "partition by c0 order by c1 desc"},
+      {"rows between current row and unbounded following"});
+  testWindowFunction(
+      {input},
+      "array_agg(c2)",
+      {"partition by c0 order by c1"},
+      {"rows between current row and unbounded following"});
+}
+
 TEST_F(StringAggregatesTest, nonFixedWidthAggregate) {
   auto vectors = makeFuzzVectors(
       ROW({"c0", "c1", "c2"}, {BIGINT(), SMALLINT(), VARCHAR()}), 10, 2);
@@ -155,5 +193,90 @@ TEST_F(StringAggregatesTest, nonFixedWidthAggregate) {
   testWindowFunction(vectors, "max(c2)", kSortOrderBasedOverClauses);
 }
 
+class WindowSpillTest : public WindowTestBase {};
+
+TEST_F(WindowSpillTest, spill) {
+  const vector_size_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            kBatchSize, [](auto row) { return row % 17; }, nullEvery(31)),
+        makeFlatVector<int32_t>(kBatchSize, [](auto row) { return row % 5; }),
+        makeFlatVector<int32_t>(
+            kBatchSize,
+            [i, kBatchSize](auto row) { return i * kBatchSize + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> functions = {
+      "sum(c2) over (partition by c0 order by c1, c2)",
+      "row_number() over (partition by c0 order by c1, c2)"};
+  auto plan = PlanBuilder().values(vectors).window(functions).planNode();
+  const auto sql = fmt::format(
+      "SELECT c0, c1, c2, {} FROM tmp", folly::join(", ", functions));
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                  .config(core::QueryConfig::kTestingSpillPct, "100")
+                  .assertResults(sql);
+  const auto& stats = task->taskStats().pipelineStats[0].operatorStats[1];
+  EXPECT_LT(0, stats.spilledBytes);
+  EXPECT_LT(0, stats.spilledRows);
+  EXPECT_EQ(1, stats.spilledPartitions);
+
+  // Without spilling the results are the same.
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kWindowSpillEnabled, "false")
+             .assertResults(sql);
+  EXPECT_EQ(
+      0, task->taskStats().pipelineStats[0].operatorStats[1].spilledBytes);
+}
+
+class StreamingWindowTest : public WindowTestBase {};
+
+TEST_F(StreamingWindowTest, sortedInput) {
+  // The input is ordered by c0, c1. The partitions span batches.
+  const vector_size_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            kBatchSize,
+            [i, kBatchSize](auto row) { return (i * kBatchSize + row) / 700; }),
+        makeFlatVector<int32_t>(
+            kBatchSize,
+            [i, kBatchSize](auto row) { return i * kBatchSize + row; }),
+        makeFlatVector<int64_t>(
+            kBatchSize, [](auto row) { return row % 11; }, nullEvery(13)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> functions = {
+      "sum(c2) over (partition by c0 order by c1)",
+      "row_number() over (partition by c0 order by c1)",
+      "count(c2) over (partition by c0 order by c1 "
+      "rows between unbounded preceding and unbounded following)"};
+  const auto sql = fmt::format(
+      "SELECT c0, c1, c2, {} FROM tmp", folly::join(", ", functions));
+
+  auto plan =
+      PlanBuilder().values(vectors).streamingWindow(functions).planNode();
+  assertQuery(plan, sql);
+
+  // A single partition.
+  plan = PlanBuilder()
+             .values(vectors)
+             .streamingWindow({"row_number() over (order by c1)"})
+             .planNode();
+  assertQuery(
+      plan, "SELECT c0, c1, c2, row_number() over (order by c1) FROM tmp");
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
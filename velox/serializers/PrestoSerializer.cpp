@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/serializers/PrestoSerializer.h"
+#include <folly/container/F14Map.h>
 #include "velox/common/base/Crc.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
@@ -30,6 +31,10 @@ constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
 constexpr folly::StringPiece kRLE{"RLE"};
+constexpr folly::StringPiece kDictionary{"DICTIONARY"};
+// Size of the dictionary source id that follows the indices of a DICTIONARY
+// block in the Presto wire format. Velox does not use it.
+constexpr int32_t kDictionarySourceIdSize = 3 * sizeof(int64_t);
 
 int64_t computeChecksum(
     PrestoOutputStreamListener* listener,
@@ -44,14 +49,33 @@ int64_t computeChecksum(
 }
 
 int64_t computeChecksum(
-    ByteStream* source,
+    const folly::IOBuf& body,
     int codecMarker,
     int numRows,
     int uncompressedSize) {
+  bits::Crc32 crc32;
+  for (auto range : body) {
+    crc32.process_bytes(range.data(), range.size());
+  }
+  crc32.process_bytes(&codecMarker, 1);
+  crc32.process_bytes(&numRows, 4);
+  crc32.process_bytes(&uncompressedSize, 4);
+  return crc32.checksum();
+}
+
+// Computes the checksum of the next 'sizeInBytes' bytes of 'source' without
+// advancing it. 'sizeInBytes' differs from 'uncompressedSize' for compressed
+// pages, whose checksum covers the compressed bytes.
+int64_t computeChecksum(
+    ByteStream* source,
+    int codecMarker,
+    int numRows,
+    int uncompressedSize,
+    int sizeInBytes) {
   auto offset = source->tellp();
   bits::Crc32 crc32;
 
-  auto remainingBytes = uncompressedSize;
+  auto remainingBytes = sizeInBytes;
   while (remainingBytes > 0) {
     auto data = source->nextView(remainingBytes);
     crc32.process_bytes(data.data(), data.size());
@@ -68,9 +92,14 @@ int64_t computeChecksum(
   return checksum;
 }
 
-char getCodecMarker() {
+char getCodecMarker(bool checksum, bool compressed) {
   char marker = 0;
-  marker |= kCheckSumBitMask;
+  if (checksum) {
+    marker |= kCheckSumBitMask;
+  }
+  if (compressed) {
+    marker |= kCompressedBitMask;
+  }
   return marker;
 }
 
@@ -464,6 +493,26 @@ void readConstantVector(
   *result = BaseVector::wrapInConstant(size, 0, children[0]);
 }
 
+void readDictionaryVector(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr* result,
+    bool useLosslessTimestamp) {
+  auto size = source->read<int32_t>();
+  std::vector<TypePtr> childTypes = {type};
+  std::vector<VectorPtr> children(1);
+  readColumns(source, pool, childTypes, &children, useLosslessTimestamp);
+
+  BufferPtr indices = allocateIndices(size, pool);
+  source->readBytes(
+      indices->asMutable<uint8_t>(), size * sizeof(vector_size_t));
+  // Skip the dictionary source id.
+  source->skip(kDictionarySourceIdSize);
+  *result = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr), indices, size, children[0]);
+}
+
 void readArrayVector(
     ByteStream* source,
     std::shared_ptr<const Type> type,
@@ -754,6 +803,9 @@ void readColumns(
     if (encoding == kRLE) {
       readConstantVector(
           source, types[i], pool, &(*result)[i], useLosslessTimestamp);
+    } else if (encoding == kDictionary) {
+      readDictionaryVector(
+          source, types[i], pool, &(*result)[i], useLosslessTimestamp);
     } else {
       checkTypeEncoding(encoding, types[i]);
       auto it = readers.find(types[i]->kind());
@@ -1621,16 +1673,138 @@ void estimateSerializedSizeInt(
   }
 }
 
+// Serializes a top-level column as a DICTIONARY block, or as an RLE block if
+// all rows refer to the same value. The distinct values referenced by the
+// appended rows form the dictionary. They are appended to the VectorStream of
+// the column, which is passed in by the caller. Rows that refer to the same
+// value of the same wrapped vector share one dictionary entry, as do
+// consecutive constant vectors with equal values and all null rows.
+class DictionaryEncoder {
+ public:
+  DictionaryEncoder(StreamArena* streamArena, int32_t initialNumRows)
+      : indices_(streamArena) {
+    indices_.startWrite(
+        std::max<int32_t>(initialNumRows, 1) * sizeof(vector_size_t));
+  }
+
+  void append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      VectorStream* dictionary) {
+    const auto* base = vector->wrappedVector();
+    if (base != base_) {
+      startBase(vector, base);
+    }
+
+    std::vector<IndexRange> newRanges;
+    for (const auto& range : ranges) {
+      for (auto row = range.begin; row < range.begin + range.size; ++row) {
+        vector_size_t index;
+        if (vector->isNullAt(row)) {
+          if (nullIndex_ < 0) {
+            // The null entry must come after the pending new entries.
+            if (!newRanges.empty()) {
+              serializeColumn(base, newRanges, dictionary);
+              newRanges.clear();
+            }
+            dictionary->appendNull();
+            nullIndex_ = dictionarySize_++;
+          }
+          index = nullIndex_;
+        } else {
+          auto wrappedIndex = vector->wrappedIndex(row);
+          auto it = baseIndices_.find(wrappedIndex);
+          if (it != baseIndices_.end()) {
+            index = it->second;
+          } else {
+            index = dictionarySize_++;
+            baseIndices_[wrappedIndex] = index;
+            newRanges.push_back(IndexRange{wrappedIndex, 1});
+          }
+        }
+        indices_.appendOne(index);
+      }
+      numRows_ += range.size;
+    }
+    if (!newRanges.empty()) {
+      serializeColumn(base, newRanges, dictionary);
+    }
+  }
+
+  // Writes out the accumulated contents with 'dictionary' as the dictionary.
+  // Does not change the state.
+  void flush(VectorStream* dictionary, OutputStream* out) {
+    if (dictionarySize_ == 1 && numRows_ > 1) {
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      writeInt32(out, numRows_);
+      dictionary->flush(out);
+      return;
+    }
+    writeInt32(out, kDictionary.size());
+    out->write(kDictionary.data(), kDictionary.size());
+    writeInt32(out, numRows_);
+    dictionary->flush(out);
+    indices_.flush(out);
+    const char sourceId[kDictionarySourceIdSize] = {};
+    out->write(sourceId, kDictionarySourceIdSize);
+  }
+
+ private:
+  // Resets the mapping from rows of the wrapped vector to dictionary entries
+  // when 'vector' wraps a different vector than the previous append.
+  void startBase(const VectorPtr& vector, const BaseVector* base) {
+    std::optional<vector_size_t> constantIndex;
+    if (vector->isConstantEncoding() && baseHolder_ &&
+        baseHolder_->isConstantEncoding() && !vector->isNullAt(0) &&
+        !baseHolder_->isNullAt(0) &&
+        vector->equalValueAt(baseHolder_.get(), 0, 0)) {
+      constantIndex = baseIndices_[baseHolder_->wrappedIndex(0)];
+    }
+    baseIndices_.clear();
+    if (constantIndex.has_value()) {
+      baseIndices_[vector->wrappedIndex(0)] = constantIndex.value();
+    }
+    // Holding on to 'vector' keeps 'base' alive, so that a different vector
+    // cannot be allocated at the same address while 'baseIndices_' refers to
+    // it.
+    baseHolder_ = vector;
+    base_ = base;
+  }
+
+  ByteStream indices_;
+  int32_t numRows_{0};
+  vector_size_t dictionarySize_{0};
+  // Index of the null entry in the dictionary. -1 if there is none.
+  vector_size_t nullIndex_{-1};
+  VectorPtr baseHolder_;
+  const BaseVector* base_{nullptr};
+  // Maps rows of 'base_' to their entries in the dictionary.
+  folly::F14FastMap<vector_size_t, vector_size_t> baseIndices_;
+};
+
 class PrestoVectorSerializer : public VectorSerializer {
  public:
   PrestoVectorSerializer(
       std::shared_ptr<const RowType> rowType,
       int32_t numRows,
       StreamArena* streamArena,
-      bool useLosslessTimestamp) {
+      bool useLosslessTimestamp,
+      common::CompressionKind compressionKind,
+      float minCompressionRatio,
+      bool preserveEncodings)
+      : streamArena_(streamArena),
+        codec_(
+            compressionKind == common::CompressionKind_NONE
+                ? nullptr
+                : common::compressionKindToCodec(compressionKind)),
+        minCompressionRatio_(minCompressionRatio),
+        preserveEncodings_(preserveEncodings),
+        initialNumRows_(numRows) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
+    dictionaryEncoders_.resize(numTypes);
     for (int i = 0; i < numTypes; i++) {
       streams_[i] = std::make_unique<VectorStream>(
           types[i], streamArena, numRows, useLosslessTimestamp);
@@ -1642,9 +1816,18 @@ class PrestoVectorSerializer : public VectorSerializer {
       const folly::Range<const IndexRange*>& ranges) override {
     auto newRows = rangesTotalSize(ranges);
     if (newRows > 0) {
+      if (numRows_ == 0 && preserveEncodings_) {
+        chooseEncodings(*vector);
+      }
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-        serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
+        if (dictionaryEncoders_[i]) {
+          dictionaryEncoders_[i]->append(
+              vector->childAt(i), ranges, streams_[i].get());
+        } else {
+          serializeColumn(
+              vector->childAt(i).get(), ranges, streams_[i].get());
+        }
       }
     }
   }
@@ -1660,23 +1843,31 @@ class PrestoVectorSerializer : public VectorSerializer {
     }
 
     std::vector<IndexRange> ranges{{0, 1}};
-    append(vector, folly::Range(ranges.data(), ranges.size()));
+    numRows_ = 1;
+    for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+      serializeColumn(
+          vector->childAt(i).get(),
+          folly::Range(ranges.data(), ranges.size()),
+          streams_[i].get());
+    }
 
     flushInternal(vector->size(), true /*rle*/, out);
   }
 
   // Writes the contents to 'stream' in wire format
   void flushInternal(int32_t numRows, bool rle, OutputStream* out) {
+    if (codec_ != nullptr) {
+      flushCompressed(numRows, rle, out);
+      return;
+    }
+
     auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
     // Reset CRC computation
     if (listener) {
       listener->reset();
     }
 
-    char codec = 0;
-    if (listener) {
-      codec = getCodecMarker();
-    }
+    char codec = getCodecMarker(listener != nullptr, false /*compressed*/);
 
     int32_t offset = out->tellp();
 
@@ -1697,19 +1888,7 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (listener) {
       listener->resume();
     }
-    writeInt32(out, streams_.size());
-
-    if (rle) {
-      // Write RLE encoding marker.
-      writeInt32(out, kRLE.size());
-      out->write(kRLE.data(), kRLE.size());
-      // Write number of RLE values.
-      writeInt32(out, numRows);
-    }
-
-    for (auto& stream : streams_) {
-      stream->flush(out);
-    }
+    writeColumns(numRows, rle, out);
 
     // Pause CRC computation
     if (listener) {
@@ -1735,8 +1914,91 @@ class PrestoVectorSerializer : public VectorSerializer {
   static const int32_t kSizeInBytesOffset{4 + 1};
   static const int32_t kHeaderSize{kSizeInBytesOffset + 4 + 4 + 8};
 
+  // Writes the number of columns, the RLE marker if 'rle' is set and the
+  // content of 'streams_'. This is the part of a page that gets compressed.
+  void writeColumns(int32_t numRows, bool rle, OutputStream* out) {
+    writeInt32(out, streams_.size());
+
+    if (rle) {
+      // Write RLE encoding marker.
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      // Write number of RLE values.
+      writeInt32(out, numRows);
+    }
+
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (dictionaryEncoders_[i]) {
+        dictionaryEncoders_[i]->flush(streams_[i].get(), out);
+      } else {
+        streams_[i]->flush(out);
+      }
+    }
+  }
+
+  // Decides for each column whether to keep its encoding based on the first
+  // appended batch. Columns that arrive dictionary or constant encoded are
+  // serialized as DICTIONARY or RLE blocks for the rest of the page.
+  void chooseEncodings(const RowVector& vector) {
+    for (auto i = 0; i < vector.childrenSize(); ++i) {
+      const auto encoding = vector.childAt(i)->encoding();
+      if (encoding == VectorEncoding::Simple::DICTIONARY ||
+          encoding == VectorEncoding::Simple::CONSTANT) {
+        dictionaryEncoders_[i] = std::make_unique<DictionaryEncoder>(
+            streamArena_, initialNumRows_);
+      }
+    }
+  }
+
+  // Writes a page whose body is compressed with 'codec_'. The body is
+  // serialized into a scratch stream first since its compressed size is only
+  // known after compression. The checksum covers the bytes as written. If
+  // compression does not reach 'minCompressionRatio_', the body is written
+  // uncompressed and the compressed bit is not set.
+  void flushCompressed(int32_t numRows, bool rle, OutputStream* out) {
+    IOBufOutputStream body(*streamArena_->pool());
+    writeColumns(numRows, rle, &body);
+    auto uncompressed = body.getIOBuf();
+    const int32_t uncompressedSize = uncompressed->computeChainDataLength();
+    auto compressed = codec_->compress(uncompressed.get());
+    const bool useCompressed = compressed->computeChainDataLength() <=
+        uncompressedSize * minCompressionRatio_;
+    const auto& page = useCompressed ? *compressed : *uncompressed;
+    const int32_t sizeInBytes = page.computeChainDataLength();
+
+    auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
+    const char codec = getCodecMarker(listener != nullptr, useCompressed);
+    int64_t crc = 0;
+    if (listener) {
+      crc = computeChecksum(page, codec, numRows, uncompressedSize);
+      listener->pause();
+    }
+
+    writeInt32(out, numRows);
+    out->write(&codec, 1);
+    writeInt32(out, uncompressedSize);
+    writeInt32(out, sizeInBytes);
+    writeInt64(out, crc);
+    for (auto range : page) {
+      out->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+
+    if (listener) {
+      listener->resume();
+    }
+  }
+
+  StreamArena* const streamArena_;
+  // Codec for compressing page bodies. Null if pages are not compressed.
+  const std::unique_ptr<folly::io::Codec> codec_;
+  const float minCompressionRatio_;
+  const bool preserveEncodings_;
+  const int32_t initialNumRows_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+  // Encoders for the columns that are serialized as DICTIONARY or RLE blocks.
+  // Null for columns serialized as flat blocks.
+  std::vector<std::unique_ptr<DictionaryEncoder>> dictionaryEncoders_;
 };
 } // namespace
 
@@ -1752,11 +2014,18 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
     int32_t numRows,
     StreamArena* streamArena,
     const Options* options) {
-  bool useLosslessTimestamp = options != nullptr
-      ? static_cast<const PrestoOptions*>(options)->useLosslessTimestamp
-      : false;
+  static const PrestoOptions kDefaultOptions(false);
+  const auto& prestoOptions = options != nullptr
+      ? *static_cast<const PrestoOptions*>(options)
+      : kDefaultOptions;
   return std::make_unique<PrestoVectorSerializer>(
-      type, numRows, streamArena, useLosslessTimestamp);
+      type,
+      numRows,
+      streamArena,
+      prestoOptions.useLosslessTimestamp,
+      prestoOptions.compressionKind,
+      prestoOptions.minCompressionRatio,
+      prestoOptions.preserveEncodings);
 }
 
 void PrestoVectorSerde::serializeConstants(
@@ -1789,25 +2058,48 @@ void PrestoVectorSerde::deserialize(
 
   auto pageCodecMarker = source->read<int8_t>();
   auto uncompressedSize = source->read<int32_t>();
-  // skip size in bytes
-  source->skip(4);
+  auto sizeInBytes = source->read<int32_t>();
   auto checksum = source->read<int64_t>();
 
   int64_t actualCheckSum = 0;
   if (isChecksumBitSet(pageCodecMarker)) {
-    actualCheckSum =
-        computeChecksum(source, pageCodecMarker, numRows, uncompressedSize);
+    actualCheckSum = computeChecksum(
+        source, pageCodecMarker, numRows, uncompressedSize, sizeInBytes);
   }
 
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  // skip number of columns
-  source->skip(4);
-
   auto children = &(*result)->children();
   auto childTypes = type->as<TypeKind::ROW>().children();
-  readColumns(source, pool, childTypes, children, useLosslessTimestamp);
+  if (!isCompressedBitSet(pageCodecMarker)) {
+    // skip number of columns
+    source->skip(4);
+    readColumns(source, pool, childTypes, children, useLosslessTimestamp);
+    return;
+  }
+
+  const auto compressionKind = options != nullptr
+      ? static_cast<const PrestoOptions*>(options)->compressionKind
+      : common::CompressionKind_NONE;
+  VELOX_CHECK(
+      compressionKind != common::CompressionKind_NONE,
+      "Received a compressed page without a configured compression codec.");
+  auto compressed = folly::IOBuf::create(sizeInBytes);
+  source->readBytes(compressed->writableData(), sizeInBytes);
+  compressed->append(sizeInBytes);
+  auto uncompressed = common::compressionKindToCodec(compressionKind)
+                          ->uncompress(compressed.get(), uncompressedSize);
+  uncompressed->coalesce();
+  VELOX_CHECK_EQ(uncompressed->length(), (size_t)uncompressedSize);
+
+  ByteStream uncompressedSource;
+  uncompressedSource.setRange(
+      {uncompressed->writableData(), uncompressedSize, 0});
+  // skip number of columns
+  uncompressedSource.skip(4);
+  readColumns(
+      &uncompressedSource, pool, childTypes, children, useLosslessTimestamp);
 }
 
 // static
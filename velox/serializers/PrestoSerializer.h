@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "velox/common/base/Crc.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::serializer::presto {
@@ -22,13 +23,34 @@ class PrestoVectorSerde : public VectorSerde {
  public:
   // Input options that the serializer recognizes.
   struct PrestoOptions : VectorSerde::Options {
-    explicit PrestoOptions(bool useLosslessTimestamp)
-        : useLosslessTimestamp(useLosslessTimestamp) {}
+    explicit PrestoOptions(
+        bool useLosslessTimestamp,
+        common::CompressionKind compressionKind = common::CompressionKind_NONE,
+        float minCompressionRatio = 0.8,
+        bool preserveEncodings = false)
+        : useLosslessTimestamp(useLosslessTimestamp),
+          compressionKind(compressionKind),
+          minCompressionRatio(minCompressionRatio),
+          preserveEncodings(preserveEncodings) {}
     // Currently presto only supports millisecond precision and the serializer
     // converts velox native timestamp to that resulting in loss of precision.
     // This option allows it to serialize with nanosecond precision and is
     // currently used for spilling. Is false by default.
     bool useLosslessTimestamp{false};
+    // Codec used to compress the body of each serialized page. The wire format
+    // only records whether a page is compressed, not with which codec, so the
+    // reader must be configured with the same codec as the writer.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+    // A page is sent uncompressed if compressing it does not shrink it below
+    // this fraction of its uncompressed size. Such pages are not worth the
+    // decompression cost on the reader side.
+    float minCompressionRatio{0.8};
+    // If true, columns that are dictionary or constant encoded in the first
+    // batch appended to a page are serialized as DICTIONARY or RLE blocks
+    // instead of being flattened. The deserializer returns such columns as
+    // dictionary or constant vectors. Pages in this format can be read
+    // regardless of this option.
+    bool preserveEncodings{false};
   };
 
   void estimateSerializedSize(
@@ -366,3 +366,148 @@ TEST_F(PrestoSerializerTest, rle) {
   testRleRoundTrip(BaseVector::createNullConstant(
       MAP(VARCHAR(), INTEGER()), 17, pool_.get()));
 }
+
+TEST_F(PrestoSerializerTest, compression) {
+  auto rowVector = makeTestVector(10'000);
+  auto rowType = asRowType(rowVector->type());
+
+  std::ostringstream uncompressedOut;
+  serialize(rowVector, &uncompressedOut, nullptr);
+
+  for (auto kind :
+       {common::CompressionKind_ZLIB,
+        common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_LZ4}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    const serializer::presto::PrestoVectorSerde::PrestoOptions options(
+        false, kind);
+    std::ostringstream out;
+    serialize(rowVector, &out, &options);
+    EXPECT_LT(out.str().size(), uncompressedOut.str().size());
+
+    auto deserialized = deserialize(rowType, out.str(), &options);
+    assertEqualVectors(deserialized, rowVector);
+
+    // The page does not record its codec, so the reader must be configured
+    // with one.
+    VELOX_ASSERT_THROW(
+        deserialize(rowType, out.str(), nullptr),
+        "Received a compressed page without a configured compression codec.");
+  }
+}
+
+TEST_F(PrestoSerializerTest, skipIncompressiblePage) {
+  // Random strings do not compress. Such pages are sent uncompressed and can
+  // be read without a codec.
+  std::vector<std::string> strings(1'000, std::string(32, ' '));
+  for (auto& value : strings) {
+    for (auto& c : value) {
+      c = folly::Random::rand32();
+    }
+  }
+  auto rowVector = vectorMaker_->rowVector({vectorMaker_->flatVector(strings)});
+  auto rowType = asRowType(rowVector->type());
+
+  std::ostringstream uncompressedOut;
+  serialize(rowVector, &uncompressedOut, nullptr);
+
+  const serializer::presto::PrestoVectorSerde::PrestoOptions options(
+      false, common::CompressionKind_LZ4);
+  std::ostringstream out;
+  serialize(rowVector, &out, &options);
+  EXPECT_EQ(out.str().size(), uncompressedOut.str().size());
+  assertEqualVectors(deserialize(rowType, out.str(), nullptr), rowVector);
+  assertEqualVectors(deserialize(rowType, out.str(), &options), rowVector);
+
+  // A ratio above 1 makes the serializer keep even pages that grow.
+  const serializer::presto::PrestoVectorSerde::PrestoOptions alwaysCompress(
+      false, common::CompressionKind_LZ4, 2.0);
+  std::ostringstream compressedOut;
+  serialize(rowVector, &compressedOut, &alwaysCompress);
+  EXPECT_NE(compressedOut.str(), uncompressedOut.str());
+  assertEqualVectors(
+      deserialize(rowType, compressedOut.str(), &alwaysCompress), rowVector);
+}
+
+TEST_F(PrestoSerializerTest, preserveEncodings) {
+  const vector_size_t size = 1'000;
+  auto base = vectorMaker_->flatVector<std::string>(
+      {"apple", "banana", "cherry", "durian", "elderberry"});
+  BufferPtr nulls = AlignedBuffer::allocate<bool>(size, pool_.get());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  BufferPtr indices = allocateIndices(size, pool_.get());
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; ++i) {
+    bits::setNull(rawNulls, i, i % 7 == 0);
+    rawIndices[i] = i % 5;
+  }
+  auto rowVector = vectorMaker_->rowVector(
+      {BaseVector::wrapInDictionary(nulls, indices, size, base),
+       BaseVector::createConstant(int64_t(11), size, pool_.get()),
+       BaseVector::createNullConstant(DOUBLE(), size, pool_.get()),
+       vectorMaker_->flatVector<int32_t>(size, [](auto row) { return row; })});
+  auto rowType = asRowType(rowVector->type());
+
+  std::ostringstream flatOut;
+  serialize(rowVector, &flatOut, nullptr);
+
+  const serializer::presto::PrestoVectorSerde::PrestoOptions options(
+      false, common::CompressionKind_NONE, 0.8, true);
+  std::ostringstream out;
+  serialize(rowVector, &out, &options);
+  EXPECT_LT(out.str().size(), flatOut.str().size());
+
+  // Reading does not depend on the option.
+  for (const auto* readOptions : {&options, nullptr}) {
+    auto deserialized = deserialize(rowType, out.str(), readOptions);
+    assertEqualVectors(rowVector, deserialized);
+    EXPECT_EQ(
+        deserialized->childAt(0)->encoding(),
+        VectorEncoding::Simple::DICTIONARY);
+    // The dictionary has one entry per distinct value plus one for null.
+    EXPECT_EQ(deserialized->childAt(0)->valueVector()->size(), 6);
+    EXPECT_TRUE(deserialized->childAt(1)->isConstantEncoding());
+    EXPECT_TRUE(deserialized->childAt(2)->isConstantEncoding());
+    EXPECT_EQ(
+        deserialized->childAt(3)->encoding(), VectorEncoding::Simple::FLAT);
+  }
+}
+
+TEST_F(PrestoSerializerTest, preserveEncodingsAcrossBatches) {
+  // Equal constants appended from different vectors stay one RLE block. A
+  // different constant turns the column into a dictionary.
+  auto makeBatch = [&](int64_t value) {
+    return vectorMaker_->rowVector(
+        {BaseVector::createConstant(value, 10, pool_.get())});
+  };
+  const serializer::presto::PrestoVectorSerde::PrestoOptions options(
+      false, common::CompressionKind_NONE, 0.8, true);
+  auto serializeBatches = [&](const std::vector<RowVectorPtr>& batches) {
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createSerializer(
+        asRowType(batches[0]->type()), 10, arena.get(), &options);
+    std::vector<IndexRange> ranges{{0, 10}};
+    for (const auto& batch : batches) {
+      serializer->append(batch, folly::Range(ranges.data(), ranges.size()));
+    }
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    return deserialize(asRowType(batches[0]->type()), output.str(), nullptr);
+  };
+
+  auto result = serializeBatches({makeBatch(1), makeBatch(1)});
+  EXPECT_TRUE(result->childAt(0)->isConstantEncoding());
+  assertEqualVectors(
+      vectorMaker_->flatVector<int64_t>(20, [](auto) { return 1; }),
+      result->childAt(0));
+
+  result = serializeBatches({makeBatch(1), makeBatch(2), makeBatch(1)});
+  EXPECT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  assertEqualVectors(
+      vectorMaker_->flatVector<int64_t>(
+          30, [](auto row) { return row / 10 == 1 ? 2 : 1; }),
+      result->childAt(0));
+}
@@ -180,6 +180,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
       sortingKeys,
       sortingOrders,
       false /*isPartial*/,
+      false /*isParallel*/,
       childNode);
 }
 
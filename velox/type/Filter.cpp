@@ -86,6 +86,9 @@ std::string Filter::toString() const {
     case FilterKind::kMultiRange:
       strKind = "MultiRange";
       break;
+    case FilterKind::kValuesUsingBloomFilter:
+      strKind = "ValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -1897,4 +1900,70 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+bool ValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (otherFilter_ && !otherFilter_->testInt64Range(min, max, false)) {
+    return false;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  // The Bloom filter cannot tell if a range has a passing value.
+  return true;
+}
+
+bool ValuesUsingBloomFilter::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (otherFilter_ && !otherFilter_->testBytesRange(min, max, false)) {
+    return false;
+  }
+
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->length());
+  }
+
+  return true;
+}
+
+std::unique_ptr<Filter> ValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    default: {
+      // Other filters do not know how to merge with a Bloom filter. The
+      // merged filter wraps the combination of 'otherFilter_' and 'other'.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::shared_ptr<const Filter> merged;
+      if (!otherFilter_) {
+        merged = other->clone();
+      } else if (other->kind() == FilterKind::kValuesUsingBloomFilter) {
+        merged = other->mergeWith(otherFilter_.get());
+      } else {
+        merged = otherFilter_->mergeWith(other);
+      }
+      return std::make_unique<ValuesUsingBloomFilter>(
+          mayContain_, bothNullAllowed, std::move(merged));
+    }
+  }
+}
 } // namespace facebook::velox::common
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -24,6 +25,7 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -52,6 +54,7 @@ enum class FilterKind {
   kNegatedBytesValues,
   kBigintMultiRange,
   kMultiRange,
+  kValuesUsingBloomFilter,
 };
 
 /**
@@ -1672,6 +1675,94 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// IN-list filter for integral and string data types implemented as a Bloom
+/// filter over the hashes of the values. Passes all the values in the list and
+/// a small fraction of the other values. Used for dynamic filters from hash
+/// joins whose build side has too many distinct keys for an exact IN-list.
+/// Merging with another filter keeps the other filter and tests it before
+/// the Bloom filter. The Bloom filter is probed through a function, so the
+/// maker decides how its bits are allocated, e.g. from the pool of an
+/// operator.
+class ValuesUsingBloomFilter final : public Filter {
+ public:
+  /// Returns true if the Bloom filter may contain 'hash'. The function owns
+  /// the Bloom filter.
+  using MayContain = std::function<bool(uint64_t hash)>;
+
+  /// @param mayContain Probe of a Bloom filter over the hashes of the values
+  /// that pass, computed with hashInt64() or hashBytes().
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param otherFilter Optional filter the values must also pass.
+  ValuesUsingBloomFilter(
+      MayContain mayContain,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> otherFilter = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kValuesUsingBloomFilter),
+        mayContain_(std::move(mayContain)),
+        otherFilter_(std::move(otherFilter)) {
+    VELOX_CHECK(mayContain_ != nullptr);
+  }
+
+  ValuesUsingBloomFilter(const ValuesUsingBloomFilter& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kValuesUsingBloomFilter),
+        mayContain_(other.mayContain_),
+        otherFilter_(other.otherFilter_) {}
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<ValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<ValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  /// Returns the hash number to add to the Bloom filter for an integral value.
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  /// Returns the hash number to add to the Bloom filter for a string value.
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return folly::hasher<std::string_view>()(std::string_view(value, length));
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (!otherFilter_ || otherFilter_->testInt64(value)) &&
+        mayContain_(hashInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (!otherFilter_ || otherFilter_->testBytes(value, length)) &&
+        mayContain_(hashBytes(value, length));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const Filter>& otherFilter() const {
+    return otherFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "ValuesUsingBloomFilter: {}{}",
+        nullAllowed_ ? "with nulls" : "no nulls",
+        otherFilter_ ? " and " + otherFilter_->toString() : "");
+  }
+
+ private:
+  const MayContain mayContain_;
+  const std::shared_ptr<const Filter> otherFilter_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
@@ -21,6 +21,7 @@
 #include <optional>
 
 #include <velox/type/Filter.h>
+#include "velox/common/base/BloomFilter.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/type/Filter.h"
 
@@ -1717,3 +1718,63 @@ TEST(FilterTest, mergeWithBytesMultiRange) {
     }
   }
 }
+
+TEST(FilterTest, valuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<false>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(ValuesUsingBloomFilter::hashInt64(i * 10));
+    const auto value = fmt::format("s{}", i * 10);
+    bloomFilter->insert(
+        ValuesUsingBloomFilter::hashBytes(value.data(), value.size()));
+  }
+
+  ValuesUsingBloomFilter filter(
+      [bloomFilter](uint64_t hash) { return bloomFilter->mayContain(hash); },
+      false);
+  EXPECT_FALSE(filter.testNull());
+  int32_t numIntPassed = 0;
+  int32_t numBytesPassed = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    const auto value = fmt::format("s{}", i);
+    if (i % 10 == 0) {
+      // All the values in the filter pass.
+      EXPECT_TRUE(filter.testInt64(i));
+      EXPECT_TRUE(filter.testBytes(value.data(), value.size()));
+    } else {
+      numIntPassed += filter.testInt64(i);
+      numBytesPassed += filter.testBytes(value.data(), value.size());
+    }
+  }
+  // A few false positives are expected.
+  EXPECT_LT(numIntPassed, 1'000);
+  EXPECT_LT(numBytesPassed, 1'000);
+
+  EXPECT_TRUE(filter.testInt64Range(0, 100, false));
+  EXPECT_TRUE(filter.testInt64Range(10, 10, false));
+  EXPECT_TRUE(filter.testBytesRange("a", "z", false));
+
+  // Merging with a range keeps both filters.
+  auto range = between(0, 50);
+  auto merged = filter.mergeWith(range.get());
+  ASSERT_EQ(FilterKind::kValuesUsingBloomFilter, merged->kind());
+  EXPECT_TRUE(merged->testInt64(20));
+  EXPECT_TRUE(merged->testInt64(50));
+  EXPECT_FALSE(merged->testInt64(60));
+  EXPECT_FALSE(merged->testInt64Range(100, 200, false));
+  EXPECT_FALSE(merged->testNull());
+
+  // Merging with another Bloom filter keeps all three filters.
+  BloomFilter<false> otherBloomFilter;
+  otherBloomFilter.reset(10);
+  otherBloomFilter.insert(ValuesUsingBloomFilter::hashInt64(20));
+  ValuesUsingBloomFilter other(
+      [&](uint64_t hash) { return otherBloomFilter.mayContain(hash); }, true);
+  auto mergedTwice = merged->mergeWith(&other);
+  EXPECT_TRUE(mergedTwice->testInt64(20));
+  EXPECT_FALSE(mergedTwice->testInt64(30));
+  EXPECT_FALSE(mergedTwice->testInt64(60));
+
+  EXPECT_FALSE(filter.mergeWith(isNull().get())->testNull());
+  EXPECT_TRUE(filter.clone(true)->testNull());
+}